@@ -29,9 +29,7 @@ static inline node node_create(node *const context, const operation_t type)
 
 static inline void node_set_child(const node *const parent, const node *const child)
 {
-	node temp = node_add_child(parent, OP_NOP);
-	node_swap(child, &temp);
-	node_remove(&temp);
+	node_move(child, parent);
 }
 
 
@@ -46,8 +44,14 @@ static inline void node_set_child(const node *const parent, const node *const ch
 
 location node_get_location(const node *const nd)
 {
-	const size_t argc = node_get_argc(nd);
-	return (location){ (size_t)node_get_arg(nd, argc - 2), (size_t)node_get_arg(nd, argc - 1) };
+	location loc = { 0, 0 };
+	node_get_span(nd, &loc.begin, &loc.end);
+	return loc;
+}
+
+void node_set_location(const node *const nd, const location loc)
+{
+	node_set_span(nd, loc.begin, loc.end);
 }
 
 expression_t expression_get_class(const node *const nd)
@@ -90,8 +94,7 @@ node expression_identifier(node *const context, const item_t type, const size_t
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, LVALUE);						// Категория значения выражения
 	node_add_arg(&nd, (item_t)id);					// Индекс в таблице идентификаторов
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -109,8 +112,7 @@ node expression_null_literal(node *const context, const item_t type, const locat
 
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -123,8 +125,7 @@ node expression_boolean_literal(node *const context, const item_t type, const bo
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
 	node_add_arg(&nd, value ? 1 : 0);				// Значение литерала
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -143,8 +144,7 @@ node expression_character_literal(node *const context, const item_t type, const
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
 	node_add_arg(&nd, (item_t)value);				// Значение литерала
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -163,8 +163,7 @@ node expression_integer_literal(node *const context, const item_t type, const it
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
 	node_add_arg(&nd, value);						// Значение литерала
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -183,8 +182,7 @@ node expression_floating_literal(node *const context, const item_t type, const d
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
 	node_add_arg_double(&nd, value);				// Значение литерала
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -203,8 +201,7 @@ node expression_string_literal(node *const context, const item_t type, const siz
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
 	node_add_arg(&nd, (item_t)index);				// Значение литерала
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -218,13 +215,12 @@ size_t expression_literal_get_string(const node *const nd)
 
 node expression_subscript(const item_t type, node *const base, node *const index, const location loc)
 {
-	node nd = node_insert(base, OP_SLICE, 4);		// Выражение-операнд
+	node nd = node_insert(base, OP_SLICE, 2);		// Выражение-операнд
 	node_set_child(&nd, index);						// Выражение-индекс
 
 	node_set_arg(&nd, 0, type);						// Тип значения выражения
 	node_set_arg(&nd, 1, LVALUE);					// Категория значения выражения
-	node_set_arg(&nd, 2, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 3, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -244,7 +240,7 @@ node expression_subscript_get_index(const node *const nd)
 
 node expression_call(const item_t type, node *const callee, node_vector *const args, const location loc)
 {
-	node nd = node_insert(callee, OP_CALL, 4);		// Операнд выражения
+	node nd = node_insert(callee, OP_CALL, 2);		// Операнд выражения
 
 	if (node_vector_is_correct(args))
 	{
@@ -258,8 +254,7 @@ node expression_call(const item_t type, node *const callee, node_vector *const a
 
 	node_set_arg(&nd, 0, type);						// Тип значения выражения
 	node_set_arg(&nd, 1, RVALUE);					// Категория значения выражения
-	node_set_arg(&nd, 2, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 3, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -286,14 +281,13 @@ node expression_call_get_argument(const node *const nd, const size_t index)
 node expression_member(const item_t type, const category_t ctg
 	, const size_t index, bool is_arrow, node *const base, const location loc)
 {
-	node nd = node_insert(base, OP_SELECT, 6);		// Операнд выражения
+	node nd = node_insert(base, OP_SELECT, 4);		// Операнд выражения
 
 	node_set_arg(&nd, 0, type);						// Тип значения выражения
 	node_set_arg(&nd, 1, ctg);						// Категория значения выражения
 	node_set_arg(&nd, 2, (item_t)index);			// Индекс поля выборки
 	node_set_arg(&nd, 3, is_arrow);					// Является ли оператор '->'
-	node_set_arg(&nd, 4, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 5, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -319,13 +313,12 @@ bool expression_member_is_arrow(const node *const nd)
 
 node expression_cast(const item_t target_type, const item_t source_type, node *const expr, const location loc)
 {
-	node nd = node_insert(expr, OP_CAST, 5);		// Операнд выражения
+	node nd = node_insert(expr, OP_CAST, 3);		// Операнд выражения
 
 	node_set_arg(&nd, 0, target_type);				// Тип значения выражения
 	node_set_arg(&nd, 1, RVALUE);					// Категория значения выражения
 	node_set_arg(&nd, 2, source_type);				// Тип до преобразования
-	node_set_arg(&nd, 3, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 4, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -345,13 +338,12 @@ node expression_cast_get_operand(const node *const nd)
 
 node expression_unary(const item_t type, const category_t ctg, node *const expr, const unary_t op, const location loc)
 {
-	node nd = node_insert(expr, OP_UNARY, 5);		// Операнд выражения
+	node nd = node_insert(expr, OP_UNARY, 3);		// Операнд выражения
 
 	node_set_arg(&nd, 0, type);						// Тип значения выражения
 	node_set_arg(&nd, 1, ctg);						// Категория значения выражения
 	node_set_arg(&nd, 2, op);						// Вид унарного оператора
-	node_set_arg(&nd, 3, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 4, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -371,14 +363,13 @@ node expression_unary_get_operand(const node *const nd)
 
 node expression_binary(const item_t type, node *const LHS, node *const RHS, const binary_t op, const location loc)
 {
-	node nd = node_insert(LHS, OP_BINARY, 5);		// Первый операнд выражения
+	node nd = node_insert(LHS, OP_BINARY, 3);		// Первый операнд выражения
 	node_set_child(&nd, RHS);						// Второй операнд выражения
 
 	node_set_arg(&nd, 0, type);						// Тип значения выражения
 	node_set_arg(&nd, 1, RVALUE);					// Категория значения выражения
 	node_set_arg(&nd, 2, op);						// Вид бинарного оператора
-	node_set_arg(&nd, 3, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 4, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -404,14 +395,13 @@ node expression_binary_get_RHS(const node *const nd)
 
 node expression_ternary(const item_t type, node *const cond, node *const LHS, node *const RHS, const location loc)
 {
-	node nd = node_insert(cond, OP_TERNARY, 4);		// Первый операнд выражения
+	node nd = node_insert(cond, OP_TERNARY, 2);		// Первый операнд выражения
 	node_set_child(&nd, LHS);						// Второй операнд выражения
 	node_set_child(&nd, RHS);						// Третий операнд выражения
 
 	node_set_arg(&nd, 0, type);						// Тип значения выражения
 	node_set_arg(&nd, 1, RVALUE);					// Категория значения выражения
-	node_set_arg(&nd, 2, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 3, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -437,14 +427,13 @@ node expression_ternary_get_RHS(const node *const nd)
 
 node expression_assignment(const item_t type, node *const LHS, node *const RHS, const binary_t op, const location loc)
 {
-	node nd = node_insert(LHS, OP_ASSIGNMENT, 5);	// Первый операнд выражения
+	node nd = node_insert(LHS, OP_ASSIGNMENT, 3);	// Первый операнд выражения
 	node_set_child(&nd, RHS);						// Второй операнд выражения
 
 	node_set_arg(&nd, 0, type);						// Тип значения выражения
 	node_set_arg(&nd, 1, RVALUE);					// Категория значения выражения
 	node_set_arg(&nd, 2, op);						// Вид бинарного оператора
-	node_set_arg(&nd, 3, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 4, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	return nd;
 }
@@ -471,12 +460,11 @@ node expression_assignment_get_RHS(const node *const nd)
 node expression_initializer(node_vector *const exprs, const location loc)
 {
 	node fst = node_vector_get(exprs, 0);
-	node nd = node_insert(&fst, OP_INITIALIZER, 4);
+	node nd = node_insert(&fst, OP_INITIALIZER, 2);
 
 	node_set_arg(&nd, 0, TYPE_UNDEFINED);			// Тип значения выражения
 	node_set_arg(&nd, 1, RVALUE);					// Категория значения выражения
-	node_set_arg(&nd, 2, (item_t)loc.begin);		// Начальная позиция выражения
-	node_set_arg(&nd, 3, (item_t)loc.end);			// Конечная позиция выражения
+	node_set_location(&nd, loc);					// Позиция выражения
 
 	const size_t amount = node_vector_size(exprs);
 	for (size_t i = 1; i < amount; i++)
@@ -514,8 +502,7 @@ node expression_empty_bound(node *const context, const location loc)
 
 	node_add_arg(&nd, TYPE_INTEGER);				// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция оператора
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -559,11 +546,10 @@ statement_t statement_get_class(const node *const nd)
 
 node statement_case(node *const expr, node *const substmt, const location loc)
 {
-	node nd = node_insert(expr, OP_CASE, 2);
+	node nd = node_insert(expr, OP_CASE, 0);
 	node_set_child(&nd, substmt);
 
-	node_set_arg(&nd, 0, (item_t)loc.begin);		// Начальная позиция оператора
-	node_set_arg(&nd, 1, (item_t)loc.end);			// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -583,10 +569,9 @@ node statement_case_get_substmt(const node *const nd)
 
 node statement_default(node *const substmt, const location loc)
 {
-	node nd = node_insert(substmt, OP_DEFAULT, 2);
+	node nd = node_insert(substmt, OP_DEFAULT, 0);
 
-	node_set_arg(&nd, 0, (item_t)loc.begin);		// Начальная позиция оператора
-	node_set_arg(&nd, 1, (item_t)loc.end);			// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -602,8 +587,7 @@ node statement_compound(node *const context, node_vector *const stmts, const loc
 {
 	node nd = node_create(context, OP_BLOCK);
 
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция оператора
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	if (node_vector_is_correct(stmts))
 	{
@@ -635,8 +619,7 @@ node statement_null(node *const context, const location loc)
 {
 	node nd = node_create(context, OP_NOP);
 
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция оператора
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -644,12 +627,11 @@ node statement_null(node *const context, const location loc)
 
 node statement_if(node *const cond, node *const then_stmt, node *const else_stmt, const location loc)
 {
-	node nd = node_insert(cond, OP_IF, 3);
+	node nd = node_insert(cond, OP_IF, 1);
 	node_set_child(&nd, then_stmt);
 
 	node_set_arg(&nd, 0, 0);						// Флаг наличия else-части
-	node_set_arg(&nd, 1, (item_t)loc.begin);		// Начальная позиция оператора
-	node_set_arg(&nd, 2, (item_t)loc.end);			// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	if (node_is_correct(else_stmt))
 	{
@@ -688,11 +670,10 @@ node statement_if_get_else_substmt(const node *const nd)
 
 node statement_switch(node *const cond, node *const body, const location loc)
 {
-	node nd = node_insert(cond, OP_SWITCH, 2);
+	node nd = node_insert(cond, OP_SWITCH, 0);
 	node_set_child(&nd, body);
 
-	node_set_arg(&nd, 0, (item_t)loc.begin);		// Начальная позиция оператора
-	node_set_arg(&nd, 1, (item_t)loc.end);			// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -712,11 +693,10 @@ node statement_switch_get_body(const node *const nd)
 
 node statement_while(node *const cond, node *const body, const location loc)
 {
-	node nd = node_insert(cond, OP_WHILE, 2);
+	node nd = node_insert(cond, OP_WHILE, 0);
 	node_set_child(&nd, body);
 
-	node_set_arg(&nd, 0, (item_t)loc.begin);		// Начальная позиция оператора
-	node_set_arg(&nd, 1, (item_t)loc.end);			// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -736,11 +716,10 @@ node statement_while_get_body(const node *const nd)
 
 node statement_do(node *const body, node *const cond, const location loc)
 {
-	node nd = node_insert(body, OP_DO, 2);
+	node nd = node_insert(body, OP_DO, 0);
 	node_set_child(&nd, cond);
 
-	node_set_arg(&nd, 0, (item_t)loc.begin);		// Начальная позиция оператора
-	node_set_arg(&nd, 1, (item_t)loc.end);			// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -760,7 +739,7 @@ node statement_do_get_body(const node *const nd)
 
 node statement_for(node *const init, node *const cond, node *const incr, node *const body, const location loc)
 {
-	node nd = node_insert(body, OP_FOR, 5);
+	node nd = node_insert(body, OP_FOR, 3);
 
 	node_set_arg(&nd, 0, 0);
 	node_set_arg(&nd, 1, 0);
@@ -784,8 +763,7 @@ node statement_for(node *const init, node *const cond, node *const incr, node *c
 		node_set_child(&nd, incr);
 	}
 
-	node_set_arg(&nd, 3, (item_t)loc.begin);		// Начальная позиция оператора
-	node_set_arg(&nd, 4, (item_t)loc.end);			// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -839,8 +817,7 @@ node statement_continue(node *const context, const location loc)
 {
 	node nd = node_create(context, OP_CONTINUE);
 
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция оператора
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -850,8 +827,7 @@ node statement_break(node *const context, const location loc)
 {
 	node nd = node_create(context, OP_BREAK);
 
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция оператора
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	return nd;
 }
@@ -862,8 +838,7 @@ node statement_return(node *const context, node *const expr, const location loc)
 	node nd = node_create(context, OP_RETURN);
 
 	node_add_arg(&nd, 0);							// Содержит ли выражение
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция оператора
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция оператора
 
 	if (node_is_correct(expr))
 	{
@@ -889,12 +864,7 @@ node statement_return_get_expression(const node *const nd)
 
 node statement_declaration(node *const context)
 {
-	node nd = node_create(context, OP_DECLSTMT);
-
-	node_add_arg(&nd, ITEM_MAX);					// Начальная позиция оператора
-	node_add_arg(&nd, ITEM_MAX);					// Конечная позиция оператора
-
-	return nd;
+	return node_create(context, OP_DECLSTMT);
 }
 
 void statement_declaration_add_declarator(const node *const nd, node *const declarator)
@@ -906,8 +876,7 @@ void statement_declaration_add_declarator(const node *const nd, node *const decl
 node statement_declaration_set_location(const node *const nd, const location loc)
 {
 	assert(node_get_type(nd) == OP_DECLSTMT);
-	node_set_arg(nd, 0, (item_t)loc.begin);
-	node_set_arg(nd, 1, (item_t)loc.end);
+	node_set_location(nd, loc);
 
 	return *nd;
 }
@@ -950,8 +919,7 @@ node declaration_member(node *const context, const item_t type, const size_t nam
 
 	node_add_arg(&nd, type);						// Тип поля
 	node_add_arg(&nd, (item_t)name);				// Имя поля
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция объявления
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция объявления
+	node_set_location(&nd, loc);					// Позиция объявления
 
 	if (node_vector_is_correct(bounds))
 	{
@@ -997,8 +965,7 @@ node declaration_struct(node *const context, const size_t name, const location l
 
 	node_add_arg(&nd, (item_t)name);				// Имя структуры
 	node_add_arg(&nd, TYPE_UNDEFINED);				// Тип структуры
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция объявления
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция объявления
+	node_set_location(&nd, loc);					// Позиция объявления
 
 	return nd;
 }
@@ -1018,8 +985,7 @@ void declaration_struct_set_type(node *const nd, const item_t type)
 node declaration_struct_set_location(node *const nd, const location loc)
 {
 	assert(node_get_type(nd) == OP_DECL_STRUCT);
-	node_set_arg(nd, 2, (item_t)loc.begin);
-	node_set_arg(nd, 3, (item_t)loc.end);
+	node_set_location(nd, loc);
 
 	return *nd;
 }
@@ -1056,8 +1022,7 @@ node declaration_variable(node *const context, const size_t id, node_vector *con
 
 	node_add_arg(&nd, (item_t)id);					// Идентификатор переменной
 	node_add_arg(&nd, initializer ? 1 : 0);			// Имеет ли инициализатор
-	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция объявления
-	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция оператора
+	node_set_location(&nd, loc);					// Позиция объявления
 
 	if (node_vector_is_correct(bounds))
 	{
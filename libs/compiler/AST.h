@@ -101,6 +101,14 @@ inline node node_broken(void)
  */
 location node_get_location(const node *const nd);
 
+/**
+ *	Set node location
+ *
+ *	@param	nd				Node
+ *	@param	loc				Node location
+ */
+void node_set_location(const node *const nd, const location loc);
+
 
 /**
  *	Get expression class
@@ -151,8 +151,10 @@ static node fold_binary_expression(builder *const bldr, const item_t type
 		{
 			const item_t left_value = expression_literal_get_integer(LHS);
 			const item_t right_value = expression_literal_get_integer(RHS);
-			node_remove(LHS);
+
+			// Операнды удаляются в обратном порядке, чтобы освободить конец таблицы дерева
 			node_remove(RHS);
+			node_remove(LHS);
 
 			switch (op)
 			{
@@ -202,8 +204,8 @@ static node fold_binary_expression(builder *const bldr, const item_t type
 			const double left_value = expression_literal_get_floating(LHS);
 			const double right_value = expression_literal_get_floating(RHS);
 
-			node_remove(LHS);
 			node_remove(RHS);
+			node_remove(LHS);
 
 			switch (op)
 			{
@@ -728,19 +730,16 @@ node build_member_expression(builder *const bldr, node *const base, const size_t
 		category = LVALUE;
 	}
 
-	const size_t member_amount = type_structure_get_member_amount(bldr->sx, struct_type);
-	for (size_t i = 0; i < member_amount; i++)
+	const size_t index = type_structure_get_member_index(bldr->sx, struct_type, name);
+	if (index != SIZE_MAX)
 	{
-		if (name == type_structure_get_member_name(bldr->sx, struct_type, i))
-		{
-			const item_t member_type = type_structure_get_member_type(bldr->sx, struct_type, i);
-			const item_t type = type_is_const(bldr->sx, struct_type) && !type_is_const(bldr->sx, member_type)
-				? type_const(bldr->sx, member_type)
-				: type_structure_get_member_type(bldr->sx, struct_type, i);
-			const location loc = { node_get_location(base).begin, id_loc.end };
+		const item_t member_type = type_structure_get_member_type(bldr->sx, struct_type, index);
+		const item_t type = type_is_const(bldr->sx, struct_type) && !type_is_const(bldr->sx, member_type)
+			? type_const(bldr->sx, member_type)
+			: member_type;
+		const location loc = { node_get_location(base).begin, id_loc.end };
 
-			return expression_member(type, category, i, is_arrow, base, loc);
-		}
+		return expression_member(type, category, index, is_arrow, base, loc);
 	}
 
 	semantic_error(bldr, id_loc, no_such_member, repr_get_name(bldr->sx, name));
@@ -763,15 +762,12 @@ node build_cast_expression(const item_t target_type, node *const expr)
 		{
 			// Пока тут только int -> float
 			const item_t value = expression_literal_get_integer(expr);
-			const node result = node_insert(expr, OP_LITERAL, DOUBLE_SIZE + 4);
+			const node result = node_replace(expr, OP_LITERAL, DOUBLE_SIZE + 2);
 
 			node_set_arg(&result, 0, TYPE_FLOATING);
 			node_set_arg(&result, 1, RVALUE);
 			node_set_arg_double(&result, 2, (double)value);
-			node_set_arg(&result, DOUBLE_SIZE + 2, (item_t)loc.begin);
-			node_set_arg(&result, DOUBLE_SIZE + 3, (item_t)loc.end);
-
-			node_remove(expr);
+			node_set_location(&result, loc);
 			return result;
 		}
 
@@ -347,10 +347,11 @@ static int print_table(const encoder *const enc, const vector *const table)
 			return -1;
 		}
 
-		uni_printf(enc->sx->io, "%" PRIitem " ", item);
+		uni_print_int(enc->sx->io, item);
+		uni_print_str(enc->sx->io, " ");
 	}
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 	return 0;
 }
 
@@ -363,7 +364,7 @@ static int print_table(const encoder *const enc, const vector *const table)
  */
 static int enc_export(const encoder *const enc)
 {
-	uni_printf(enc->sx->io, "#!/usr/bin/ruc-vm\n");
+	uni_print_str(enc->sx->io, "#!/usr/bin/ruc-vm\n");
 
 	uni_printf(enc->sx->io, "%zi %zi %zi %zi %zi %" PRIitem " 0\n"
 		, vector_size(&enc->memory)
@@ -527,12 +528,7 @@ static lvalue emit_member_lvalue(encoder *const enc, const node *const nd)
 	const size_t member_index = expression_member_get_member_index(nd);
 	const item_t struct_type = is_arrow ? type_pointer_get_element_type(enc->sx, base_type) : base_type;
 
-	item_t member_displ = 0;
-	for (size_t i = 0; i < member_index; i++)
-	{
-		const item_t member_type = type_structure_get_member_type(enc->sx, struct_type, i);
-		member_displ += (item_t)type_size(enc->sx, member_type);
-	}
+	const item_t member_displ = (item_t)type_structure_get_member_displ(enc->sx, struct_type, member_index);
 
 	if (is_arrow)
 	{
@@ -939,12 +935,7 @@ static void emit_member_expression(encoder *const enc, const node *const nd)
 	const item_t base_type = expression_get_type(&base);
 	const size_t member_index = expression_member_get_member_index(nd);
 
-	size_t member_displ = 0;
-	for (size_t i = 0; i < member_index; i++)
-	{
-		const item_t member_type = type_structure_get_member_type(enc->sx, base_type, i);
-		member_displ += type_size(enc->sx, member_type);
-	}
+	const size_t member_displ = type_structure_get_member_displ(enc->sx, base_type, member_index);
 
 	mem_add(enc, IC_COPYST);
 	mem_add(enc, (item_t)member_displ);
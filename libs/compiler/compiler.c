@@ -27,8 +27,10 @@
 #include "uniio.h"
 
 #ifndef _WIN32
+	#include <pthread.h>
 	#include <sys/stat.h>
 	#include <sys/types.h>
+	#include <unistd.h>
 #endif
 
 
@@ -38,9 +40,41 @@ static const char *const DEFAULT_VM = "out.ruc";
 static const char *const DEFAULT_LLVM = "out.ll";
 static const char *const DEFAULT_MIPS = "out.s";
 
+static const char *const DEFAULT_SOURCE = "main.c";
+static const size_t OUT_BUFFER_SIZE = 65536;
+
+/** Tree is compacted, if unreachable cells take at least such part of it */
+static const size_t TREE_GARBAGE_PART = 8;
+
 
 typedef int (*encoder)(const workspace *const ws, syntax *const sx);
 
+/** Preprocessor running concurrently with parser */
+typedef struct pipeline
+{
+	workspace *ws;				/**< Compiler workspace */
+	stream *stm;				/**< Preprocessed text */
+	const struct logger_context *log;	/**< Logging context of parser thread */
+	int ret;					/**< Preprocessor result */
+	bool is_running;			/**< Set, if preprocessor thread is not joined */
+#ifndef _WIN32
+	pthread_t thread;			/**< Preprocessor thread */
+#endif
+} pipeline;
+
+/** Independent workspaces compiled by several threads */
+typedef struct batch
+{
+	workspace *wss;						/**< Compiler workspaces */
+	status_t *stss;						/**< Status codes */
+	size_t size;						/**< Number of workspaces */
+	size_t next;						/**< Index of next workspace to compile */
+	const struct logger_context *log;	/**< Logging context of caller thread */
+#ifndef _WIN32
+	pthread_mutex_t lock;				/**< Lock of next workspace index */
+#endif
+} batch;
+
 
 /** Make executable actually executable on best-effort basis (if possible) */
 static inline void make_executable(const char *const path)
@@ -60,9 +94,74 @@ static inline void make_executable(const char *const path)
 }
 
 
-static status_t compile_from_io(const workspace *const ws, universal_io *const io, const encoder enc)
+static void *pipeline_routine(void *const arg)
+{
+	pipeline *const ppl = arg;
+	const struct logger_context *const prev = set_errors_context(ppl->log);
+
+	// Preprocessor changes only its own copy of workspace
+	ppl->ret = macro_to_stream(ppl->ws, ppl->stm);
+
+	set_errors_context(prev);
+	return NULL;
+}
+
+static inline void pipeline_start(pipeline *const ppl)
+{
+	// Preprocessor thread reports to the same logging functions as parser
+	ppl->log = get_errors_context();
+
+#ifndef _WIN32
+	ppl->is_running = pthread_create(&ppl->thread, NULL, &pipeline_routine, ppl) == 0;
+	if (ppl->is_running)
+	{
+		return;
+	}
+#endif
+
+	// Without threads text is preprocessed before parsing
+	pipeline_routine(ppl);
+}
+
+static inline int pipeline_join(pipeline *const ppl)
+{
+#ifndef _WIN32
+	if (ppl->is_running)
+	{
+		pthread_join(ppl->thread, NULL);
+		ppl->is_running = false;
+	}
+#endif
+
+	return ppl->ret;
+}
+
+
+/** Remove unreachable nodes left by parser before code generation, if they take noticeable part of tree */
+static void compact_tree(const workspace *const ws, syntax *const sx)
 {
-	if (!in_is_correct(io) || !out_is_correct(io))
+	const size_t garbage = sx->tree.garbage;
+	const size_t size = sx->tree.size;
+	const size_t reclaimed = garbage != 0 && garbage >= size / TREE_GARBAGE_PART ? tree_compact(&sx->tree) : 0;
+
+	if (reclaimed != SIZE_MAX && ws_has_flag(ws, "--tree-stats"))
+	{
+		char msg[MAX_STRING_LENGTH];
+		sprintf(msg, "недостижимо %zu из %zu ячеек таблицы дерева, освобождено %zu байт", garbage, size, reclaimed);
+		note_msg(msg);
+	}
+}
+
+/** Set output to file from workspace or to memory, if buffer for result is given */
+static inline int compile_output(const workspace *const ws, universal_io *const io, char **const out)
+{
+	return out != NULL ? out_set_buffer(io, OUT_BUFFER_SIZE) : out_set_file(io, ws_get_output(ws));
+}
+
+static status_t compile_from_io(const workspace *const ws, universal_io *const io, const encoder enc
+	, pipeline *const ppl, char **const out)
+{
+	if (!in_is_correct(io) || (ppl == NULL && !out_is_correct(io)))
 	{
 		error_msg("некорректные параметры ввода/вывода");
 		io_erase(io);
@@ -70,8 +169,24 @@ static status_t compile_from_io(const workspace *const ws, universal_io *const i
 	}
 
 	syntax sx = sx_create(ws, io);
-	int ret = parse(&sx);
-	status_t sts = sts_parse_error;
+	int ret = ws_has_flag(ws, "--tokenize") ? parse_tokenized(&sx) : parse(&sx);
+	status_t sts = ret == -2 ? sts_system_error : sts_parse_error;
+
+	if (ppl != NULL && pipeline_join(ppl))
+	{
+		sx_clear(&sx);
+		io_erase(io);
+		return sts_macro_error;
+	}
+
+	// Вывод конвейера открывается после препроцессора, чтобы при его ошибках не оставалось пустого файла
+	if (ppl != NULL && (compile_output(ws, io, out) || !out_is_correct(io)))
+	{
+		error_msg("некорректные параметры ввода/вывода");
+		sx_clear(&sx);
+		io_erase(io);
+		return sts_system_error;
+	}
 
 	if (!ret && !ws_has_flag(ws, "-c")) // Skip linker stage
 	{
@@ -81,16 +196,52 @@ static status_t compile_from_io(const workspace *const ws, universal_io *const i
 
 	if (!ret)
 	{
+		compact_tree(ws, &sx);
 		ret = enc(ws, &sx);
 		sts = sts_codegen_error;
 	}
 
 	sx_clear(&sx);
+	if (!ret && out != NULL)
+	{
+		*out = out_extract_buffer(io);
+		ret = *out == NULL;
+		sts = sts_system_error;
+	}
+
 	io_erase(io);
 	return ret ? sts : sts_success;
 }
 
-static status_t compile_from_ws(workspace *const ws, const encoder enc)
+static status_t compile_from_stream(workspace *const ws, const encoder enc, char **const out)
+{
+	stream *const stm = stream_create();
+	if (stm == NULL)
+	{
+		error_msg("некорректные параметры ввода/вывода");
+		return sts_system_error;
+	}
+
+	// Препроцессор добавляет подключаемые файлы в свою копию рабочего пространства, не меняя флаги разбора
+	workspace macro_ws = ws_copy(ws);
+	pipeline ppl = { .ws = &macro_ws, .stm = stm, .ret = 0, .is_running = false };
+	pipeline_start(&ppl);
+
+	universal_io io = io_create();
+	in_set_stream(&io, stm);
+
+	status_t sts = compile_from_io(ws, &io, enc, &ppl, out);
+	if (pipeline_join(&ppl))
+	{
+		sts = sts_macro_error;
+	}
+
+	ws_clear(&macro_ws);
+	stream_clear(stm);
+	return sts;
+}
+
+static status_t compile_from_files(workspace *const ws, const encoder enc, char **const out)
 {
 	if (!ws_is_correct(ws) || ws_get_files_num(ws) == 0)
 	{
@@ -98,11 +249,23 @@ static status_t compile_from_ws(workspace *const ws, const encoder enc)
 		return sts_system_error;
 	}
 
-	if (ws_has_flag(ws, "-E"))
+	if (ws_has_flag(ws, "-E") && out != NULL)
+	{
+		*out = macro(ws);
+		return *out == NULL ? sts_macro_error : sts_success;
+	}
+	else if (ws_has_flag(ws, "-E"))
 	{
 		return macro_to_file(ws, ws_get_output(ws)) ? sts_macro_error : sts_success;
 	}
 
+#ifndef GENERATE_MACRO
+	if (ws_has_flag(ws, "--stream"))
+	{
+		return compile_from_stream(ws, enc, out);
+	}
+#endif
+
 	universal_io io = io_create();
 
 #ifndef GENERATE_MACRO
@@ -121,11 +284,11 @@ static status_t compile_from_ws(workspace *const ws, const encoder enc)
 		return sts_macro_error;
 	}
 
-	in_set_file(&io, DEFAULT_MACRO);
+	in_set_mapped(&io, DEFAULT_MACRO);
 #endif
 
-	out_set_file(&io, ws_get_output(ws));
-	const status_t sts = compile_from_io(ws, &io, enc);
+	compile_output(ws, &io, out);
+	const status_t sts = compile_from_io(ws, &io, enc, NULL, out);
 
 #ifndef GENERATE_MACRO
 	free(preprocessing);
@@ -133,6 +296,125 @@ static status_t compile_from_ws(workspace *const ws, const encoder enc)
 	return sts;
 }
 
+static status_t compile_from_ws(workspace *const ws, const encoder enc, char **const out)
+{
+	const struct logger_context *const log = ws_get_log_context(ws);
+	if (log == NULL)
+	{
+		return compile_from_files(ws, enc, out);
+	}
+
+	// Все сообщения компиляции направляются в контекст рабочего пространства
+	const struct logger_context *const prev = set_errors_context(log);
+	const status_t sts = compile_from_files(ws, enc, out);
+	set_errors_context(prev);
+	return sts;
+}
+
+static status_t compile_to_memory(workspace *const ws, const encoder enc, char **const out, size_t *const out_len)
+{
+	char *text = NULL;
+	const status_t sts = compile_from_ws(ws, enc, &text);
+
+	if (out_len != NULL)
+	{
+		*out_len = text != NULL ? strlen(text) : 0;
+	}
+
+	if (out != NULL)
+	{
+		*out = text;
+	}
+	else
+	{
+		free(text);
+	}
+
+	return sts;
+}
+
+static status_t compile_from_buffer(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, const encoder enc, char **const out, size_t *const out_len)
+{
+	// Исходный текст и заголовки доступны препроцессору как файлы в памяти
+	workspace ws = ws_create();
+	ws_add_source(&ws, DEFAULT_SOURCE, source, len);
+	ws_add_file(&ws, DEFAULT_SOURCE);
+
+	for (size_t i = 0; flags != NULL && flags[i] != NULL; i++)
+	{
+		ws_add_flag(&ws, flags[i]);
+	}
+
+	for (size_t i = 0; headers != NULL && headers[i] != NULL && headers[i + 1] != NULL; i += 2)
+	{
+		ws_add_source(&ws, headers[i], headers[i + 1], strlen(headers[i + 1]));
+	}
+
+	const status_t sts = compile_to_memory(&ws, enc, out, out_len);
+	ws_clear(&ws);
+	return sts;
+}
+
+static bool buffer_has_flag(const char *const *const flags, const char *const flag)
+{
+	for (size_t i = 0; flags != NULL && flags[i] != NULL; i++)
+	{
+		if (strcmp(flags[i], flag) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+static inline size_t batch_take(batch *const btch)
+{
+#ifndef _WIN32
+	pthread_mutex_lock(&btch->lock);
+#endif
+	const size_t index = btch->next < btch->size ? btch->next++ : SIZE_MAX;
+#ifndef _WIN32
+	pthread_mutex_unlock(&btch->lock);
+#endif
+
+	return index;
+}
+
+static void *batch_routine(void *const arg)
+{
+	batch *const btch = arg;
+	const struct logger_context *const prev = set_errors_context(btch->log);
+
+	// Рабочие пространства независимы, общими остаются только встроенные таблицы
+	for (size_t i = batch_take(btch); i != SIZE_MAX; i = batch_take(btch))
+	{
+		btch->stss[i] = compile(&btch->wss[i]);
+	}
+
+	set_errors_context(prev);
+	return NULL;
+}
+
+static size_t batch_threads(const size_t threads, const size_t size)
+{
+	size_t number = threads;
+#ifndef _WIN32
+	if (number == 0)
+	{
+		const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+		number = processors > 0 ? (size_t)processors : 1;
+	}
+#else
+	// Без потоков программы компилируются последовательно
+	number = 1;
+#endif
+
+	return number < size ? number : size;
+}
+
 
 /*
  *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
@@ -166,7 +448,7 @@ status_t compile_to_vm(workspace *const ws)
 		ws_set_output(ws, DEFAULT_VM);
 	}
 
-	const status_t sts = compile_from_ws(ws, &encode_to_vm);
+	const status_t sts = compile_from_ws(ws, &encode_to_vm, NULL);
 	if (sts == sts_success)
 	{
 		make_executable(ws_get_output(ws));
@@ -182,7 +464,7 @@ status_t compile_to_llvm(workspace *const ws)
 		ws_set_output(ws, DEFAULT_LLVM);
 	}
 
-	const status_t sts = compile_from_ws(ws, &encode_to_llvm);
+	const status_t sts = compile_from_ws(ws, &encode_to_llvm, NULL);
 	return sts == sts_codegen_error ? sts_llvm_error : sts;
 }
 
@@ -193,7 +475,104 @@ int compile_to_mips(workspace *const ws)
 		ws_set_output(ws, DEFAULT_MIPS);
 	}
 
-	return compile_from_ws(ws, &encode_to_mips);
+	return compile_from_ws(ws, &encode_to_mips, NULL);
+}
+
+status_t compile_to_buffer(workspace *const ws, char **const out, size_t *const out_len)
+{
+	if (ws_has_flag(ws, "-LLVM"))
+	{
+		const status_t sts = compile_to_memory(ws, &encode_to_llvm, out, out_len);
+		return sts == sts_codegen_error ? sts_llvm_error : sts;
+	}
+	else if (ws_has_flag(ws, "-MIPS"))
+	{
+		return compile_to_memory(ws, &encode_to_mips, out, out_len);
+	}
+	else // if (ws_has_flag(ws, "-VM"))
+	{
+		const status_t sts = compile_to_memory(ws, &encode_to_vm, out, out_len);
+		return sts == sts_codegen_error ? sts_virtul_error : sts;
+	}
+}
+
+status_t compile_buffer(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len)
+{
+	if (buffer_has_flag(flags, "-LLVM"))
+	{
+		return compile_buffer_to_llvm(source, len, flags, headers, out, out_len);
+	}
+	else if (buffer_has_flag(flags, "-MIPS"))
+	{
+		return compile_buffer_to_mips(source, len, flags, headers, out, out_len);
+	}
+	else // if (buffer_has_flag(flags, "-VM"))
+	{
+		return compile_buffer_to_vm(source, len, flags, headers, out, out_len);
+	}
+}
+
+status_t compile_buffer_to_vm(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len)
+{
+	const status_t sts = compile_from_buffer(source, len, flags, headers, &encode_to_vm, out, out_len);
+	return sts == sts_codegen_error ? sts_virtul_error : sts;
+}
+
+status_t compile_buffer_to_llvm(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len)
+{
+	const status_t sts = compile_from_buffer(source, len, flags, headers, &encode_to_llvm, out, out_len);
+	return sts == sts_codegen_error ? sts_llvm_error : sts;
+}
+
+status_t compile_buffer_to_mips(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len)
+{
+	return compile_from_buffer(source, len, flags, headers, &encode_to_mips, out, out_len);
+}
+
+
+int compile_batch(workspace *const wss, const size_t n, status_t *const out, const size_t threads)
+{
+	if ((wss == NULL || out == NULL) && n != 0)
+	{
+		error_msg("некорректные входные данные");
+		return -1;
+	}
+
+	batch btch = { .wss = wss, .stss = out, .size = n, .next = 0, .log = get_errors_context() };
+	const size_t number = batch_threads(threads, n);
+
+#ifndef _WIN32
+	pthread_t *const workers = number > 1 ? malloc((number - 1) * sizeof(pthread_t)) : NULL;
+	size_t started = 0;
+
+	pthread_mutex_init(&btch.lock, NULL);
+	while (workers != NULL && started + 1 < number
+		&& pthread_create(&workers[started], NULL, &batch_routine, &btch) == 0)
+	{
+		started++;
+	}
+#endif
+
+	// Вызывающий поток тоже компилирует, поэтому пакет завершится даже без дополнительных потоков
+	batch_routine(&btch);
+
+#ifndef _WIN32
+	for (size_t i = 0; i < started; i++)
+	{
+		pthread_join(workers[i], NULL);
+	}
+
+	pthread_mutex_destroy(&btch.lock);
+	free(workers);
+#else
+	(void)number;
+#endif
+
+	return 0;
 }
 
 
@@ -234,14 +613,14 @@ int auto_compile_to_mips(const int argc, const char *const *const argv)
 int no_macro_compile_to_vm(const char *const path)
 {
 	universal_io io = io_create();
-	in_set_file(&io, path);
+	in_set_mapped(&io, path);
 
 	workspace ws = ws_create();
 	ws_add_file(&ws, path);
 	ws_set_output(&ws, DEFAULT_VM);
 	out_set_file(&io, ws_get_output(&ws));
 
-	const int ret = compile_from_io(&ws, &io, &encode_to_vm);
+	const int ret = compile_from_io(&ws, &io, &encode_to_vm, NULL, NULL);
 	if (!ret)
 	{
 		make_executable(ws_get_output(&ws));
@@ -254,14 +633,14 @@ int no_macro_compile_to_vm(const char *const path)
 int no_macro_compile_to_llvm(const char *const path)
 {
 	universal_io io = io_create();
-	in_set_file(&io, path);
+	in_set_mapped(&io, path);
 
 	workspace ws = ws_create();
 	ws_add_file(&ws, path);
 	ws_set_output(&ws, DEFAULT_LLVM);
 	out_set_file(&io, ws_get_output(&ws));
 
-	const int ret = compile_from_io(&ws, &io, &encode_to_llvm);
+	const int ret = compile_from_io(&ws, &io, &encode_to_llvm, NULL, NULL);
 	ws_clear(&ws);
 	return ret;
 }
@@ -269,14 +648,14 @@ int no_macro_compile_to_llvm(const char *const path)
 int no_macro_compile_to_mips(const char *const path)
 {
 	universal_io io = io_create();
-	in_set_file(&io, path);
+	in_set_mapped(&io, path);
 
 	workspace ws = ws_create();
 	ws_add_file(&ws, path);
 	ws_set_output(&ws, DEFAULT_MIPS);
 	out_set_file(&io, ws_get_output(&ws));
 
-	const int ret = compile_from_io(&ws, &io, &encode_to_mips);
+	const int ret = compile_from_io(&ws, &io, &encode_to_mips, NULL, NULL);
 	ws_clear(&ws);
 	return ret;
 }
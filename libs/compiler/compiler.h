@@ -80,6 +80,91 @@ EXPORTED status_t compile_to_llvm(workspace *const ws);
  */
 EXPORTED int compile_to_mips(workspace *const ws);
 
+/**
+ *	Compile code from workspace to memory
+ *
+ *	@param	ws		Compiler workspace
+ *	@param	out		Allocated output text, @c NULL on failure
+ *	@param	out_len	Size of output text
+ *
+ *	@return	Status code
+ */
+EXPORTED status_t compile_to_buffer(workspace *const ws, char **const out, size_t *const out_len);
+
+/**
+ *	Compile code from source text in memory
+ *
+ *	@param	source	Source text, it is preprocessed as file "main.c"
+ *	@param	len		Size of source text
+ *	@param	flags	Null-terminated list of command line flags, may be @c NULL
+ *	@param	headers	Null-terminated list of header names and texts in pairs, may be @c NULL
+ *	@param	out		Allocated output text, @c NULL on failure
+ *	@param	out_len	Size of output text
+ *
+ *	@return	Status code
+ */
+EXPORTED status_t compile_buffer(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len);
+
+/**
+ *	Compile RuC virtual machine code from source text in memory
+ *
+ *	@param	source	Source text, it is preprocessed as file "main.c"
+ *	@param	len		Size of source text
+ *	@param	flags	Null-terminated list of command line flags, may be @c NULL
+ *	@param	headers	Null-terminated list of header names and texts in pairs, may be @c NULL
+ *	@param	out		Allocated output text, @c NULL on failure
+ *	@param	out_len	Size of output text
+ *
+ *	@return	Status code
+ */
+EXPORTED status_t compile_buffer_to_vm(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len);
+
+/**
+ *	Compile LLVM code from source text in memory
+ *
+ *	@param	source	Source text, it is preprocessed as file "main.c"
+ *	@param	len		Size of source text
+ *	@param	flags	Null-terminated list of command line flags, may be @c NULL
+ *	@param	headers	Null-terminated list of header names and texts in pairs, may be @c NULL
+ *	@param	out		Allocated output text, @c NULL on failure
+ *	@param	out_len	Size of output text
+ *
+ *	@return	Status code
+ */
+EXPORTED status_t compile_buffer_to_llvm(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len);
+
+/**
+ *	Compile MIPS code from source text in memory
+ *
+ *	@param	source	Source text, it is preprocessed as file "main.c"
+ *	@param	len		Size of source text
+ *	@param	flags	Null-terminated list of command line flags, may be @c NULL
+ *	@param	headers	Null-terminated list of header names and texts in pairs, may be @c NULL
+ *	@param	out		Allocated output text, @c NULL on failure
+ *	@param	out_len	Size of output text
+ *
+ *	@return	Status code
+ */
+EXPORTED status_t compile_buffer_to_mips(const char *const source, const size_t len, const char *const *const flags
+	, const char *const *const headers, char **const out, size_t *const out_len);
+
+
+/**
+ *	Compile independent workspaces concurrently,
+ *	statuses are the same as after serial compilation of each workspace
+ *
+ *	@param	wss		Compiler workspaces with different output files
+ *	@param	n		Number of workspaces
+ *	@param	out		Status codes of workspaces
+ *	@param	threads	Number of threads, @c 0 for number of processors
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int compile_batch(workspace *const wss, const size_t n, status_t *const out, const size_t threads);
+
 
 /**
  *	Compile code from terminal arguments
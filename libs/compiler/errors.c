@@ -477,9 +477,9 @@ static void get_warning(const warning_t num, char *const msg, va_list args)
 
 
 static void output(universal_io *const io, const char *const msg
-	, const logger system_func, void (*func)(location *const, const char *const))
+	, const logger system_func, void (*func)(locator *const, const char *const))
 {
-	location loc = loc_search(io);
+	locator loc = loc_search(io);
 
 	if (!loc_is_correct(&loc))
 	{
@@ -572,3 +572,19 @@ void warning_msg(const char *const msg)
 {
 	log_system_warning(TAG_RUC, msg);
 }
+
+void note_msg(const char *const msg)
+{
+	log_system_note(TAG_RUC, msg);
+}
+
+
+const logger_context *set_errors_context(const logger_context *const context)
+{
+	return set_log_context(context);
+}
+
+const logger_context *get_errors_context(void)
+{
+	return get_log_context();
+}
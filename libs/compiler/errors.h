@@ -23,6 +23,8 @@
 extern "C" {
 #endif
 
+struct logger_context;
+
 /** Errors codes */
 typedef enum ERROR
 {
@@ -241,6 +243,30 @@ void error_msg(const char *const msg);
  */
 void warning_msg(const char *const msg);
 
+/**
+ *	Emit a note message
+ *
+ *	@param	msg			Note message
+ */
+void note_msg(const char *const msg);
+
+
+/**
+ *	Set logging context of errors for the current thread
+ *
+ *	@param	context		Logging context, @c NULL for thread defaults
+ *
+ *	@return	Previous logging context
+ */
+const struct logger_context *set_errors_context(const struct logger_context *const context);
+
+/**
+ *	Get logging context of errors used by the current thread
+ *
+ *	@return	Logging context
+ */
+const struct logger_context *get_errors_context(void);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
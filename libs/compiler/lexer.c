@@ -16,10 +16,14 @@
 
 #include "lexer.h"
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include "uniscanner.h"
 
 
+#define TOKEN_ARRAY_SIZE 4096
+
+
 /**
  *	Emit an error from lexer
  *
@@ -128,17 +132,16 @@ static token lex_identifier_or_keyword(lexer *const lxr)
 	const size_t loc_begin = in_get_position(lxr->sx->io);
 
 	uni_unscan_char(lxr->sx->io, lxr->character);
-	const size_t repr = repr_reserve(lxr->sx, &lxr->character);
-
+	const token_t kind = repr_read(lxr->sx, &lxr->character);
 	const size_t loc_end = in_get_position(lxr->sx->io);
-	const item_t ref = repr_get_reference(lxr->sx, repr);
 
-	if (ref >= 0)
+	if (kind != TK_IDENTIFIER)
 	{
-		return token_identifier((location){ loc_begin, loc_end }, repr);
+		return token_keyword((location){ loc_begin, loc_end }, kind);
 	}
 
-	return token_keyword((location){ loc_begin, loc_end }, (token_t)ref);
+	const size_t repr = repr_reserve(lxr->sx);
+	return token_identifier((location){ loc_begin, loc_end }, repr);
 }
 
 /**
@@ -442,41 +445,15 @@ static token lex_string_literal(lexer *const lxr)
 	return token_string_literal((location){ loc_begin, loc_end }, index);
 }
 
-
-/*
- *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
- *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
- *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
- *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
- *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+/**
+ *	Lex next token from io bypassing cache
+ *
+ *	@param	lxr			Lexer
+ *
+ *	@return	Lexed token
  */
-
-
-lexer lexer_create(syntax *const sx)
-{
-	lexer lxr;
-
-	lxr.sx = sx;
-	lxr.lexstr = vector_create(MAX_STRING_LENGTH);
-
-	scan(&lxr);
-
-	return lxr;
-}
-
-int lexer_clear(lexer *const lxr)
+static token lex_token(lexer *const lxr)
 {
-	return vector_clear(&lxr->lexstr);
-}
-
-
-token lex(lexer *const lxr)
-{
-	if (lxr == NULL)
-	{
-		return token_eof();
-	}
-
 	while (true)
 	{
 		skip_whitespace(lxr);
@@ -809,12 +786,178 @@ token lex(lexer *const lxr)
 	}
 }
 
+/**
+ *	Add token to the end of token array
+ *
+ *	@param	arr			Token array
+ *	@param	tk			Token
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+static int token_array_add(token_array *const arr, const token *const tk)
+{
+	if (arr->size == arr->alloc)
+	{
+		const size_t alloc = arr->alloc == 0 ? TOKEN_ARRAY_SIZE : 2 * arr->alloc;
+
+		token_t *const kinds = realloc(arr->kinds, alloc * sizeof(token_t));
+		if (kinds == NULL)
+		{
+			return -1;
+		}
+		arr->kinds = kinds;
+
+		location *const locations = realloc(arr->locations, alloc * sizeof(location));
+		if (locations == NULL)
+		{
+			return -1;
+		}
+		arr->locations = locations;
+
+		token_data *const data = realloc(arr->data, alloc * sizeof(token_data));
+		if (data == NULL)
+		{
+			return -1;
+		}
+		arr->data = data;
+
+		arr->alloc = alloc;
+	}
+
+	arr->kinds[arr->size] = tk->kind;
+	arr->locations[arr->size] = tk->loc;
+	arr->data[arr->size] = tk->data;
+	arr->size++;
+	return 0;
+}
+
+/**
+ *	Get token from token array
+ *
+ *	@param	arr			Token array
+ *	@param	index		Index of token, the last token is returned on overflow
+ *
+ *	@return	Token
+ */
+static inline token token_array_get(const token_array *const arr, const size_t index)
+{
+	const size_t i = index < arr->size ? index : arr->size - 1;
+	return (token){ .loc = arr->locations[i], .kind = arr->kinds[i], .data = arr->data[i] };
+}
+
+/**
+ *	Free token array
+ *
+ *	@param	arr			Token array
+ */
+static void token_array_clear(token_array *const arr)
+{
+	free(arr->kinds);
+	free(arr->locations);
+	free(arr->data);
+
+	*arr = (token_array){ .kinds = NULL };
+}
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+lexer lexer_create(syntax *const sx)
+{
+	lexer lxr;
+
+	lxr.sx = sx;
+	lxr.lexstr = vector_create(MAX_STRING_LENGTH);
+
+	lxr.is_cached = false;
+
+	lxr.tokens = (token_array){ .kinds = NULL };
+	lxr.token_index = 0;
+
+	scan(&lxr);
+
+	return lxr;
+}
+
+int lexer_tokenize(lexer *const lxr)
+{
+	if (lxr == NULL || lxr->tokens.kinds != NULL)
+	{
+		return -1;
+	}
+
+	token_array arr = { .kinds = NULL };
+	token tk;
+	do
+	{
+		tk = lex(lxr);
+		if (token_array_add(&arr, &tk))
+		{
+			token_array_clear(&arr);
+			return -1;
+		}
+	} while (token_is_not(&tk, TK_EOF));
+
+	lxr->tokens = arr;
+	lxr->token_index = 0;
+	return 0;
+}
+
+int lexer_clear(lexer *const lxr)
+{
+	token_array_clear(&lxr->tokens);
+	return vector_clear(&lxr->lexstr);
+}
+
+
+token lex(lexer *const lxr)
+{
+	if (lxr == NULL)
+	{
+		return token_eof();
+	}
+
+	if (lxr->tokens.kinds != NULL)
+	{
+		const token result = token_array_get(&lxr->tokens, lxr->token_index);
+		lxr->token_index += lxr->token_index < lxr->tokens.size ? 1 : 0;
+		return result;
+	}
+
+	if (!lxr->is_cached)
+	{
+		return lex_token(lxr);
+	}
+
+	lxr->is_cached = false;
+	return lxr->cache;
+}
+
 token_t peek(lexer *const lxr)
 {
-	const size_t position = in_get_position(lxr->sx->io);
-	const char32_t character = lxr->character;
-	const token peek_token = lex(lxr);
-	lxr->character = character;
-	in_set_position(lxr->sx->io, position);
-	return token_get_kind(&peek_token);
+	if (lxr == NULL)
+	{
+		return TK_EOF;
+	}
+
+	if (lxr->tokens.kinds != NULL)
+	{
+		return token_array_get(&lxr->tokens, lxr->token_index).kind;
+	}
+
+	// Token is lexed only once, the next peek and lex take it from cache
+	if (!lxr->is_cached)
+	{
+		lxr->cache = lex_token(lxr);
+		lxr->is_cached = true;
+	}
+
+	return token_get_kind(&lxr->cache);
 }
@@ -28,6 +28,17 @@
 extern "C" {
 #endif
 
+/** Tokens of the whole input stored as separate arrays */
+typedef struct token_array
+{
+	token_t *kinds;							/**< Token kinds */
+	location *locations;					/**< Token locations */
+	token_data *data;						/**< Token values */
+
+	size_t size;							/**< Number of tokens */
+	size_t alloc;							/**< Allocated size of arrays */
+} token_array;
+
 /** Lexer structure */
 typedef struct lexer
 {
@@ -35,6 +46,12 @@ typedef struct lexer
 
 	char32_t character;						/**< Current character */
 	vector lexstr;							/**< Representation of the read string literal */
+
+	token cache;							/**< Peeked but not consumed token */
+	bool is_cached;							/**< Set, if peeked token is cached */
+
+	token_array tokens;						/**< Tokens of the whole input, if tokenized */
+	size_t token_index;						/**< Index of the next token in array */
 } lexer;
 
 /**
@@ -64,6 +81,16 @@ token lex(lexer *const lxr);
  */
 token_t peek(lexer *const lxr);
 
+/**
+ *	Lex the whole input into token array.
+ *	Next calls of lex and peek take tokens from this array.
+ *
+ *	@param	lxr		Lexer
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+int lexer_tokenize(lexer *const lxr);
+
 /**
  *	Free allocated memory
  *
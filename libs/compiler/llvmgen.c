@@ -105,42 +105,18 @@ static void emit_one_dimension_initialization(information *const info, const nod
 static void emit_initialization(information *const info, const node *const nd, const item_t id, const item_t arr_type);
 
 
-static item_t array_get_type(information *const info, const item_t array_type)
-{
-	item_t type = array_type;
-	while (type_is_array(info->sx, type))
-	{
-		type = type_array_get_element_type(info->sx, type);
-	}
-
-	return type;
-}
-
-static size_t array_get_dim(information *const info, const item_t array_type)
-{
-	size_t i = 0;
-	item_t type = array_type;
-	while (type_is_array(info->sx, type))
-	{
-		type = type_array_get_element_type(info->sx, type);
-		i++;
-	}
-
-	return i;
-}
-
 static void func_name_to_io(information *const info, const size_t func_ref)
 {
 	const char *name = ident_get_spelling(info->sx, func_ref);
 	if (func_ref < BEGIN_USER_FUNC)
 	{
-		uni_printf(info->sx->io, "%s", name);
+		uni_print_str(info->sx->io, name);
 		return;
 	}
 
 	char modified_name[MAX_NAME];
 	utf8_transliteration(name, modified_name);
-	uni_printf(info->sx->io, "%s", modified_name);
+	uni_print_str(info->sx->io, modified_name);
 }
 
 static void type_to_io(information *const info, const item_t type)
@@ -149,28 +125,28 @@ static void type_to_io(information *const info, const item_t type)
 	switch (type_class)
 	{
 		case TYPE_VARARG:
-			uni_printf(info->sx->io, "...");
+			uni_print_str(info->sx->io, "...");
 			break;
 
 		case TYPE_BOOLEAN:
-			uni_printf(info->sx->io, "i1");
+			uni_print_str(info->sx->io, "i1");
 			break;
 
 		case TYPE_CHARACTER:
-			uni_printf(info->sx->io, "i8");
+			uni_print_str(info->sx->io, "i8");
 			break;
 
 		case TYPE_INTEGER:
 		case TYPE_ENUM:
-			uni_printf(info->sx->io, "i32");
+			uni_print_str(info->sx->io, "i32");
 			break;
 
 		case TYPE_FLOATING:
-			uni_printf(info->sx->io, "double");
+			uni_print_str(info->sx->io, "double");
 			break;
 
 		case TYPE_VOID:
-			uni_printf(info->sx->io, "void");
+			uni_print_str(info->sx->io, "void");
 			break;
 
 		case TYPE_STRUCTURE:
@@ -180,14 +156,14 @@ static void type_to_io(information *const info, const item_t type)
 		case TYPE_POINTER:
 		{
 			type_to_io(info, type_pointer_get_element_type(info->sx, type));
-			uni_printf(info->sx->io, "*");
+			uni_print_str(info->sx->io, "*");
 		}
 		break;
 
 		case TYPE_ARRAY:
 		{
 			type_to_io(info, type_array_get_element_type(info->sx, type));
-			uni_printf(info->sx->io, "*");
+			uni_print_str(info->sx->io, "*");
 		}
 		break;
 
@@ -201,7 +177,7 @@ static void type_to_io(information *const info, const item_t type)
 		case TYPE_FUNCTION:
 		{
 			type_to_io(info, type_function_get_return_type(info->sx, type));
-			uni_printf(info->sx->io, " (");
+			uni_print_str(info->sx->io, " (");
 
 			const size_t parameter_amount = type_function_get_parameter_amount(info->sx, type);
 			for (size_t i = 0; i < parameter_amount; i++)
@@ -219,19 +195,19 @@ static void type_to_io(information *const info, const item_t type)
 
 				if (type_is_function(info->sx, type_parameter))
 				{
-					uni_printf(info->sx->io, "*");
+					uni_print_str(info->sx->io, "*");
 				}
 
 				if (i != parameter_amount - 1)
 				{
-					uni_printf(info->sx->io, ", ");
+					uni_print_str(info->sx->io, ", ");
 				}
 			}
-			uni_printf(info->sx->io, ")");
+			uni_print_str(info->sx->io, ")");
 
 			if (!info->is_call)
 			{
-				uni_printf(info->sx->io, "*");
+				uni_print_str(info->sx->io, "*");
 			}
 		}
 		break;
@@ -267,32 +243,32 @@ static void operation_to_io(information *const info, const binary_t operation_ty
 
 		case BIN_REM_ASSIGN:
 		case BIN_REM:
-			uni_printf(info->sx->io, "srem");
+			uni_print_str(info->sx->io, "srem");
 			break;
 
 		case BIN_SHL_ASSIGN:
 		case BIN_SHL:
-			uni_printf(info->sx->io, "shl");
+			uni_print_str(info->sx->io, "shl");
 			break;
 
 		case BIN_SHR_ASSIGN:
 		case BIN_SHR:
-			uni_printf(info->sx->io, "ashr");
+			uni_print_str(info->sx->io, "ashr");
 			break;
 
 		case BIN_AND_ASSIGN:
 		case BIN_AND:
-			uni_printf(info->sx->io, "and");
+			uni_print_str(info->sx->io, "and");
 			break;
 
 		case BIN_XOR_ASSIGN:
 		case BIN_XOR:
-			uni_printf(info->sx->io, "xor");
+			uni_print_str(info->sx->io, "xor");
 			break;
 
 		case BIN_OR_ASSIGN:
 		case BIN_OR:
-			uni_printf(info->sx->io, "or");
+			uni_print_str(info->sx->io, "or");
 			break;
 
 		case BIN_EQ:
@@ -323,7 +299,7 @@ static void to_code_operation_reg_reg(information *const info, const binary_t op
 {
 	uni_printf(info->sx->io, " %%.%zu = ", info->register_num);
 	operation_to_io(info, operation, type);
-	uni_printf(info->sx->io, " ");
+	uni_print_str(info->sx->io, " ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " %%.%zu, %%.%zu\n", fst, snd);
 }
@@ -333,7 +309,7 @@ static void to_code_operation_reg_const_integer(information *const info, const b
 {
 	uni_printf(info->sx->io, " %%.%zu = ", info->register_num);
 	operation_to_io(info, operation, TYPE_INTEGER);
-	uni_printf(info->sx->io, " ");
+	uni_print_str(info->sx->io, " ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " %%.%zu, %" PRIitem "\n", fst, snd);
 }
@@ -343,7 +319,7 @@ static void to_code_operation_reg_const_bool(information *const info, const bina
 {
 	uni_printf(info->sx->io, " %%.%zu = ", info->register_num);
 	operation_to_io(info, operation, TYPE_INTEGER);
-	uni_printf(info->sx->io, " ");
+	uni_print_str(info->sx->io, " ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " %%.%zu, %s\n", fst, snd ? "true" : "false");
 }
@@ -361,7 +337,7 @@ static void to_code_operation_const_reg_integer(information *const info, const b
 {
 	uni_printf(info->sx->io, " %%.%zu = ", info->register_num);
 	operation_to_io(info, operation, TYPE_INTEGER);
-	uni_printf(info->sx->io, " ");
+	uni_print_str(info->sx->io, " ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " %" PRIitem ", %%.%zu\n", fst, snd);
 }
@@ -379,7 +355,7 @@ static void to_code_operation_reg_null(information *const info, const binary_t o
 {
 	uni_printf(info->sx->io, " %%.%zu = ", info->register_num);
 	operation_to_io(info, operation, TYPE_INTEGER);
-	uni_printf(info->sx->io, " ");
+	uni_print_str(info->sx->io, " ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " %%.%zu, null\n", fst);
 }
@@ -389,7 +365,7 @@ static void to_code_operation_null_reg(information *const info, const binary_t o
 {
 	uni_printf(info->sx->io, " %%.%zu = ", info->register_num);
 	operation_to_io(info, operation, TYPE_INTEGER);
-	uni_printf(info->sx->io, " ");
+	uni_print_str(info->sx->io, " ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " null, %%.%zu\n", snd);
 }
@@ -399,13 +375,13 @@ static void to_code_load(information *const info, const size_t result, const siz
 {
 	uni_printf(info->sx->io, " %%.%zu = load ", result);
 	type_to_io(info, type);
-	uni_printf(info->sx->io, ", ");
+	uni_print_str(info->sx->io, ", ");
 	type_to_io(info, type);
 	if (type_get_class(info->sx, type) == TYPE_FUNCTION && !is_local)
 	{
-		uni_printf(info->sx->io, "* @");
+		uni_print_str(info->sx->io, "* @");
 		func_name_to_io(info, info->func_ref);
-		uni_printf(info->sx->io, ", align 4\n");
+		uni_print_str(info->sx->io, ", align 4\n");
 		return;
 	}
 	uni_printf(info->sx->io, "* %s%s.%zu, align 4\n", is_local ? "%" : "@", is_array ? "" : "var", id);
@@ -414,7 +390,7 @@ static void to_code_load(information *const info, const size_t result, const siz
 static void to_code_store_reg(information *const info, const size_t reg, const size_t id, const item_t type
 	, const bool is_array, const bool is_pointer, const bool is_local)
 {
-	uni_printf(info->sx->io, " store ");
+	uni_print_str(info->sx->io, " store ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " %s%s.%zu, ", /*ident_is_local(info->sx, reg)*/true ? "%" : "@", is_pointer ? "var" : "", reg);
 	type_to_io(info, type);
@@ -424,7 +400,7 @@ static void to_code_store_reg(information *const info, const size_t reg, const s
 static inline void to_code_store_const_integer(information *const info, const item_t arg, const size_t id
 	, const bool is_array, const bool is_local, const item_t type)
 {
-	uni_printf(info->sx->io, " store ");
+	uni_print_str(info->sx->io, " store ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, " %" PRIitem ", ", arg);
 	type_to_io(info, type);
@@ -447,9 +423,9 @@ static inline void to_code_store_const_double(information *const info, const dou
 
 static void to_code_store_null(information *const info, const size_t id, const item_t type)
 {
-	uni_printf(info->sx->io, " store ");
+	uni_print_str(info->sx->io, " store ");
 	type_to_io(info, type);
-	uni_printf(info->sx->io, " null, ");
+	uni_print_str(info->sx->io, " null, ");
 	type_to_io(info, type);
 	uni_printf(info->sx->io, "* %%var.%zu, align 4\n", id);
 }
@@ -495,6 +471,13 @@ static void to_code_stack_load(information *const info, const item_t index)
 
 static void to_code_alloc_array_static(information *const info, const size_t index, const item_t type, const bool is_local)
 {
+	const size_t dim = hash_get_amount_by_index(&info->arrays, index) - 1;
+	if (dim == 0 || dim > MAX_DIMENSIONS)
+	{
+		system_error(such_array_is_not_supported);
+		return;
+	}
+
 	if (is_local)
 	{
 		uni_printf(info->sx->io, " %%arr.%" PRIitem " = alloca ", hash_get_key(&info->arrays, index));
@@ -504,13 +487,6 @@ static void to_code_alloc_array_static(information *const info, const size_t ind
 		uni_printf(info->sx->io, "@arr.%" PRIitem " = common global ", hash_get_key(&info->arrays, index));
 	}
 
-	const size_t dim = hash_get_amount_by_index(&info->arrays, index) - 1;
-	if (dim == 0 || dim > MAX_DIMENSIONS)
-	{
-		system_error(such_array_is_not_supported);
-		return;
-	}
-
 	for (size_t i = 1; i <= dim; i++)
 	{
 		uni_printf(info->sx->io, "[%" PRIitem " x ", hash_get_by_index(&info->arrays, index, i));
@@ -519,7 +495,7 @@ static void to_code_alloc_array_static(information *const info, const size_t ind
 
 	for (size_t i = 1; i <= dim; i++)
 	{
-		uni_printf(info->sx->io, "]");
+		uni_print_str(info->sx->io, "]");
 	}
 	uni_printf(info->sx->io, "%s, align 4\n", is_local ? "" : " zeroinitializer");
 }
@@ -568,9 +544,9 @@ static void to_code_slice(information *const info, const item_t id, const size_t
 
 		for (size_t i = dimensions - cur_dimension; i <= dimensions; i++)
 		{
-			uni_printf(info->sx->io, "]");
+			uni_print_str(info->sx->io, "]");
 		}
-		uni_printf(info->sx->io, ", ");
+		uni_print_str(info->sx->io, ", ");
 
 		for (size_t i = dimensions - cur_dimension; i <= dimensions; i++)
 		{
@@ -580,7 +556,7 @@ static void to_code_slice(information *const info, const item_t id, const size_t
 
 		for (size_t i = dimensions - cur_dimension; i <= dimensions; i++)
 		{
-			uni_printf(info->sx->io, "]");
+			uni_print_str(info->sx->io, "]");
 		}
 
 		if (cur_dimension == dimensions - 1)
@@ -595,14 +571,14 @@ static void to_code_slice(information *const info, const item_t id, const size_t
 	else if (cur_dimension == dimensions - 1)
 	{
 		type_to_io(info, type);
-		uni_printf(info->sx->io, ", ");
+		uni_print_str(info->sx->io, ", ");
 		type_to_io(info, type);
 		uni_printf(info->sx->io, "* %%dynarr.%" PRIitem, id);
 	}
 	else
 	{
 		type_to_io(info, type);
-		uni_printf(info->sx->io, ", ");
+		uni_print_str(info->sx->io, ", ");
 		type_to_io(info, type);
 		uni_printf(info->sx->io, "* %%.%" PRIitem, prev_slice);
 	}
@@ -705,7 +681,7 @@ static void global_initialization(information *const info)
 
 			if (type_is_array(info->sx, type) && has_init)
 			{
-				const size_t dimensions = array_get_dim(info, type);
+				const size_t dimensions = type_array_get_dimensions(info->sx, type);
 				const node initializer = declaration_variable_get_initializer(&decl);
 				emit_one_dimension_initialization(info, &initializer, id, type, dimensions - 1, 0, false);
 			}
@@ -741,7 +717,7 @@ static void emit_cast_expression(information *const info, const node *const nd)
 	type_to_io(info, source_type);
 	uni_printf(info->sx->io, " %%.%zu to ", info->answer_reg);
 	type_to_io(info, target_type);
-	uni_printf(info->sx->io, "\n");
+	uni_print_str(info->sx->io, "\n");
 
 	info->answer_reg = info->register_num++;
 }
@@ -777,7 +753,7 @@ static void emit_identifier_expression(information *const info, const node *cons
 		info->answer_const = 0;
 		info->answer_kind = ACONST;
 		const size_t dimensions = hash_get_amount(&info->arrays, id) - 1;
-		to_code_slice(info, id, dimensions - 1, 0, array_get_type(info, type), is_local);
+		to_code_slice(info, id, dimensions - 1, 0, type_array_get_base_type(info->sx, type), is_local);
 		info->answer_reg = info->register_num - 1;
 	}
 	else
@@ -889,7 +865,7 @@ static void emit_one_dimension_subscript(information *const info, const node *co
 	const size_t dimensions = hash_get_amount(&info->arrays, id) - 1;
 	const bool is_local = ident_is_local(info->sx, id);
 	const item_t arr_type = ident_get_type(info->sx, id);
-	const item_t type = array_get_type(info, arr_type);
+	const item_t type = type_array_get_base_type(info->sx, arr_type);
 
 	if (cur_dimension != dimensions - 1)
 	{
@@ -931,7 +907,7 @@ static void emit_subscript_expression(information *const info, const node *const
 			}
 			else
 			{
-				uni_printf(info->sx->io, " call void @exit(i32 1)");
+				uni_print_str(info->sx->io, " call void @exit(i32 1)");
 				info->answer_const = ITEM_MAX;
 			}
 		}
@@ -960,7 +936,7 @@ static void emit_subscript_expression(information *const info, const node *const
 	if (dimensions - subscript_num - 1 != 0)
 	{
 		const item_t arr_type = ident_get_type(info->sx, id);
-		const item_t type = array_get_type(info, arr_type);
+		const item_t type = type_array_get_base_type(info->sx, arr_type);
 		const bool is_local = ident_is_local(info->sx, id);
 		info->answer_kind = ACONST;
 		info->answer_const = 0;
@@ -971,7 +947,7 @@ static void emit_subscript_expression(information *const info, const node *const
 	if (location != LMEM)
 	{
 		const item_t arr_type = ident_get_type(info->sx, id);
-		const item_t type = array_get_type(info, arr_type);
+		const item_t type = type_array_get_base_type(info->sx, arr_type);
 
 		to_code_load(info, info->register_num, info->register_num - 1, type, true, true);
 		info->register_num++;
@@ -1059,12 +1035,12 @@ static void emit_call_expression(information *const info, const node *const nd)
 		info->answer_kind = AREG;
 		info->answer_reg = info->register_num++;
 	}
-	uni_printf(info->sx->io, " call ");
+	uni_print_str(info->sx->io, " call ");
 
 	if (func_ref == BI_ROUND)
 	{
 		type_to_io(info, TYPE_FLOATING);
-		uni_printf(info->sx->io, " @llvm.round.f64(");
+		uni_print_str(info->sx->io, " @llvm.round.f64(");
 	}
 	else
 	{
@@ -1073,21 +1049,21 @@ static void emit_call_expression(information *const info, const node *const nd)
 		info->is_call = false;
 		if (ident_is_local(info->sx, func_ref))
 		{
-			uni_printf(info->sx->io, " @");
+			uni_print_str(info->sx->io, " @");
 			func_name_to_io(info, func_ref);
 		}
 		else
 		{
 			uni_printf(info->sx->io, " %%.%zu", func_reg);
 		}
-		uni_printf(info->sx->io, "(");
+		uni_print_str(info->sx->io, "(");
 	}
 
 	for (size_t i = 0; i < args; i++)
 	{
 		if (i != 0)
 		{
-			uni_printf(info->sx->io, ", ");
+			uni_print_str(info->sx->io, ", ");
 		}
 
 		if (arguments_type[i] == ASTR)
@@ -1106,7 +1082,7 @@ static void emit_call_expression(information *const info, const node *const nd)
 		
 		if (type_is_array(info->sx, arguments_value_type[i]))
 		{
-			size_t dim = array_get_dim(info, arguments_value_type[i]);
+			size_t dim = type_array_get_dimensions(info->sx, arguments_value_type[i]);
 
 			while (dim > 1)
 			{
@@ -1129,7 +1105,7 @@ static void emit_call_expression(information *const info, const node *const nd)
 			const node argument = expression_call_get_argument(nd, i);
 			const size_t id = expression_identifier_get_id(&argument);
 
-			uni_printf(info->sx->io, " @");
+			uni_print_str(info->sx->io, " @");
 			func_name_to_io(info, id);
 		}
 		else if (arguments_type[i] == AREG || arguments_type[i] == ALOGIC)
@@ -1160,7 +1136,7 @@ static void emit_call_expression(information *const info, const node *const nd)
 			uni_printf(info->sx->io, " %f", arguments_double[i]);
 		}
 	}
-	uni_printf(info->sx->io, ")\n");
+	uni_print_str(info->sx->io, ")\n");
 
 	if (func_ref == BI_ROUND)
 	{
@@ -1413,12 +1389,12 @@ static void emit_unary_expression(information *const info, const node *const nd)
 
 			if (type_is_integer(info->sx, type))
 			{
-				uni_printf(info->sx->io, " @abs(");
+				uni_print_str(info->sx->io, " @abs(");
 				info->was_abs = true;
 			}
 			else
 			{
-				uni_printf(info->sx->io, " @llvm.fabs.f64(");
+				uni_print_str(info->sx->io, " @llvm.fabs.f64(");
 				info->was_fabs = true;
 			}
 
@@ -1914,6 +1890,13 @@ static void emit_initializer_expression(information *const info, const node *con
 	else if (type_is_array(info->sx, expression_get_type(nd)))
 	{
 		const size_t index = hash_add(&info->arrays, -(item_t)(info->register_num), 1 + 1);
+		if (index == SIZE_MAX)
+		{
+			// Временный массив с таким же регистром уже добавлен
+			system_error(such_array_is_not_supported);
+			return;
+		}
+
 		hash_set_by_index(&info->arrays, index, IS_STATIC, 1);
 		hash_set_by_index(&info->arrays, index, 1, expression_initializer_get_size(nd));
 
@@ -2001,7 +1984,7 @@ static void emit_one_dimension_initialization(information *const info, const nod
 	, const item_t arr_type, const size_t cur_dimension, const item_t prev_slice, const bool is_local)
 {
 	const size_t size = node_get_type(nd) == OP_INITIALIZER ? expression_initializer_get_size(nd) : SIZE_MAX;
-	const item_t type = array_get_type(info, arr_type);
+	const item_t type = type_array_get_base_type(info->sx, arr_type);
 
 	for (size_t i = 0; i < size && size != SIZE_MAX; i++)
 	{
@@ -2054,7 +2037,7 @@ static void emit_initialization(information *const info, const node *const nd, c
 {
 	if (expression_get_class(nd) == EXPR_INITIALIZER && type_is_array(info->sx, expression_get_type(nd)))
 	{
-		const size_t dimensions = array_get_dim(info, arr_type);
+		const size_t dimensions = type_array_get_dimensions(info->sx, arr_type);
 		const size_t index = hash_get_index(&info->arrays, id);
 
 		node list_expression = *nd;
@@ -2067,7 +2050,7 @@ static void emit_initialization(information *const info, const node *const nd, c
 				? expression_initializer_get_subexpr(&list_expression, 0) : node_broken();
 		}
 
-		const item_t type = array_get_type(info, arr_type);
+		const item_t type = type_array_get_base_type(info->sx, arr_type);
 		const bool is_local = ident_is_local(info->sx, (size_t)id);
 
 		// TODO: с глобальными массивами хорошо бы как-то покрасивее сделать
@@ -2092,7 +2075,7 @@ static void emit_initialization(information *const info, const node *const nd, c
 		const size_t index = hash_get_index(&info->arrays, id);
 		hash_set_by_index(&info->arrays, index, 1, (item_t)length + 1);
 
-		const item_t type = array_get_type(info, arr_type);
+		const item_t type = type_array_get_base_type(info->sx, arr_type);
 		to_code_alloc_array_static(info, index, type, true);
 
 		for (size_t i = 0; i < length; i++)
@@ -2158,7 +2141,7 @@ static void emit_initialization(information *const info, const node *const nd, c
 
 				if (i != 0)
 				{
-					uni_printf(info->sx->io, ", ");
+					uni_print_str(info->sx->io, ", ");
 				}
 
 				// константа типа int
@@ -2173,7 +2156,7 @@ static void emit_initialization(information *const info, const node *const nd, c
 				}
 			}
 
-			uni_printf(info->sx->io, " }, align 4\n");
+			uni_print_str(info->sx->io, " }, align 4\n");
 		}
 	}
 	else if (expression_get_class(nd) == EXPR_CALL && type_is_structure(info->sx, expression_get_type(nd)))
@@ -2211,7 +2194,7 @@ static void emit_variable_declaration(information *const info, const node *const
 	{
 		uni_printf(info->sx->io, " %%var.%zu = alloca ", id);
 		type_to_io(info, type);
-		uni_printf(info->sx->io, ", align 4\n");
+		uni_print_str(info->sx->io, ", align 4\n");
 
 		if (declaration_variable_has_initializer(nd))
 		{
@@ -2309,7 +2292,7 @@ static void emit_variable_declaration(information *const info, const node *const
 
 			if (info->answer_kind == ACONST)
 			{
-				uni_printf(info->sx->io, "global ");
+				uni_print_str(info->sx->io, "global ");
 				type_to_io(info, type);
 				if (type_is_integer(info->sx, type))
 				{
@@ -2323,36 +2306,36 @@ static void emit_variable_declaration(information *const info, const node *const
 		}
 		else
 		{
-			uni_printf(info->sx->io, "common global ");
+			uni_print_str(info->sx->io, "common global ");
 			type_to_io(info, type);
 
 			if (type_is_integer(info->sx, type))
 			{
-				uni_printf(info->sx->io, " 0");
+				uni_print_str(info->sx->io, " 0");
 			}
 			else if (type_is_floating(info->sx, type))
 			{
-				uni_printf(info->sx->io, " 0.0");
+				uni_print_str(info->sx->io, " 0.0");
 			}
 			else if (type_is_boolean(info->sx, type))  
 			{
-				uni_printf(info->sx->io, " false");
+				uni_print_str(info->sx->io, " false");
 			}
 			else if (type_is_structure(info->sx, type))
 			{
-				uni_printf(info->sx->io, " zeroinitializer");
+				uni_print_str(info->sx->io, " zeroinitializer");
 			}
 			else if (type_is_pointer(info->sx, type))
 			{
-				uni_printf(info->sx->io, " null");
+				uni_print_str(info->sx->io, " null");
 			}
-			uni_printf(info->sx->io, ", align 4\n");
+			uni_print_str(info->sx->io, ", align 4\n");
 		}
 	}
 	else // массив
 	{
-		const size_t dimensions = array_get_dim(info, type);
-		const item_t element_type = array_get_type(info, type);
+		const size_t dimensions = type_array_get_dimensions(info->sx, type);
+		const item_t element_type = type_array_get_base_type(info->sx, type);
 		const size_t index = hash_add(&info->arrays, id, 1 + dimensions);
 		hash_set_by_index(&info->arrays, index, IS_STATIC, 1);
 
@@ -2425,19 +2408,19 @@ static void emit_function_definition(information *const info, const node *const
 	const size_t parameters = type_function_get_parameter_amount(info->sx, func_type);
 	info->was_dynamic = false;
 
-	uni_printf(info->sx->io, "define ");
+	uni_print_str(info->sx->io, "define ");
 	type_to_io(info, ret_type);
 	
 	if (ref_ident == info->sx->ref_main)
 	{
-		uni_printf(info->sx->io, " @main(");
+		uni_print_str(info->sx->io, " @main(");
 		info->is_main = true;
 	}
 	else
 	{
-		uni_printf(info->sx->io, " @");
+		uni_print_str(info->sx->io, " @");
 		func_name_to_io(info, ref_ident);
-		uni_printf(info->sx->io, "(");
+		uni_print_str(info->sx->io, "(");
 	}
 
 	for (size_t i = 0; i < parameters; i++)
@@ -2447,7 +2430,7 @@ static void emit_function_definition(information *const info, const node *const
 		const item_t param_type = type_function_get_parameter_type(info->sx, func_type, i);
 		type_to_io(info, param_type);
 	}
-	uni_printf(info->sx->io, ") {\n");
+	uni_print_str(info->sx->io, ") {\n");
 
 	for (size_t i = 0; i < parameters; i++)
 	{
@@ -2456,9 +2439,9 @@ static void emit_function_definition(information *const info, const node *const
 
 		uni_printf(info->sx->io, " %%var.%zu = alloca ", id);
 		type_to_io(info, param_type);
-		uni_printf(info->sx->io, ", align 4\n");
+		uni_print_str(info->sx->io, ", align 4\n");
 
-		uni_printf(info->sx->io, " store ");
+		uni_print_str(info->sx->io, " store ");
 		type_to_io(info, param_type);
 		uni_printf(info->sx->io, " %%%zu, ", i);
 		type_to_io(info, param_type);
@@ -2468,11 +2451,11 @@ static void emit_function_definition(information *const info, const node *const
 		{
 			uni_printf(info->sx->io, " %%dynarr.%zu = load ", id);
 			type_to_io(info, param_type);
-			uni_printf(info->sx->io, ", ");
+			uni_print_str(info->sx->io, ", ");
 			type_to_io(info, param_type);
 			uni_printf(info->sx->io, "* %%var.%zu, align 4\n", id);
 
-			const size_t dimensions = array_get_dim(info, param_type);
+			const size_t dimensions = type_array_get_dimensions(info->sx, param_type);
 			const size_t index = hash_add(&info->arrays, id, 1 + dimensions);
 			hash_set_by_index(&info->arrays, index, IS_STATIC, 0);
 		}
@@ -2492,15 +2475,15 @@ static void emit_function_definition(information *const info, const node *const
 		{
 			to_code_stack_load(info, -1);
 		}
-		uni_printf(info->sx->io, " ret void\n");
+		uni_print_str(info->sx->io, " ret void\n");
 	}
 	else if (ref_ident == info->sx->ref_main)
 	{
-		uni_printf(info->sx->io, " ret i32 0\n");
+		uni_print_str(info->sx->io, " ret i32 0\n");
 		info->is_main = false;
 	}
-	uni_printf(info->sx->io, " unreachable\n");
-	uni_printf(info->sx->io, "}\n\n");
+	uni_print_str(info->sx->io, " unreachable\n");
+	uni_print_str(info->sx->io, "}\n\n");
 }
 
 static void emit_declaration(information *const info, const node *const nd, const bool is_local)
@@ -2808,14 +2791,14 @@ static void emit_return_statement(information *const info, const node *const nd)
 		}
 		else if (info->answer_kind == AREG)
 		{
-			uni_printf(info->sx->io, " ret ");
+			uni_print_str(info->sx->io, " ret ");
 			type_to_io(info, answer_type);
 			uni_printf(info->sx->io, " %%.%zu\n", info->answer_reg);
 		}
 	}
 	else
 	{
-		uni_printf(info->sx->io, " ret void\n");
+		uni_print_str(info->sx->io, " ret void\n");
 	}
 }
 
@@ -2889,16 +2872,16 @@ static void emit_switch_statement(information *const info, const node *const nd)
 		}
 	}
 
-	uni_printf(info->sx->io, " switch ");
+	uni_print_str(info->sx->io, " switch ");
 	type_to_io(info, expression_get_type(&condition));
 	uni_printf(info->sx->io, " %%.%zu, label %%label%zu [\n", info->answer_reg, info->label_switch - case_num - has_default);
 	for (size_t i = 0; i < case_num; i++)
 	{
-		uni_printf(info->sx->io, "  ");
+		uni_print_str(info->sx->io, "  ");
 		type_to_io(info, expression_get_type(&condition));
 		uni_printf(info->sx->io, " %" PRIitem ", label %%label%zu\n", case_values[i], info->label_switch - i);
 	}
-	uni_printf(info->sx->io, " ]\n");
+	uni_print_str(info->sx->io, " ]\n");
 
 	info->label_break = info->label_switch - case_num - has_default;
 	if (statement_get_class(&body) == STMT_COMPOUND)
@@ -3013,8 +2996,8 @@ static int emit_translation_unit(information *const info, const node *const nd)
 	// FIXME: если это тоже объявление функций, почему тут, а не в functions_declaration?
 	if (info->was_stack_functions)
 	{
-		uni_printf(info->sx->io, "declare i8* @llvm.stacksave()\n");
-		uni_printf(info->sx->io, "declare void @llvm.stackrestore(i8*)\n");
+		uni_print_str(info->sx->io, "declare i8* @llvm.stacksave()\n");
+		uni_print_str(info->sx->io, "declare void @llvm.stackrestore(i8*)\n");
 	}
 
 	if (info->was_file)
@@ -3027,18 +3010,18 @@ static int emit_translation_unit(information *const info, const node *const nd)
 
 	if (info->was_abs)
 	{
-		uni_printf(info->sx->io, "declare i32 @abs(i32)\n");
+		uni_print_str(info->sx->io, "declare i32 @abs(i32)\n");
 	}
 
 	if (info->was_fabs)
 	{
-		uni_printf(info->sx->io, "declare double @llvm.fabs.f64(double)\n");
+		uni_print_str(info->sx->io, "declare double @llvm.fabs.f64(double)\n");
 	}
 
 
 	#ifdef _WIN32
-		uni_printf(info->sx->io, "!llvm.linker.options = !{!0}\n");
-		uni_printf(info->sx->io, "!0 = !{!\"/STACK:268435456\"}\n");
+		uni_print_str(info->sx->io, "!llvm.linker.options = !{!0}\n");
+		uni_print_str(info->sx->io, "!0 = !{!\"/STACK:268435456\"}\n");
 	#endif
 
 	return info->sx->rprt.errors != 0;
@@ -3048,13 +3031,13 @@ static void architecture(const workspace *const ws, syntax *const sx)
 {
 	if (ws_has_flag(ws, "--mipsel"))
 	{
-		uni_printf(sx->io, "target datalayout = \"e-m:m-p:32:32-i8:8:32-i16:16:32-i64:64-n32-S64\"\n");
-		uni_printf(sx->io, "target triple = \"mipsel\"\n\n");
+		uni_print_str(sx->io, "target datalayout = \"e-m:m-p:32:32-i8:8:32-i16:16:32-i64:64-n32-S64\"\n");
+		uni_print_str(sx->io, "target triple = \"mipsel\"\n\n");
 	}
 	else // if (ws_has_flag(ws, "--x86_64"))
 	{
-		uni_printf(sx->io, "target datalayout = \"e-m:e-i64:64-f80:128-n8:16:32:64-S128\"\n");
-		uni_printf(sx->io, "target triple = \"x86_64-pc-linux-gnu\"\n\n");
+		uni_print_str(sx->io, "target datalayout = \"e-m:e-i64:64-f80:128-n8:16:32:64-S128\"\n");
+		uni_print_str(sx->io, "target triple = \"x86_64-pc-linux-gnu\"\n\n");
 	}
 }
 
@@ -3075,9 +3058,9 @@ static void structs_declaration(information *const info)
 
 				if (type_is_array(info->sx, type_structure_field))
 				{
-					// const size_t dimensions = array_get_dim(info, type_structure_field);
-					// const item_t element_type = array_get_type(info, type_structure_field);
-					uni_printf(info->sx->io, "here");
+					// const size_t dimensions = type_array_get_dimensions(info->sx, type_structure_field);
+					// const item_t element_type = type_array_get_base_type(info->sx, type_structure_field);
+					uni_print_str(info->sx->io, "here");
 				}
 				else
 				{
@@ -3085,10 +3068,10 @@ static void structs_declaration(information *const info)
 				}
 			}
 
-			uni_printf(info->sx->io, " }\n");
+			uni_print_str(info->sx->io, " }\n");
 		}
 	}
-	uni_printf(info->sx->io, " \n");
+	uni_print_str(info->sx->io, " \n");
 }
 
 static void strings_declaration(information *const info)
@@ -3106,16 +3089,16 @@ static void strings_declaration(information *const info)
 			const char ch = string[j];
 			if (ch == '\n')
 			{
-				uni_printf(info->sx->io, "\\0A");
+				uni_print_str(info->sx->io, "\\0A");
 			}
 			else
 			{
 				uni_printf(info->sx->io, "%c", ch);
 			}
 		}
-		uni_printf(info->sx->io, "\\00\", align 1\n");
+		uni_print_str(info->sx->io, "\\00\", align 1\n");
 	}
-	uni_printf(info->sx->io, " \n");
+	uni_print_str(info->sx->io, " \n");
 }
 
 
@@ -3135,18 +3118,18 @@ static void builin_functions_declaration(information *const info)
 			const item_t ret_type = type_function_get_return_type(info->sx, func_type);
 			const size_t parameters = type_function_get_parameter_amount(info->sx, func_type);
 
-			uni_printf(info->sx->io, "declare ");
+			uni_print_str(info->sx->io, "declare ");
 			if (i == BI_ROUND)
 			{
 				type_to_io(info, TYPE_FLOATING);
-				uni_printf(info->sx->io, " @llvm.round.f64(");
+				uni_print_str(info->sx->io, " @llvm.round.f64(");
 			}
 			else
 			{
 				type_to_io(info, ret_type);
-				uni_printf(info->sx->io, " @");
+				uni_print_str(info->sx->io, " @");
 				func_name_to_io(info, i);
-				uni_printf(info->sx->io, "(");
+				uni_print_str(info->sx->io, "(");
 			}
 
 			for (size_t j = 0; j < parameters; j++)
@@ -3163,7 +3146,7 @@ static void builin_functions_declaration(information *const info)
 				}
 				type_to_io(info, type_parameter);
 			}
-			uni_printf(info->sx->io, ")\n");
+			uni_print_str(info->sx->io, ")\n");
 		}
 	}
 }
@@ -321,6 +321,8 @@ typedef struct encoder
 	bool registers[22];						/**< Информация о занятых регистрах */
 
 	size_t scope_displ;						/**< Смещение */
+
+	universal_io function_body;				/**< Буфер для тела текущей функции */
 } encoder;
 
 
@@ -341,21 +343,7 @@ static void emit_statement(encoder *const enc, const node *const nd);
 
 static size_t mips_type_size(const syntax *const sx, const item_t type)
 {
-	if (type_is_structure(sx, type))
-	{
-		size_t size = 0;
-		const size_t amount = type_structure_get_member_amount(sx, type);
-		for (size_t i = 0; i < amount; i++)
-		{
-			const item_t member_type = type_structure_get_member_type(sx, type, i);
-			size += mips_type_size(sx, member_type);
-		}
-		return size;
-	}
-	else
-	{
-		return WORD_LENGTH;
-	}
+	return type_word_size(sx, type) * WORD_LENGTH;
 }
 
 /**
@@ -608,207 +596,207 @@ static void mips_register_to_io(universal_io *const io, const mips_register_t re
 	switch (reg)
 	{
 		case R_ZERO:
-			uni_printf(io, "$0");
+			uni_print_str(io, "$0");
 			break;
 		case R_AT:
-			uni_printf(io, "$at");
+			uni_print_str(io, "$at");
 			break;
 
 		case R_V0:
-			uni_printf(io, "$v0");
+			uni_print_str(io, "$v0");
 			break;
 		case R_V1:
-			uni_printf(io, "$v1");
+			uni_print_str(io, "$v1");
 			break;
 
 		case R_A0:
-			uni_printf(io, "$a0");
+			uni_print_str(io, "$a0");
 			break;
 		case R_A1:
-			uni_printf(io, "$a1");
+			uni_print_str(io, "$a1");
 			break;
 		case R_A2:
-			uni_printf(io, "$a2");
+			uni_print_str(io, "$a2");
 			break;
 		case R_A3:
-			uni_printf(io, "$a3");
+			uni_print_str(io, "$a3");
 			break;
 
 		case R_T0:
-			uni_printf(io, "$t0");
+			uni_print_str(io, "$t0");
 			break;
 		case R_T1:
-			uni_printf(io, "$t1");
+			uni_print_str(io, "$t1");
 			break;
 		case R_T2:
-			uni_printf(io, "$t2");
+			uni_print_str(io, "$t2");
 			break;
 		case R_T3:
-			uni_printf(io, "$t3");
+			uni_print_str(io, "$t3");
 			break;
 		case R_T4:
-			uni_printf(io, "$t4");
+			uni_print_str(io, "$t4");
 			break;
 		case R_T5:
-			uni_printf(io, "$t5");
+			uni_print_str(io, "$t5");
 			break;
 		case R_T6:
-			uni_printf(io, "$t6");
+			uni_print_str(io, "$t6");
 			break;
 		case R_T7:
-			uni_printf(io, "$t7");
+			uni_print_str(io, "$t7");
 			break;
 
 		case R_S0:
-			uni_printf(io, "$s0");
+			uni_print_str(io, "$s0");
 			break;
 		case R_S1:
-			uni_printf(io, "$s1");
+			uni_print_str(io, "$s1");
 			break;
 		case R_S2:
-			uni_printf(io, "$s2");
+			uni_print_str(io, "$s2");
 			break;
 		case R_S3:
-			uni_printf(io, "$s3");
+			uni_print_str(io, "$s3");
 			break;
 		case R_S4:
-			uni_printf(io, "$s4");
+			uni_print_str(io, "$s4");
 			break;
 		case R_S5:
-			uni_printf(io, "$s5");
+			uni_print_str(io, "$s5");
 			break;
 		case R_S6:
-			uni_printf(io, "$s6");
+			uni_print_str(io, "$s6");
 			break;
 		case R_S7:
-			uni_printf(io, "$s7");
+			uni_print_str(io, "$s7");
 			break;
 
 		case R_T8:
-			uni_printf(io, "$t8");
+			uni_print_str(io, "$t8");
 			break;
 		case R_T9:
-			uni_printf(io, "$t9");
+			uni_print_str(io, "$t9");
 			break;
 
 		case R_K0:
-			uni_printf(io, "$k0");
+			uni_print_str(io, "$k0");
 			break;
 		case R_K1:
-			uni_printf(io, "$k1");
+			uni_print_str(io, "$k1");
 			break;
 
 		case R_GP:
-			uni_printf(io, "$gp");
+			uni_print_str(io, "$gp");
 			break;
 		case R_SP:
-			uni_printf(io, "$sp");
+			uni_print_str(io, "$sp");
 			break;
 		case R_FP:
-			uni_printf(io, "$fp");
+			uni_print_str(io, "$fp");
 			break;
 		case R_RA:
-			uni_printf(io, "$ra");
+			uni_print_str(io, "$ra");
 			break;
 
 		case R_FV0:
-			uni_printf(io, "$f0");
+			uni_print_str(io, "$f0");
 			break;
 		case R_FV1:
-			uni_printf(io, "$f1");
+			uni_print_str(io, "$f1");
 			break;
 		case R_FV2:
-			uni_printf(io, "$f2");
+			uni_print_str(io, "$f2");
 			break;
 		case R_FV3:
-			uni_printf(io, "$f3");
+			uni_print_str(io, "$f3");
 			break;
 
 		case R_FT0:
-			uni_printf(io, "$f4");
+			uni_print_str(io, "$f4");
 			break;
 		case R_FT1:
-			uni_printf(io, "$f5");
+			uni_print_str(io, "$f5");
 			break;
 		case R_FT2:
-			uni_printf(io, "$f6");
+			uni_print_str(io, "$f6");
 			break;
 		case R_FT3:
-			uni_printf(io, "$f7");
+			uni_print_str(io, "$f7");
 			break;
 		case R_FT4:
-			uni_printf(io, "$f8");
+			uni_print_str(io, "$f8");
 			break;
 		case R_FT5:
-			uni_printf(io, "$f9");
+			uni_print_str(io, "$f9");
 			break;
 		case R_FT6:
-			uni_printf(io, "$f10");
+			uni_print_str(io, "$f10");
 			break;
 		case R_FT7:
-			uni_printf(io, "$f11");
+			uni_print_str(io, "$f11");
 			break;
 		case R_FT8:
-			uni_printf(io, "$f16");
+			uni_print_str(io, "$f16");
 			break;
 		case R_FT9:
-			uni_printf(io, "$f17");
+			uni_print_str(io, "$f17");
 			break;
 		case R_FT10:
-			uni_printf(io, "$f18");
+			uni_print_str(io, "$f18");
 			break;
 		case R_FT11:
-			uni_printf(io, "$f19");
+			uni_print_str(io, "$f19");
 			break;
 
 		case R_FA0:
-			uni_printf(io, "$f12");
+			uni_print_str(io, "$f12");
 			break;
 		case R_FA1:
-			uni_printf(io, "$f13");
+			uni_print_str(io, "$f13");
 			break;
 		case R_FA2:
-			uni_printf(io, "$f14");
+			uni_print_str(io, "$f14");
 			break;
 		case R_FA3:
-			uni_printf(io, "$f15");
+			uni_print_str(io, "$f15");
 			break;
 
 		case R_FS0:
-			uni_printf(io, "$f20");
+			uni_print_str(io, "$f20");
 			break;
 		case R_FS1:
-			uni_printf(io, "$f21");
+			uni_print_str(io, "$f21");
 			break;
 		case R_FS2:
-			uni_printf(io, "$f22");
+			uni_print_str(io, "$f22");
 			break;
 		case R_FS3:
-			uni_printf(io, "$f23");
+			uni_print_str(io, "$f23");
 			break;
 		case R_FS4:
-			uni_printf(io, "$f24");
+			uni_print_str(io, "$f24");
 			break;
 		case R_FS5:
-			uni_printf(io, "$f25");
+			uni_print_str(io, "$f25");
 			break;
 		case R_FS6:
-			uni_printf(io, "$f26");
+			uni_print_str(io, "$f26");
 			break;
 		case R_FS7:
-			uni_printf(io, "$f27");
+			uni_print_str(io, "$f27");
 			break;
 		case R_FS8:
-			uni_printf(io, "$f28");
+			uni_print_str(io, "$f28");
 			break;
 		case R_FS9:
-			uni_printf(io, "$f29");
+			uni_print_str(io, "$f29");
 			break;
 		case R_FS10:
-			uni_printf(io, "$f30");
+			uni_print_str(io, "$f30");
 			break;
 		case R_FS11:
-			uni_printf(io, "$f31");
+			uni_print_str(io, "$f31");
 			break;
 	}
 }
@@ -818,162 +806,162 @@ static void instruction_to_io(universal_io *const io, const mips_instruction_t i
 	switch (instruction)
 	{
 		case IC_MIPS_MOVE:
-			uni_printf(io, "move");
+			uni_print_str(io, "move");
 			break;
 		case IC_MIPS_LI:
-			uni_printf(io, "li");
+			uni_print_str(io, "li");
 			break;
 		case IC_MIPS_LA:
-			uni_printf(io, "la");
+			uni_print_str(io, "la");
 			break;
 		case IC_MIPS_NOT:
-			uni_printf(io, "not");
+			uni_print_str(io, "not");
 			break;
 
 		case IC_MIPS_ADDI:
-			uni_printf(io, "addi");
+			uni_print_str(io, "addi");
 			break;
 		case IC_MIPS_SLL:
-			uni_printf(io, "sll");
+			uni_print_str(io, "sll");
 			break;
 		case IC_MIPS_SRA:
-			uni_printf(io, "sra");
+			uni_print_str(io, "sra");
 			break;
 		case IC_MIPS_ANDI:
-			uni_printf(io, "andi");
+			uni_print_str(io, "andi");
 			break;
 		case IC_MIPS_XORI:
-			uni_printf(io, "xori");
+			uni_print_str(io, "xori");
 			break;
 		case IC_MIPS_ORI:
-			uni_printf(io, "ori");
+			uni_print_str(io, "ori");
 			break;
 
 		case IC_MIPS_ADD:
-			uni_printf(io, "add");
+			uni_print_str(io, "add");
 			break;
 		case IC_MIPS_SUB:
-			uni_printf(io, "sub");
+			uni_print_str(io, "sub");
 			break;
 		case IC_MIPS_MUL:
-			uni_printf(io, "mul");
+			uni_print_str(io, "mul");
 			break;
 		case IC_MIPS_DIV:
-			uni_printf(io, "div");
+			uni_print_str(io, "div");
 			break;
 		case IC_MIPS_MOD:
-			uni_printf(io, "mod");
+			uni_print_str(io, "mod");
 			break;
 		case IC_MIPS_SLLV:
-			uni_printf(io, "sllv");
+			uni_print_str(io, "sllv");
 			break;
 		case IC_MIPS_SRAV:
-			uni_printf(io, "srav");
+			uni_print_str(io, "srav");
 			break;
 		case IC_MIPS_AND:
-			uni_printf(io, "and");
+			uni_print_str(io, "and");
 			break;
 		case IC_MIPS_XOR:
-			uni_printf(io, "xor");
+			uni_print_str(io, "xor");
 			break;
 		case IC_MIPS_OR:
-			uni_printf(io, "or");
+			uni_print_str(io, "or");
 			break;
 
 		case IC_MIPS_SW:
-			uni_printf(io, "sw");
+			uni_print_str(io, "sw");
 			break;
 		case IC_MIPS_LW:
-			uni_printf(io, "lw");
+			uni_print_str(io, "lw");
 			break;
 
 		case IC_MIPS_JR:
-			uni_printf(io, "jr");
+			uni_print_str(io, "jr");
 			break;
 		case IC_MIPS_JAL:
-			uni_printf(io, "jal");
+			uni_print_str(io, "jal");
 			break;
 		case IC_MIPS_J:
-			uni_printf(io, "j");
+			uni_print_str(io, "j");
 			break;
 
 		case IC_MIPS_BLEZ:
-			uni_printf(io, "blez");
+			uni_print_str(io, "blez");
 			break;
 		case IC_MIPS_BLTZ:
-			uni_printf(io, "bltz");
+			uni_print_str(io, "bltz");
 			break;
 		case IC_MIPS_BGEZ:
-			uni_printf(io, "bgez");
+			uni_print_str(io, "bgez");
 			break;
 		case IC_MIPS_BGTZ:
-			uni_printf(io, "bgtz");
+			uni_print_str(io, "bgtz");
 			break;
 		case IC_MIPS_BEQ:
-			uni_printf(io, "beq");
+			uni_print_str(io, "beq");
 			break;
 		case IC_MIPS_BNE:
-			uni_printf(io, "bne");
+			uni_print_str(io, "bne");
 			break;
 
 		case IC_MIPS_SLTIU:
-			uni_printf(io, "sltiu");
+			uni_print_str(io, "sltiu");
 			break;
 
 		case IC_MIPS_NOP:
-			uni_printf(io, "nop");
+			uni_print_str(io, "nop");
 			break;
 
 		case IC_MIPS_ADD_S:
-			uni_printf(io, "add.s");
+			uni_print_str(io, "add.s");
 			break;
 		case IC_MIPS_SUB_S:
-			uni_printf(io, "sub.s");
+			uni_print_str(io, "sub.s");
 			break;
 		case IC_MIPS_MUL_S:
-			uni_printf(io, "mul.s");
+			uni_print_str(io, "mul.s");
 			break;
 		case IC_MIPS_DIV_S:
-			uni_printf(io, "div.s");
+			uni_print_str(io, "div.s");
 			break;
 
 		case IC_MIPS_ABS_S:
-			uni_printf(io, "abs.s");
+			uni_print_str(io, "abs.s");
 			break;
 		case IC_MIPS_ABS:
-			uni_printf(io, "abs");
+			uni_print_str(io, "abs");
 			break;
 
 		case IC_MIPS_S_S:
-			uni_printf(io, "s.s");
+			uni_print_str(io, "s.s");
 			break;
 		case IC_MIPS_L_S:
-			uni_printf(io, "l.s");
+			uni_print_str(io, "l.s");
 			break;
 
 		case IC_MIPS_LI_S:
-			uni_printf(io, "li.s");
+			uni_print_str(io, "li.s");
 			break;
 
 		case IC_MIPS_MOV_S:
-			uni_printf(io, "mov.s");
+			uni_print_str(io, "mov.s");
 			break;
 
 		case IC_MIPS_MFC_1:
-			uni_printf(io, "mfc1");
+			uni_print_str(io, "mfc1");
 			break;
 		case IC_MIPS_MFHC_1:
-			uni_printf(io, "mfhc1");
+			uni_print_str(io, "mfhc1");
 			break;
 
 		case IC_MIPS_CVT_D_S:
-			uni_printf(io, "cvt.d.s");
+			uni_print_str(io, "cvt.d.s");
 			break;
 		case IC_MIPS_CVT_S_W:
-			uni_printf(io, "cvt.s.w");
+			uni_print_str(io, "cvt.s.w");
 			break;
 		case IC_MIPS_CVT_W_S:
-			uni_printf(io, "cvt.w.s");
+			uni_print_str(io, "cvt.w.s");
 			break;
 	}
 }
@@ -982,24 +970,24 @@ static void instruction_to_io(universal_io *const io, const mips_instruction_t i
 static void to_code_2R(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t fst_reg, const mips_register_t snd_reg)
 {
-	uni_printf(io, "\t");
+	uni_print_str(io, "\t");
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_str(io, " ");
 	mips_register_to_io(io, fst_reg);
-	uni_printf(io, ", ");
+	uni_print_str(io, ", ");
 	mips_register_to_io(io, snd_reg);
-	uni_printf(io, "\n");
+	uni_print_str(io, "\n");
 }
 
 // Вид инструкции:	instr	fst_reg, snd_reg, imm
 static void to_code_2R_I(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t fst_reg, const mips_register_t snd_reg, const item_t imm)
 {
-	uni_printf(io, "\t");
+	uni_print_str(io, "\t");
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_str(io, " ");
 	mips_register_to_io(io, fst_reg);
-	uni_printf(io, ", ");
+	uni_print_str(io, ", ");
 	mips_register_to_io(io, snd_reg);
 	uni_printf(io, ", %" PRIitem "\n", imm);
 }
@@ -1008,22 +996,22 @@ static void to_code_2R_I(universal_io *const io, const mips_instruction_t instru
 static void to_code_R_I_R(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t fst_reg, const item_t imm, const mips_register_t snd_reg)
 {
-	uni_printf(io, "\t");
+	uni_print_str(io, "\t");
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_str(io, " ");
 	mips_register_to_io(io, fst_reg);
 	uni_printf(io, ", %" PRIitem "(", imm);
 	mips_register_to_io(io, snd_reg);
-	uni_printf(io, ")\n");
+	uni_print_str(io, ")\n");
 }
 
 // Вид инструкции:	instr	reg, imm
 static void to_code_R_I(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t reg, const item_t imm)
 {
-	uni_printf(io, "\t");
+	uni_print_str(io, "\t");
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_str(io, " ");
 	mips_register_to_io(io, reg);
 	uni_printf(io, ", %" PRIitem "\n", imm);
 }
@@ -1090,7 +1078,7 @@ static void lvalue_to_io(encoder *const enc, const lvalue *const value)
 	{
 		uni_printf(enc->sx->io, "%" PRIitem "(", value->loc.displ);
 		mips_register_to_io(enc->sx->io, value->base_reg);
-		uni_printf(enc->sx->io, ")\n");
+		uni_print_str(enc->sx->io, ")\n");
 	}
 }
 
@@ -1182,31 +1170,31 @@ static void emit_label(encoder *const enc, const label *const lbl)
 	switch (lbl->kind)
 	{
 		case L_MAIN:
-			uni_printf(io, "MAIN");
+			uni_print_str(io, "MAIN");
 			break;
 		case L_FUNC:
-			uni_printf(io, "FUNC");
+			uni_print_str(io, "FUNC");
 			break;
 		case L_NEXT:
-			uni_printf(io, "NEXT");
+			uni_print_str(io, "NEXT");
 			break;
 		case L_FUNCEND:
-			uni_printf(io, "FUNCEND");
+			uni_print_str(io, "FUNCEND");
 			break;
 		case L_STRING:
-			uni_printf(io, "STRING");
+			uni_print_str(io, "STRING");
 			break;
 		case L_ELSE:
-			uni_printf(io, "ELSE");
+			uni_print_str(io, "ELSE");
 			break;
 		case L_END:
-			uni_printf(io, "END");
+			uni_print_str(io, "END");
 			break;
 		case L_BEGIN_CYCLE:
-			uni_printf(io, "BEGIN_CYCLE");
+			uni_print_str(io, "BEGIN_CYCLE");
 			break;
 		case L_CASE:
-			uni_printf(io, "CASE");
+			uni_print_str(io, "CASE");
 			break;
 	}
 
@@ -1222,7 +1210,7 @@ static void emit_label(encoder *const enc, const label *const lbl)
 static void emit_label_declaration(encoder *const enc, const label *const lbl)
 {
 	emit_label(enc, lbl);
-	uni_printf(enc->sx->io, ":\n");
+	uni_print_str(enc->sx->io, ":\n");
 }
 
 /**
@@ -1235,11 +1223,11 @@ static void emit_unconditional_branch(encoder *const enc, const mips_instruction
 {
 	assert(instruction == IC_MIPS_J || instruction == IC_MIPS_JAL);
 
-	uni_printf(enc->sx->io, "\t");
+	uni_print_str(enc->sx->io, "\t");
 	instruction_to_io(enc->sx->io, instruction);
-	uni_printf(enc->sx->io, " ");
+	uni_print_str(enc->sx->io, " ");
 	emit_label(enc, lbl);
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 }
 
 /**
@@ -1260,19 +1248,19 @@ static void emit_conditional_branch(encoder *const enc, const mips_instruction_t
 	}
 	else
 	{
-		uni_printf(enc->sx->io, "\t");
+		uni_print_str(enc->sx->io, "\t");
 		instruction_to_io(enc->sx->io, instruction);
-		uni_printf(enc->sx->io, " ");
+		uni_print_str(enc->sx->io, " ");
 		rvalue_to_io(enc, value);
-		uni_printf(enc->sx->io, ", ");
+		uni_print_str(enc->sx->io, ", ");
 		if (instruction == IC_MIPS_BEQ || instruction == IC_MIPS_BNE)
 		{
 			mips_register_to_io(enc->sx->io, R_ZERO);
-			uni_printf(enc->sx->io, ", ");
+			uni_print_str(enc->sx->io, ", ");
 		}
 		// иначе инструкции вида B..Z -- сравнение с нулём прямо в них
 		emit_label(enc, lbl);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 	}
 }
 
@@ -1286,11 +1274,11 @@ static void emit_register_branch(encoder *const enc, const mips_instruction_t in
 {
 	assert(instruction == IC_MIPS_JR);
 
-	uni_printf(enc->sx->io, "\t");
+	uni_print_str(enc->sx->io, "\t");
 	instruction_to_io(enc->sx->io, instruction);
-	uni_printf(enc->sx->io, " ");
+	uni_print_str(enc->sx->io, " ");
 	mips_register_to_io(enc->sx->io, reg);
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 }
 
 
@@ -1318,13 +1306,13 @@ static rvalue emit_load_of_immediate(encoder *const enc, const rvalue *const val
 	const mips_register_t reg = (type_is_floating(enc->sx, value->type)) ? get_float_register(enc) : get_register(enc);
 	const mips_instruction_t instruction = (type_is_floating(enc->sx, value->type)) ? IC_MIPS_LI_S : IC_MIPS_LI;
 
-	uni_printf(enc->sx->io, "\t");
+	uni_print_str(enc->sx->io, "\t");
 	instruction_to_io(enc->sx->io, instruction);
-	uni_printf(enc->sx->io, " ");
+	uni_print_str(enc->sx->io, " ");
 	mips_register_to_io(enc->sx->io, reg);
-	uni_printf(enc->sx->io, ", ");
+	uni_print_str(enc->sx->io, ", ");
 	rvalue_to_io(enc, value);
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 
 	return (rvalue) {
 		.from_lvalue = !FROM_LVALUE,
@@ -1378,13 +1366,13 @@ static rvalue emit_load_of_lvalue(encoder *const enc, const lvalue *const lval)
 		.type = lval->type,
 	};
 
-	uni_printf(enc->sx->io, "\t");
+	uni_print_str(enc->sx->io, "\t");
 	instruction_to_io(enc->sx->io, instruction);
-	uni_printf(enc->sx->io, " ");
+	uni_print_str(enc->sx->io, " ");
 	rvalue_to_io(enc, &result);
 	uni_printf(enc->sx->io, ", %" PRIitem "(", lval->loc.displ);
 	mips_register_to_io(enc->sx->io, lval->base_reg);
-	uni_printf(enc->sx->io, ")\n");
+	uni_print_str(enc->sx->io, ")\n");
 
 	// Для любых скалярных типов ничего не произойдёт,
 	// а для остальных освобождается base_reg, в котором хранилось смещение
@@ -1473,13 +1461,8 @@ static lvalue emit_member_lvalue(encoder *const enc, const node *const nd)
 	const bool is_arrow = expression_member_is_arrow(nd);
 	const item_t struct_type = is_arrow ? type_pointer_get_element_type(enc->sx, base_type) : base_type;
 
-	size_t member_displ = 0;
 	const size_t member_index = expression_member_get_member_index(nd);
-	for (size_t i = 0; i < member_index; i++)
-	{
-		const item_t member_type = type_structure_get_member_type(enc->sx, struct_type, i);
-		member_displ += mips_type_size(enc->sx, member_type);
-	}
+	const size_t member_displ = type_structure_get_member_word_displ(enc->sx, struct_type, member_index) * WORD_LENGTH;
 
 	const item_t type = expression_get_type(nd);
 
@@ -1578,32 +1561,32 @@ static void emit_move_rvalue_to_register(encoder *const enc
 	if (value->kind == RVALUE_KIND_CONST)
 	{
 		const mips_instruction_t instruction = !type_is_floating(enc->sx, value->type) ? IC_MIPS_LI : IC_MIPS_LI_S;
-		uni_printf(enc->sx->io, "\t");
+		uni_print_str(enc->sx->io, "\t");
 		instruction_to_io(enc->sx->io, instruction);
-		uni_printf(enc->sx->io, " ");
+		uni_print_str(enc->sx->io, " ");
 		mips_register_to_io(enc->sx->io, target);
-		uni_printf(enc->sx->io, ", ");
+		uni_print_str(enc->sx->io, ", ");
 		rvalue_to_io(enc, value);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 		return;
 	}
 
 	if (value->val.reg_num == target)
 	{
-		uni_printf(enc->sx->io, "\t# stays in register ");
+		uni_print_str(enc->sx->io, "\t# stays in register ");
 		mips_register_to_io(enc->sx->io, target);
-		uni_printf(enc->sx->io, ":\n");
+		uni_print_str(enc->sx->io, ":\n");
 	}
 	else
 	{
 		const mips_instruction_t instruction = !type_is_floating(enc->sx, value->type) ? IC_MIPS_MOVE : IC_MIPS_MFC_1;
-		uni_printf(enc->sx->io, "\t");
+		uni_print_str(enc->sx->io, "\t");
 		instruction_to_io(enc->sx->io, instruction);
-		uni_printf(enc->sx->io, " ");
+		uni_print_str(enc->sx->io, " ");
 		mips_register_to_io(enc->sx->io, target);
-		uni_printf(enc->sx->io, ", ");
+		uni_print_str(enc->sx->io, ", ");
 		rvalue_to_io(enc, value);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 	}
 }
 
@@ -1626,13 +1609,13 @@ static void emit_store_of_rvalue(encoder *const enc, const lvalue *const target,
 		if (value->val.reg_num != target->loc.reg_num)
 		{
 			const mips_instruction_t instruction = type_is_floating(enc->sx, value->type) ? IC_MIPS_MOV_S : IC_MIPS_MOVE;
-			uni_printf(enc->sx->io, "\t");
+			uni_print_str(enc->sx->io, "\t");
 			instruction_to_io(enc->sx->io, instruction);
-			uni_printf(enc->sx->io, " ");
+			uni_print_str(enc->sx->io, " ");
 			lvalue_to_io(enc, target);
-			uni_printf(enc->sx->io, ", ");
+			uni_print_str(enc->sx->io, ", ");
 			rvalue_to_io(enc, &reg_value);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 		}
 	}
 	else
@@ -1640,13 +1623,13 @@ static void emit_store_of_rvalue(encoder *const enc, const lvalue *const target,
 		if ((!type_is_structure(enc->sx, target->type)) && (!type_is_array(enc->sx, target->type)))
 		{
 			const mips_instruction_t instruction = type_is_floating(enc->sx, value->type) ? IC_MIPS_S_S : IC_MIPS_SW;
-			uni_printf(enc->sx->io, "\t");
+			uni_print_str(enc->sx->io, "\t");
 			instruction_to_io(enc->sx->io, instruction);
-			uni_printf(enc->sx->io, " ");
+			uni_print_str(enc->sx->io, " ");
 			rvalue_to_io(enc, &reg_value);
-			uni_printf(enc->sx->io, ", ");
+			uni_print_str(enc->sx->io, ", ");
 			lvalue_to_io(enc, target);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			// Освобождаем регистр только в том случае, если он был занят на этом уровне. Выше не лезем.
 			if (value->kind == RVALUE_KIND_CONST)
@@ -1661,13 +1644,13 @@ static void emit_store_of_rvalue(encoder *const enc, const lvalue *const target,
 			if (type_is_array(enc->sx, target->type))
 			{
 				// Загружаем указатель на массив
-				uni_printf(enc->sx->io, "\t");
+				uni_print_str(enc->sx->io, "\t");
 				instruction_to_io(enc->sx->io, IC_MIPS_SW);
-				uni_printf(enc->sx->io, " ");
+				uni_print_str(enc->sx->io, " ");
 				rvalue_to_io(enc, &reg_value);
 				uni_printf(enc->sx->io, ", %" PRIitem "(", target->loc.displ);
 				mips_register_to_io(enc->sx->io, target->base_reg);
-				uni_printf(enc->sx->io, ")\n\n");
+				uni_print_str(enc->sx->io, ")\n\n");
 				return;
 			}
 			// else кусок должен быть не достижим
@@ -1754,45 +1737,45 @@ static void emit_binary_operation(encoder *const enc, const rvalue *const dest
 				const item_t curr_label_num = enc->label_num++;
 				const label label_else = { .kind = L_END, .num = (size_t)curr_label_num };
 
-				uni_printf(enc->sx->io, "\t");
+				uni_print_str(enc->sx->io, "\t");
 				instruction_to_io(enc->sx->io, IC_MIPS_SUB);
-				uni_printf(enc->sx->io, " ");
+				uni_print_str(enc->sx->io, " ");
 				rvalue_to_io(enc, dest);
-				uni_printf(enc->sx->io, ", ");
+				uni_print_str(enc->sx->io, ", ");
 				rvalue_to_io(enc, first_operand);
-				uni_printf(enc->sx->io, ", ");
+				uni_print_str(enc->sx->io, ", ");
 				rvalue_to_io(enc, second_operand);
-				uni_printf(enc->sx->io, "\n");
+				uni_print_str(enc->sx->io, "\n");
 
 				const mips_instruction_t instruction = get_bin_instruction(operator, false);
 				emit_conditional_branch(enc, instruction, dest, &label_else);
 
-				uni_printf(enc->sx->io, "\t");
+				uni_print_str(enc->sx->io, "\t");
 				instruction_to_io(enc->sx->io, IC_MIPS_LI);
-				uni_printf(enc->sx->io, " ");
+				uni_print_str(enc->sx->io, " ");
 				rvalue_to_io(enc, dest);
-				uni_printf(enc->sx->io, ", 1\n");
+				uni_print_str(enc->sx->io, ", 1\n");
 
 				emit_label_declaration(enc, &label_else);
 
-				uni_printf(enc->sx->io, "\n");
+				uni_print_str(enc->sx->io, "\n");
 			}
 			break;
 
 			default:
 			{
-				uni_printf(enc->sx->io, "\t");
+				uni_print_str(enc->sx->io, "\t");
 				instruction_to_io(
 					enc->sx->io,
 					get_bin_instruction(operator, /* Два регистра => 0 в get_bin_instruction() -> */ 0)
 				);
-				uni_printf(enc->sx->io, " ");
+				uni_print_str(enc->sx->io, " ");
 				rvalue_to_io(enc, dest);
-				uni_printf(enc->sx->io, ", ");
+				uni_print_str(enc->sx->io, ", ");
 				rvalue_to_io(enc, first_operand);
-				uni_printf(enc->sx->io, ", ");
+				uni_print_str(enc->sx->io, ", ");
 				rvalue_to_io(enc, second_operand);
-				uni_printf(enc->sx->io, "\n");
+				uni_print_str(enc->sx->io, "\n");
 			}
 			break;
 		}
@@ -1815,28 +1798,28 @@ static void emit_binary_operation(encoder *const enc, const rvalue *const dest
 				const label label_else = { .kind = L_ELSE, .num = (size_t)curr_label_num };
 
 				// Записываем <значение из first_operand> - <значение из second_operand> в dest
-				uni_printf(enc->sx->io, "\t");
+				uni_print_str(enc->sx->io, "\t");
 				instruction_to_io(enc->sx->io, IC_MIPS_SUB);
-				uni_printf(enc->sx->io, " ");
+				uni_print_str(enc->sx->io, " ");
 				rvalue_to_io(enc, dest);
-				uni_printf(enc->sx->io, ", ");
+				uni_print_str(enc->sx->io, ", ");
 				rvalue_to_io(enc, &real_first_operand);
-				uni_printf(enc->sx->io, ", ");
+				uni_print_str(enc->sx->io, ", ");
 				rvalue_to_io(enc, &real_second_operand);
-				uni_printf(enc->sx->io, "\n");
+				uni_print_str(enc->sx->io, "\n");
 
 				const mips_instruction_t instruction = get_bin_instruction(operator, false);
 				emit_conditional_branch(enc, instruction, dest, &label_else);
 
-				uni_printf(enc->sx->io, "\t");
+				uni_print_str(enc->sx->io, "\t");
 				instruction_to_io(enc->sx->io, IC_MIPS_LI);
-				uni_printf(enc->sx->io, " ");
+				uni_print_str(enc->sx->io, " ");
 				rvalue_to_io(enc, dest);
-				uni_printf(enc->sx->io, ", 1\n");
+				uni_print_str(enc->sx->io, ", 1\n");
 
 				emit_label_declaration(enc, &label_else);
 
-				uni_printf(enc->sx->io, "\n");
+				uni_print_str(enc->sx->io, "\n");
 				break;
 			}
 
@@ -1852,29 +1835,29 @@ static void emit_binary_operation(encoder *const enc, const rvalue *const dest
 				bool change_order = (operator == BIN_ADD || operator == BIN_OR || operator == BIN_XOR || operator == BIN_AND) && first_operand->kind == RVALUE_KIND_CONST;
 
 				// Выписываем операцию, её результат будет записан в result
-				uni_printf(enc->sx->io, "\t");
+				uni_print_str(enc->sx->io, "\t");
 				instruction_to_io(
 					enc->sx->io,
 					get_bin_instruction(operator,
 										/* Один регистр => true в get_bin_instruction() -> */ !does_need_instruction_working_with_both_operands_in_registers)
 				);
-				uni_printf(enc->sx->io, " ");
+				uni_print_str(enc->sx->io, " ");
 				rvalue_to_io(enc, dest);
-				uni_printf(enc->sx->io, ", ");
+				uni_print_str(enc->sx->io, ", ");
 				if (change_order)
 				{
 					rvalue_to_io(enc, &real_second_operand);
-					uni_printf(enc->sx->io, ", ");
+					uni_print_str(enc->sx->io, ", ");
 					rvalue_to_io(enc, &real_first_operand);
 				}
 				else
 				{
 					rvalue_to_io(enc, &real_first_operand);
-					uni_printf(enc->sx->io, ", ");
+					uni_print_str(enc->sx->io, ", ");
 					rvalue_to_io(enc, &real_second_operand);
 				}
 
-				uni_printf(enc->sx->io, "\n");
+				uni_print_str(enc->sx->io, "\n");
 			}
 		}
 	}
@@ -1963,7 +1946,7 @@ static rvalue emit_printf_expression(encoder *const enc, const node *const nd)
 			R_SP,
 			-(item_t)WORD_LENGTH * (!type_is_floating(enc->sx, arg_rvalue_type) ? /* $a0 и $a1 */ 1 : /* $a0, $a1 и $a2 */ 2)
 		);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 
 		const lvalue a0_lval = {
 			.base_reg = R_SP,
@@ -1999,20 +1982,20 @@ static rvalue emit_printf_expression(encoder *const enc, const node *const nd)
 
 		if (!type_is_floating(enc->sx, arg_rvalue.type))
 		{
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 			emit_move_rvalue_to_register(enc, R_A1, &arg_rvalue);
 
 			uni_printf(enc->sx->io, "\tlui $t1, %%hi(STRING%zu)\n", index + (i - 1) * amount);
 			uni_printf(enc->sx->io, "\taddiu $a0, $t1, %%lo(STRING%zu)\n", index + (i - 1) * amount);
 
-			uni_printf(enc->sx->io, "\tjal printf\n");
-			uni_printf(enc->sx->io, "\t");
+			uni_print_str(enc->sx->io, "\tjal printf\n");
+			uni_print_str(enc->sx->io, "\t");
 			instruction_to_io(enc->sx->io, IC_MIPS_NOP);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			free_rvalue(enc, &arg_rvalue);
 
-			uni_printf(enc->sx->io, "\n\t# data restoring:\n");
+			uni_print_str(enc->sx->io, "\n\t# data restoring:\n");
 		}
 		else
 		{
@@ -2031,66 +2014,66 @@ static rvalue emit_printf_expression(encoder *const enc, const node *const nd)
 				.from_lvalue = !FROM_LVALUE
 			};
 			emit_store_of_rvalue(enc, &a2_lval, &a2_rval);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			// Конвертируем single to double
-			uni_printf(enc->sx->io, "\t");
+			uni_print_str(enc->sx->io, "\t");
 			instruction_to_io(enc->sx->io, IC_MIPS_CVT_D_S);
-			uni_printf(enc->sx->io, " ");
+			uni_print_str(enc->sx->io, " ");
 			rvalue_to_io(enc, &arg_rvalue);
-			uni_printf(enc->sx->io, ", ");
+			uni_print_str(enc->sx->io, ", ");
 			rvalue_to_io(enc, &arg_rvalue);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			// Следующие действия необходимы, т.к. аргументы в builtin-функции обязаны передаваться в $a0-$a3
 			// Даже для floating point!
 			// %lo из arg_rvalue в $a1
-			uni_printf(enc->sx->io, "\t");
+			uni_print_str(enc->sx->io, "\t");
 			instruction_to_io(enc->sx->io, IC_MIPS_MFC_1);
-			uni_printf(enc->sx->io, " ");
+			uni_print_str(enc->sx->io, " ");
 			mips_register_to_io(enc->sx->io, R_A1);
-			uni_printf(enc->sx->io, ", ");
+			uni_print_str(enc->sx->io, ", ");
 			rvalue_to_io(enc, &arg_rvalue);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			// %hi из arg_rvalue в $a2
-			uni_printf(enc->sx->io, "\t");
+			uni_print_str(enc->sx->io, "\t");
 			instruction_to_io(enc->sx->io, IC_MIPS_MFHC_1);
-			uni_printf(enc->sx->io, " ");
+			uni_print_str(enc->sx->io, " ");
 			mips_register_to_io(enc->sx->io, R_A2);
-			uni_printf(enc->sx->io, ", ");
+			uni_print_str(enc->sx->io, ", ");
 			rvalue_to_io(enc, &arg_rvalue);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			uni_printf(enc->sx->io, "\tlui $t1, %%hi(STRING%zu)\n", index + (i - 1) * amount);
 			uni_printf(enc->sx->io, "\taddiu $a0, $t1, %%lo(STRING%zu)\n", index + (i - 1) * amount);
 
-			uni_printf(enc->sx->io, "\tjal printf\n\t");
+			uni_print_str(enc->sx->io, "\tjal printf\n\t");
 			instruction_to_io(enc->sx->io, IC_MIPS_NOP);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			// Восстановление регистров-аргументов -- они могут понадобится в дальнейшем
-			uni_printf(enc->sx->io, "\n\t# data restoring:\n");
+			uni_print_str(enc->sx->io, "\n\t# data restoring:\n");
 
 			const rvalue a2_rval_to_copy = emit_load_of_lvalue(enc, &a2_lval);
 			emit_move_rvalue_to_register(enc, R_A2, &a2_rval_to_copy);
 
 			free_rvalue(enc, &a2_rval);
 			free_rvalue(enc, &arg_rvalue);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 		}
 
 		const rvalue a0_rval_to_copy = emit_load_of_lvalue(enc, &a0_lval);
 		emit_move_rvalue_to_register(enc, R_A0, &a0_rval_to_copy);
 
 		free_rvalue(enc, &a0_rval_to_copy);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 
 		const rvalue a1_rval_to_copy = emit_load_of_lvalue(enc, &a1_lval);
 		emit_move_rvalue_to_register(enc, R_A1, &a1_rval_to_copy);
 
 		free_rvalue(enc, &a1_rval_to_copy);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 
 		to_code_2R_I(
 			enc->sx->io,
@@ -2099,7 +2082,7 @@ static rvalue emit_printf_expression(encoder *const enc, const node *const nd)
 			R_SP,
 			(item_t)WORD_LENGTH * (!type_is_floating(enc->sx, arg_rvalue_type) ? /* $a0 и $a1 */ 1 : /* $a0, $a1 и $a2 */ 2)
 		);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 	}
 
 	const lvalue a0_lval = {
@@ -2120,12 +2103,12 @@ static rvalue emit_printf_expression(encoder *const enc, const node *const nd)
 
 	uni_printf(enc->sx->io, "\tlui $t1, %%hi(STRING%zu)\n", index + (parameters_amount - 1) * amount);
 	uni_printf(enc->sx->io, "\taddiu $a0, $t1, %%lo(STRING%zu)\n", index + (parameters_amount - 1) * amount);
-	uni_printf(enc->sx->io, "\tjal printf\n");
-	uni_printf(enc->sx->io, "\t");
+	uni_print_str(enc->sx->io, "\tjal printf\n");
+	uni_print_str(enc->sx->io, "\t");
 	instruction_to_io(enc->sx->io, IC_MIPS_NOP);
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 
-	uni_printf(enc->sx->io, "\n\t# data restoring:\n");
+	uni_print_str(enc->sx->io, "\n\t# data restoring:\n");
 	const rvalue a0_rval_to_copy = emit_load_of_lvalue(enc, &a0_lval);
 	emit_move_rvalue_to_register(enc, R_A0, &a0_rval_to_copy);
 
@@ -2187,13 +2170,13 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		lvalue prev_arg_displ[4 /* за $a0-$a3 */
 									+ 4 / 2 /* за $fa0, $fa2 (т.к. single precision)*/];
 
-		uni_printf(enc->sx->io, "\t# setting up $sp:\n");
+		uni_print_str(enc->sx->io, "\t# setting up $sp:\n");
 		if (displ_for_parameters)
 		{
 			to_code_2R_I(enc->sx->io, IC_MIPS_ADDI, R_SP, R_SP, -(item_t)(displ_for_parameters));
 		}
 
-		uni_printf(enc->sx->io, "\n\t# parameters passing:\n");
+		uni_print_str(enc->sx->io, "\n\t# parameters passing:\n");
 
 		// TODO: структуры / массивы в параметры
 		size_t arg_reg_count = 0;
@@ -2205,15 +2188,15 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 
 			if ((type_is_floating(enc->sx, arg_rvalue.type) ? f_arg_count : arg_count) < ARG_REG_AMOUNT)
 			{
-				uni_printf(enc->sx->io, "\t# saving ");
+				uni_print_str(enc->sx->io, "\t# saving ");
 				mips_register_to_io(enc->sx->io, (type_is_floating(enc->sx, arg_rvalue.type)
 					? R_FA0 + f_arg_count
 					: R_A0 + arg_count));
-				uni_printf(enc->sx->io, " value on stack:\n");
+				uni_print_str(enc->sx->io, " value on stack:\n");
 			}
 			else
 			{
-				uni_printf(enc->sx->io, "\t# parameter on stack:\n");
+				uni_print_str(enc->sx->io, "\t# parameter on stack:\n");
 			}
 
 			const lvalue tmp_arg_lvalue = {
@@ -2273,12 +2256,12 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		emit_unconditional_branch(enc, IC_MIPS_JAL, &label_func);
 
 		// Восстановление регистров-аргументов -- они могут понадобится в дальнейшем
-		uni_printf(enc->sx->io, "\n\t# data restoring:\n");
+		uni_print_str(enc->sx->io, "\n\t# data restoring:\n");
 
 		size_t i = 0, j = 0;	// Счётчик обычных и floating point регистров-аргументов соответственно
 		while (i + j < arg_reg_count)
 		{
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			const rvalue tmp_rval = emit_load_of_lvalue(enc, &prev_arg_displ[i + j]);
 			emit_move_rvalue_to_register(
@@ -2295,7 +2278,7 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 			to_code_2R_I(enc->sx->io, IC_MIPS_ADDI, R_SP, R_SP, (item_t)displ_for_parameters);
 		}
 
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 	}
 	else
 	{
@@ -2861,35 +2844,35 @@ static void emit_array_init(encoder *const enc, const node *const nd, const size
 	const size_t amount = expression_initializer_get_size(init);
 
 	// Проверка на соответствие размеров массива и инициализатора
-	uni_printf(enc->sx->io, "\n\t# Check for array and initializer sizes equality:\n");
+	uni_print_str(enc->sx->io, "\n\t# Check for array and initializer sizes equality:\n");
 
 	const node bound = declaration_variable_get_bound(nd, dimension);
 	const rvalue tmp = emit_expression(enc, &bound);
 	const rvalue bound_rvalue = (tmp.kind == RVALUE_KIND_REGISTER) ? tmp : emit_load_of_immediate(enc, &tmp);
 
 	// FIXME: через emit_binary_operation()
-	uni_printf(enc->sx->io, "\t");
+	uni_print_str(enc->sx->io, "\t");
 	instruction_to_io(enc->sx->io, IC_MIPS_ADDI);
-	uni_printf(enc->sx->io, " ");
+	uni_print_str(enc->sx->io, " ");
 	rvalue_to_io(enc, &bound_rvalue);
-	uni_printf(enc->sx->io, ", ");
+	uni_print_str(enc->sx->io, ", ");
 	rvalue_to_io(enc, &bound_rvalue);
 	uni_printf(enc->sx->io, ", %" PRIitem "\n", -(item_t)amount);
 
-	uni_printf(enc->sx->io, "\t");
+	uni_print_str(enc->sx->io, "\t");
 	instruction_to_io(enc->sx->io, IC_MIPS_BNE);
-	uni_printf(enc->sx->io, " ");
+	uni_print_str(enc->sx->io, " ");
 	rvalue_to_io(enc, &bound_rvalue);
-	uni_printf(enc->sx->io, ", ");
+	uni_print_str(enc->sx->io, ", ");
 	mips_register_to_io(enc->sx->io, R_ZERO);
-	uni_printf(enc->sx->io, ", error\n");	// FIXME: error согласно RUNTIME'му
+	uni_print_str(enc->sx->io, ", error\n");	// FIXME: error согласно RUNTIME'му
 
 	free_rvalue(enc, &bound_rvalue);
 
 	for (size_t i = 0; i < amount; i++)
 	{
 		const node subexpr = expression_initializer_get_subexpr(init, i);
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 		if (expression_get_class(&subexpr) == EXPR_INITIALIZER)
 		{
 			// Сдвиг адреса на размер массива + 1 (за размер следующего измерения)
@@ -2908,7 +2891,7 @@ static void emit_array_init(encoder *const enc, const node *const nd, const size
 
 			// Сдвиг адреса
 			to_code_2R_I(enc->sx->io, IC_MIPS_ADDI, addr->val.reg_num, addr->val.reg_num, -(item_t)WORD_LENGTH);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 			free_register(enc, reg);
 		}
 		else
@@ -3016,7 +2999,7 @@ static void emit_array_declaration(encoder *const enc, const node *const nd)
 		to_code_2R(enc->sx->io, IC_MIPS_MOVE, R_A3, R_A1);
 	}
 
-	uni_printf(enc->sx->io, "\tjal DEFARR1\n");
+	uni_print_str(enc->sx->io, "\tjal DEFARR1\n");
 
 	for (size_t j = 1; j < dim; j++)
 	{
@@ -3031,7 +3014,7 @@ static void emit_array_declaration(encoder *const enc, const node *const nd)
 		to_code_2R(enc->sx->io, IC_MIPS_MOVE, R_S5, R_A0);
 		to_code_2R(enc->sx->io, IC_MIPS_MOVE, R_S6, R_A1);
 
-		uni_printf(enc->sx->io, "\tjal DEFARR2\n");
+		uni_print_str(enc->sx->io, "\tjal DEFARR2\n");
 
 		if (j != dim - 1)
 		{
@@ -3043,7 +3026,7 @@ static void emit_array_declaration(encoder *const enc, const node *const nd)
 
 	if (has_init)
 	{
-		uni_printf(enc->sx->io, "\n");
+		uni_print_str(enc->sx->io, "\n");
 
 		const rvalue variable_value = emit_load_of_lvalue(enc, &variable);
 		const node init = declaration_variable_get_initializer(nd);
@@ -3162,7 +3145,7 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 	if (ref_ident == enc->sx->ref_main)
 	{
 		// FIXME: пока тут будут две метки для функции main
-		uni_printf(enc->sx->io, "MAIN:\n");
+		uni_print_str(enc->sx->io, "MAIN:\n");
 	}
 
 	uni_printf(enc->sx->io, "\t# \"%s\" function:\n", ident_get_spelling(enc->sx, ref_ident));
@@ -3173,7 +3156,7 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 
 	// Сохранение оберегаемых регистров перед началом работы функции
 	// FIXME: избавиться от функций to_code
-	uni_printf(enc->sx->io, "\n\t# preserved registers:\n");
+	uni_print_str(enc->sx->io, "\n\t# preserved registers:\n");
 	to_code_R_I_R(enc->sx->io, IC_MIPS_SW, R_RA, -(item_t)RA_SIZE, R_SP);
 	to_code_R_I_R(enc->sx->io, IC_MIPS_SW, R_FP, -(item_t)(RA_SIZE + SP_SIZE), R_SP);
 
@@ -3183,7 +3166,7 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 		to_code_R_I_R(enc->sx->io, IC_MIPS_SW, R_S0 + i, -(item_t)(RA_SIZE + SP_SIZE + (i + 1) * WORD_LENGTH), R_SP);
 	}
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 
 	// Сохранение fs0-fs10 (в цикле 5, т.к. операции одинарной точности => нужны только четные регистры)
 	for (size_t i = 0; i < PRESERVED_FP_REG_AMOUNT / 2; i++)
@@ -3204,13 +3187,11 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 		}
 	}
 
-	// Создание буфера для тела функции
+	// Тело функции выводится в буфер, так как пролог зависит от него
 	universal_io *const old_io = enc->sx->io;
-	universal_io new_io = io_create();
-	out_set_buffer(&new_io, BUFFER_SIZE);
-	enc->sx->io = &new_io;
+	enc->sx->io = &enc->function_body;
 
-	uni_printf(enc->sx->io, "\n\t# function parameters:\n");
+	uni_print_str(enc->sx->io, "\n\t# function parameters:\n");
 
 	size_t register_arguments_amount = 0;
 	size_t floating_register_arguments_amount = 0;
@@ -3233,9 +3214,9 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 			const mips_register_t curr_reg = argument_is_float 
 				? R_FA0 + 2 * floating_register_arguments_amount++
 				: R_A0 + register_arguments_amount++;
-			uni_printf(enc->sx->io, "is in register ");
+			uni_print_str(enc->sx->io, "is in register ");
 			mips_register_to_io(enc->sx->io, curr_reg);
-			uni_printf(enc->sx->io, "\n");
+			uni_print_str(enc->sx->io, "\n");
 
 			// Вносим переменную в таблицу символов
 			const lvalue value = {.kind = LVALUE_KIND_REGISTER, .type = type, .loc.reg_num = curr_reg, .base_reg = R_FP };
@@ -3252,36 +3233,34 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 		}
 	}
 
-	uni_printf(enc->sx->io, "\n\t# function body:\n");
+	uni_print_str(enc->sx->io, "\n\t# function body:\n");
 	node body = declaration_function_get_body(nd);
 	emit_statement(enc, &body);
 
-	// Извлечение буфера с телом функции в старый io
-	char *buffer = out_extract_buffer(enc->sx->io);
 	enc->sx->io = old_io;
 
-	uni_printf(enc->sx->io, "\n\t# setting up $fp:\n");
+	uni_print_str(enc->sx->io, "\n\t# setting up $fp:\n");
 	// $fp указывает на конец статики (которое в данный момент равно концу динамики)
 	to_code_2R_I(enc->sx->io, IC_MIPS_ADDI, R_FP, R_SP, -(item_t)(FUNC_DISPL_PRESEREVED + WORD_LENGTH));
 
-	uni_printf(enc->sx->io, "\n\t# setting up $sp:\n");
+	uni_print_str(enc->sx->io, "\n\t# setting up $sp:\n");
 	// $sp указывает на конец динамики (которое в данный момент равно концу статики)
 	// Смещаем $sp ниже конца статики (чтобы он не совпадал с $fp)
 	to_code_2R_I(enc->sx->io, IC_MIPS_ADDI, R_SP, R_FP, -(item_t)(WORD_LENGTH + enc->max_displ));
 
-	uni_printf(enc->sx->io, "%s", buffer);
-	free(buffer);
+	// Перенос тела функции после пролога, буфер остаётся пустым для следующей функции
+	out_splice(enc->sx->io, &enc->function_body);
 
 	const label end_label = { .kind = L_FUNCEND, .num = ref_ident };
 	emit_label_declaration(enc, &end_label);
 
 	// Восстановление стека после работы функции
-	uni_printf(enc->sx->io, "\n\t# data restoring:\n");
+	uni_print_str(enc->sx->io, "\n\t# data restoring:\n");
 
 	// Ставим $fp на его положение в предыдущей функции
 	to_code_2R_I(enc->sx->io, IC_MIPS_ADDI, R_SP, R_FP, (item_t)(FUNC_DISPL_PRESEREVED + WORD_LENGTH));
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 
 	// Восстановление $s0-$s7
 	for (size_t i = 0; i < PRESERVED_REG_AMOUNT; i++)
@@ -3289,7 +3268,7 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 		to_code_R_I_R(enc->sx->io, IC_MIPS_LW, R_S0 + i, -(item_t)(RA_SIZE + SP_SIZE + (i + 1) * WORD_LENGTH), R_SP);
 	}
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 
 	// Восстановление $fs0-$fs7
 	for (size_t i = 0; i < PRESERVED_FP_REG_AMOUNT / 2; i++)
@@ -3298,7 +3277,7 @@ static void emit_function_definition(encoder *const enc, const node *const nd)
 			, -(item_t)(RA_SIZE + SP_SIZE + (i + 1) * WORD_LENGTH + /* за s0-s7 */ 8 * WORD_LENGTH), R_SP);
 	}
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 
 	// Возвращаем $sp его положение в предыдущей функции
 	to_code_R_I_R(enc->sx->io, IC_MIPS_LW, R_FP, -(item_t)(RA_SIZE + SP_SIZE), R_SP);
@@ -3326,7 +3305,7 @@ static void emit_declaration(encoder *const enc, const node *const nd)
 			return;
 	}
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 }
 
 
@@ -3511,7 +3490,7 @@ static void emit_switch_statement(encoder *const enc, const node *const nd)
 
 	free_rvalue(enc, &condition_rvalue);
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 
 	// Размещение тел всех case и default statements
 	for (size_t i = 0; i < amount; i++)
@@ -3775,7 +3754,7 @@ static void emit_statement(encoder *const enc, const node *const nd)
 			break;
 	}
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_str(enc->sx->io, "\n");
 }
 
 /**
@@ -3803,22 +3782,22 @@ static void pregen(syntax *const sx)
 	// Подпись "GNU As:" для директив GNU
 	// Подпись "MIPS Assembler:" для директив ассемблера MIPS
 
-	uni_printf(sx->io, "\t.section .mdebug.abi32\n");	// ?
-	uni_printf(sx->io, "\t.previous\n");				// следующая инструкция будет перенесена в секцию, описанную выше
-	uni_printf(sx->io, "\t.nan\tlegacy\n");				// ?
-	uni_printf(sx->io, "\t.module fp=xx\n");			// ?
-	uni_printf(sx->io, "\t.module nooddspreg\n");		// ?
-	uni_printf(sx->io, "\t.abicalls\n");				// ?
-	uni_printf(sx->io, "\t.option pic0\n");				// как если бы при компиляции была включена опция "-fpic" (что означает?)
-	uni_printf(sx->io, "\t.text\n");					// последующий код будет перенесён в текстовый сегмент памяти
+	uni_print_str(sx->io, "\t.section .mdebug.abi32\n");	// ?
+	uni_print_str(sx->io, "\t.previous\n");				// следующая инструкция будет перенесена в секцию, описанную выше
+	uni_print_str(sx->io, "\t.nan\tlegacy\n");				// ?
+	uni_print_str(sx->io, "\t.module fp=xx\n");			// ?
+	uni_print_str(sx->io, "\t.module nooddspreg\n");		// ?
+	uni_print_str(sx->io, "\t.abicalls\n");				// ?
+	uni_print_str(sx->io, "\t.option pic0\n");				// как если бы при компиляции была включена опция "-fpic" (что означает?)
+	uni_print_str(sx->io, "\t.text\n");					// последующий код будет перенесён в текстовый сегмент памяти
 	// выравнивание последующих данных / команд по границе, кратной 2^n байт (в данном случае 2^2 = 4)
-	uni_printf(sx->io, "\t.align 2\n");
+	uni_print_str(sx->io, "\t.align 2\n");
 
 	// делает метку main глобальной -- её можно вызывать извне кода (например, используется при линковке)
-	uni_printf(sx->io, "\n\t.globl\tmain\n");
-	uni_printf(sx->io, "\t.ent\tmain\n");				// начало процедуры main
-	uni_printf(sx->io, "\t.type\tmain, @function\n");	// тип "main" -- функция
-	uni_printf(sx->io, "main:\n");
+	uni_print_str(sx->io, "\n\t.globl\tmain\n");
+	uni_print_str(sx->io, "\t.ent\tmain\n");				// начало процедуры main
+	uni_print_str(sx->io, "\t.type\tmain, @function\n");	// тип "main" -- функция
+	uni_print_str(sx->io, "main:\n");
 
 	// инициализация gp
 	// "__gnu_local_gp" -- локация в памяти, где лежит Global Pointer
@@ -3831,14 +3810,14 @@ static void pregen(syntax *const sx)
 	to_code_R_I_R(sx->io, IC_MIPS_SW, R_RA, 0, R_SP);
 	to_code_R_I(sx->io, IC_MIPS_LI, R_T0, LOW_DYN_BORDER);
 	to_code_R_I_R(sx->io, IC_MIPS_SW, R_T0, -(item_t)HEAP_DISPL - 60, R_GP);
-	uni_printf(sx->io, "\n");
+	uni_print_str(sx->io, "\n");
 }
 
 // создаём метки всех строк в программе
 static void strings_declaration(encoder *const enc)
 {
-	uni_printf(enc->sx->io, "\t.rdata\n");
-	uni_printf(enc->sx->io, "\t.align 2\n");
+	uni_print_str(enc->sx->io, "\t.rdata\n");
+	uni_print_str(enc->sx->io, "\t.align 2\n");
 
 	const size_t amount = strings_amount(enc->sx);
 	for (size_t i = 0; i < amount; i++)
@@ -3846,7 +3825,7 @@ static void strings_declaration(encoder *const enc)
 		item_t args_for_printf = 0;
 		const label string_label = { .kind = L_STRING, .num = i };
 		emit_label_declaration(enc, &string_label);
-		uni_printf(enc->sx->io, "\t.ascii \"");
+		uni_print_str(enc->sx->io, "\t.ascii \"");
 
 		const char *string = string_get(enc->sx, i);
 		for (size_t j = 0; string[j] != '\0'; j++)
@@ -3854,7 +3833,7 @@ static void strings_declaration(encoder *const enc)
 			const char ch = string[j];
 			if (ch == '\n')
 			{
-				uni_printf(enc->sx->io, "\\n");
+				uni_print_str(enc->sx->io, "\\n");
 			}
 			else if (ch == '%')
 			{
@@ -3864,10 +3843,10 @@ static void strings_declaration(encoder *const enc)
 				uni_printf(enc->sx->io, "%c", ch);
 				uni_printf(enc->sx->io, "%c", string[j]);
 
-				uni_printf(enc->sx->io, "\\0\"\n");
+				uni_print_str(enc->sx->io, "\\0\"\n");
 				const label another_str_label = { .kind = L_STRING, .num = (size_t)(i + args_for_printf * amount) };
 				emit_label_declaration(enc, &another_str_label);
-				uni_printf(enc->sx->io, "\t.ascii \"");
+				uni_print_str(enc->sx->io, "\t.ascii \"");
 			}
 			else
 			{
@@ -3875,13 +3854,13 @@ static void strings_declaration(encoder *const enc)
 			}
 		}
 
-		uni_printf(enc->sx->io, "\\0\"\n");
+		uni_print_str(enc->sx->io, "\\0\"\n");
 	}
-	uni_printf(enc->sx->io, "\t.text\n");
-	uni_printf(enc->sx->io, "\t.align 2\n\n");
+	uni_print_str(enc->sx->io, "\t.text\n");
+	uni_print_str(enc->sx->io, "\t.align 2\n\n");
 
 	// Прыжок на главную метку
-	uni_printf(enc->sx->io, "\tjal MAIN\n");
+	uni_print_str(enc->sx->io, "\tjal MAIN\n");
 
 	// Выход из программы в конце работы
 	to_code_R_I_R(enc->sx->io, IC_MIPS_LW, R_RA, 0, R_SP);
@@ -3920,8 +3899,8 @@ DEFARR2:\n\
 	bne $a3, $0, DEFARR2	# Прыгаем, если ещё не всё выделили\n\
 	jr $ra\n");
 
-	uni_printf(enc->sx->io, "\n\n\t.end\tmain\n");
-	uni_printf(enc->sx->io, "\t.size\tmain, .-main\n");
+	uni_print_str(enc->sx->io, "\n\n\t.end\tmain\n");
+	uni_print_str(enc->sx->io, "\t.size\tmain, .-main\n");
 }
 
 
@@ -3953,6 +3932,9 @@ int encode_to_mips(const workspace *const ws, syntax *const sx)
 
 	enc.displacements = hash_create(HASH_TABLE_SIZE);
 
+	enc.function_body = io_create();
+	out_set_buffer(&enc.function_body, BUFFER_SIZE);
+
 	for (size_t i = 0; i < TEMP_REG_AMOUNT + TEMP_FP_REG_AMOUNT; i++)
 	{
 		enc.registers[i] = false;
@@ -3965,6 +3947,7 @@ int encode_to_mips(const workspace *const ws, syntax *const sx)
 	const int ret = emit_translation_unit(&enc, &root);
 	postgen(&enc);
 
+	io_erase(&enc.function_body);
 	hash_clear(&enc.displacements);
 	return ret;
 }
@@ -68,7 +68,7 @@ static node parse_statement(parser *const prs);
 
 
 /**
- *	Create parser
+ *	Create parser, its first token is lexed by @c parser_start
  *
  *	@param	sx			Syntax structure
  *
@@ -82,11 +82,30 @@ static inline parser parser_create(syntax *const sx)
 	prs.is_in_loop = false;
 	prs.is_in_switch = false;
 
-	consume_token(&prs);
-
 	return prs;
 }
 
+/**
+ *	Lex the first token of parser
+ *
+ *	@param	prs			Parser
+ *	@param	tokenize	Set, if the whole input should be lexed before parsing
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+static inline int parser_start(parser *const prs, const bool tokenize)
+{
+	// Лексер уже прочитал вход до ошибки, поэтому разбор без массива лексем начался бы с середины файла
+	if (tokenize && lexer_tokenize(&prs->lxr))
+	{
+		error_msg("недостаточно памяти для массива лексем");
+		return -1;
+	}
+
+	consume_token(prs);
+	return 0;
+}
+
 /**
  *	Free allocated memory
  *
@@ -998,10 +1017,7 @@ static item_t parse_struct_declaration(parser *const prs, const node *const pare
 
 	const node result = build_struct_declaration(&prs->bld, &declaration, &members);
 
-	// FIXME: need a more beautiful way to do this
-	node temp = node_add_child(parent, OP_NOP);
-	node_swap(&result, &temp);
-	node_remove(&temp);
+	node_move(&result, parent);
 
 	node_vector_clear(&members);
 	return declaration_struct_get_type(&result);
@@ -2090,9 +2106,7 @@ static void parse_function_definition(parser *const prs, node *const parent, con
 	node_copy(&prs->bld.context, &nd);
 	node body = parse_compound_statement_body(prs);
 
-	node temp = node_add_child(&nd, OP_NOP);
-	node_swap(&body, &temp);
-	node_remove(&temp);
+	node_move(&body, &nd);
 
 	if (type_function_get_return_type(prs->sx, prs->bld.func_type) != TYPE_VOID && !prs->was_return)
 	{
@@ -2224,9 +2238,7 @@ static void parse_external_definition(parser *const prs, node *const root)
 			{
 				node declarator = parse_init_declarator(prs, type);
 
-				node temp = node_add_child(root, OP_NOP);
-				node_swap(&declarator, &temp);
-				node_remove(&temp);
+				node_move(&declarator, root);
 			}
 		}
 		else
@@ -2256,17 +2268,15 @@ static void parse_translation_unit(parser *const prs, node *const root)
 	} while (token_is_not(&prs->tk, TK_EOF));
 }
 
-
-/*
- *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
- *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
- *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
- *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
- *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+/**
+ *	Parse source code to generate syntax tree
+ *
+ *	@param	sx			Syntax structure
+ *	@param	tokenize	Set, if the whole input should be lexed before parsing
+ *
+ *	@return	@c 0 on success, @c -1 on failure, @c -2 on system error
  */
-
-
-int parse(syntax *const sx)
+static int parse_source(syntax *const sx, const bool tokenize)
 {
 	if (sx == NULL)
 	{
@@ -2274,6 +2284,12 @@ int parse(syntax *const sx)
 	}
 
 	parser prs = parser_create(sx);
+	if (parser_start(&prs, tokenize))
+	{
+		parser_clear(&prs);
+		return -2;
+	}
+
 	node root = node_get_root(&sx->tree);
 	node_copy(&prs.bld.context, &root);
 
@@ -2287,3 +2303,23 @@ int parse(syntax *const sx)
 	// Временное решение - парсер не проверяет таблицы
 	return sx->rprt.errors == 0 ? 0 : -1;
 }
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+int parse(syntax *const sx)
+{
+	return parse_source(sx, false);
+}
+
+int parse_tokenized(syntax *const sx)
+{
+	return parse_source(sx, true);
+}
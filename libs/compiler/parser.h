@@ -30,10 +30,20 @@ extern "C" {
  *
  *	@param	sx		Syntax structure
  *
- *	@return	@c 0 on success, @c 1 on failure
+ *	@return	@c 0 on success, @c -1 on failure
  */
 int parse(syntax *const sx);
 
+/**
+ *	Parse source code to generate syntax tree,
+ *	the whole input is lexed into token array before parsing
+ *
+ *	@param	sx		Syntax structure
+ *
+ *	@return	@c 0 on success, @c -1 on failure, @c -2 on system error
+ */
+int parse_tokenized(syntax *const sx);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -24,6 +24,7 @@ reporter reporter_create(const workspace *const ws)
 	rprt.is_recovery_disabled = ws_has_flag(ws, "-Wno");
 	rprt.errors = 0;
 	rprt.warnings = 0;
+	rprt.log = ws_get_log_context(ws);
 
 	return rprt;
 }
@@ -43,7 +44,12 @@ void report_error(reporter *const rprt, universal_io *const io, const location l
 	const size_t prev_loc = in_get_position(io);
 	in_set_position(io, loc.begin);
 
+	const struct logger_context *const prev_log = rprt->log != NULL ? set_errors_context(rprt->log) : NULL;
 	verror(io, num, args);
+	if (rprt->log != NULL)
+	{
+		set_errors_context(prev_log);
+	}
 	rprt->errors++;
 
 	in_set_position(io, prev_loc);
@@ -59,7 +65,12 @@ void report_warning(reporter *const rprt, universal_io *const io, const location
 	const size_t prev_loc = in_get_position(io);
 	in_set_position(io, loc.begin);
 
+	const struct logger_context *const prev_log = rprt->log != NULL ? set_errors_context(rprt->log) : NULL;
 	vwarning(io, num, args);
+	if (rprt->log != NULL)
+	{
+		set_errors_context(prev_log);
+	}
 	rprt->warnings++;
 
 	in_set_position(io, prev_loc);
@@ -31,6 +31,8 @@ typedef struct reporter
 	size_t errors;							/**< Number of reported errors */
 	size_t warnings;						/**< Number of reported warnings */
 
+	const struct logger_context *log;		/**< Logging context of compilation */
+
 	bool is_recovery_disabled;				/**< Set, if error recovery & multiple output disabled */
 } reporter;
 
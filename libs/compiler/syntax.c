@@ -20,12 +20,20 @@
 #include "token.h"
 #include "tree.h"
 
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
 
 static const size_t REPRESENTATIONS_SIZE = 10000;
 static const size_t IDENTIFIERS_SIZE = 10000;
 static const size_t FUNCTIONS_SIZE = 100;
 static const size_t STRINGS_SIZE = 80;
 static const size_t TYPES_SIZE = 1000;
+static const size_t TYPES_INDEX_SIZE = 256;
+static const size_t LAYOUTS_SIZE = 1000;
 static const size_t TREE_SIZE = 10000;
 
 
@@ -52,6 +60,8 @@ static void repr_add_keyword(map *const reprtab, const char32_t *const eng, cons
 
 static inline void repr_init(map *const reprtab)
 {
+	// Ключевые слова распознаются по таблице в token.c, но остаются в таблице представлений,
+	// чтобы номера представлений идентификаторов в выходных файлах не менялись
 	repr_add_keyword(reprtab, U"#line", U"#строка", TK_LINE);
 
 	repr_add_keyword(reprtab, U"main", U"главная", TK_MAIN);
@@ -86,37 +96,6 @@ static inline void repr_init(map *const reprtab)
 }
 
 
-static inline void type_init(syntax *const sx)
-{
-	vector_increase(&sx->types, 1);
-	// занесение в types описателя struct {int numTh; int inf; }
-	sx->start_type = vector_add(&sx->types, 0);
-	vector_add(&sx->types, TYPE_STRUCTURE);
-	vector_add(&sx->types, 2);
-	vector_add(&sx->types, 4);
-	vector_add(&sx->types, TYPE_INTEGER);
-	vector_add(&sx->types, (item_t)map_reserve(&sx->representations, "numTh"));
-	vector_add(&sx->types, TYPE_INTEGER);
-	vector_add(&sx->types, (item_t)map_reserve(&sx->representations, "data"));
-}
-
-static inline item_t get_static(syntax *const sx, const item_t type)
-{
-	const item_t old_displ = sx->displ;
-	sx->displ += sx->lg * (item_t)type_size(sx, type);
-
-	if (sx->lg > 0)
-	{
-		sx->max_displ = sx->displ > sx->max_displ ? sx->displ : sx->max_displ;
-	}
-	else
-	{
-		sx->max_displg = -sx->displ;
-	}
-
-	return old_displ;
-}
-
 /**	Check if types are equal */
 static inline bool type_is_equal(const syntax *const sx, const size_t first, const size_t second)
 {
@@ -150,6 +129,240 @@ static inline bool type_is_equal(const syntax *const sx, const size_t first, con
 	return true;
 }
 
+/**	Количество сравниваемых полей записи после кода типа */
+static inline size_t type_record_length(const syntax *const sx, const size_t type)
+{
+	const item_t code = vector_get(&sx->types, type);
+	return code == TYPE_STRUCTURE || code == TYPE_FUNCTION ? 2 + (size_t)vector_get(&sx->types, type + 2) : 1;
+}
+
+/**	Структурный хеш записи, совпадающие по type_is_equal записи имеют равный хеш */
+static size_t type_hash(const syntax *const sx, const size_t type)
+{
+	const size_t length = type_record_length(sx, type);
+	uint64_t hash = 0xCBF29CE484222325u;
+	for (size_t i = 0; i <= length; i++)
+	{
+		hash = (hash ^ (uint64_t)vector_get(&sx->types, type + i)) * 0x100000001B3u;
+	}
+
+	return (size_t)(hash ^ (hash >> 32));
+}
+
+/**	Поиск слота индекса с равной записью или пустого слота */
+static size_t type_index_find(const syntax *const sx, const size_t type)
+{
+	const size_t mask = vector_size(&sx->types_index) - 1;
+	size_t slot = type_hash(sx, type) & mask;
+	for (item_t old = vector_get(&sx->types_index, slot); old != 0; old = vector_get(&sx->types_index, slot))
+	{
+		if (type_is_equal(sx, type, (size_t)old))
+		{
+			break;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
+}
+
+static void type_index_add(syntax *const sx, const size_t type)
+{
+	if (4 * (sx->types_indexed + 1) > 3 * vector_size(&sx->types_index))
+	{
+		// Индекс перестраивается в таблице вдвое большего размера
+		const size_t size = vector_size(&sx->types_index);
+		vector old = sx->types_index;
+
+		sx->types_index = vector_create(2 * size);
+		vector_increase(&sx->types_index, 2 * size);
+		for (size_t i = 0; i < size; i++)
+		{
+			const item_t record = vector_get(&old, i);
+			if (record != 0)
+			{
+				vector_set(&sx->types_index, type_index_find(sx, (size_t)record), record);
+			}
+		}
+
+		vector_clear(&old);
+	}
+
+	vector_set(&sx->types_index, type_index_find(sx, type), (item_t)type);
+	sx->types_indexed++;
+}
+
+/*
+ *	Раскладка типа хранится в таблице layouts как
+ *	размер, размер в словах, количество измерений, тип элемента, [смещение поля, смещение поля в словах]...
+ *	Раскладка вычисляется один раз при добавлении типа в таблицу типов.
+ *	Раскладка структуры завершается ссылкой на таблицу имён полей, которая строится при первом поиске поля.
+ */
+
+static inline size_t type_layout(const syntax *const sx, const item_t type)
+{
+	const item_t ref = type > 0 ? vector_get(&sx->layouts_index, (size_t)type) : 0;
+	return ref != 0 && ref != ITEM_MAX ? (size_t)ref - 1 : SIZE_MAX;
+}
+
+static void type_layout_add(syntax *const sx, const item_t type)
+{
+	const size_t layout = vector_size(&sx->layouts);
+	const item_t code = vector_get(&sx->types, (size_t)type);
+
+	if (code == TYPE_CONST)
+	{
+		const item_t unqualified = vector_get(&sx->types, (size_t)type + 1);
+		const size_t base = type_layout(sx, unqualified);
+		if (base == SIZE_MAX)
+		{
+			vector_add(&sx->layouts, unqualified == TYPE_FLOATING ? 2 : 1);
+			vector_add(&sx->layouts, 1);
+			vector_add(&sx->layouts, 0);
+			vector_add(&sx->layouts, type);
+		}
+		else
+		{
+			const size_t members = type_is_structure(sx, unqualified) ? type_structure_get_member_amount(sx, unqualified) : 0;
+			for (size_t i = 0; i < 4 + 2 * members; i++)
+			{
+				vector_add(&sx->layouts, vector_get(&sx->layouts, base + i));
+			}
+
+			if (vector_get(&sx->layouts, layout + 2) == 0)
+			{
+				vector_set(&sx->layouts, layout + 3, type);
+			}
+		}
+	}
+	else if (code == TYPE_STRUCTURE)
+	{
+		vector_add(&sx->layouts, vector_get(&sx->types, (size_t)type + 1));
+		vector_add(&sx->layouts, 0);
+		vector_add(&sx->layouts, 0);
+		vector_add(&sx->layouts, type);
+
+		size_t words = 0;
+		size_t displ = 0;
+		const size_t members = (size_t)vector_get(&sx->types, (size_t)type + 2) / 2;
+		for (size_t i = 0; i < members; i++)
+		{
+			const item_t member_type = vector_get(&sx->types, (size_t)type + 3 + 2 * i);
+			vector_add(&sx->layouts, (item_t)displ);
+			vector_add(&sx->layouts, (item_t)words);
+
+			displ += type_size(sx, member_type);
+			words += type_word_size(sx, member_type);
+		}
+
+		vector_set(&sx->layouts, layout + 1, (item_t)words);
+		vector_add(&sx->layouts, 0);
+	}
+	else if (code == TYPE_ARRAY)
+	{
+		const item_t element_type = vector_get(&sx->types, (size_t)type + 1);
+		vector_add(&sx->layouts, 1);
+		vector_add(&sx->layouts, 1);
+		vector_add(&sx->layouts, (item_t)type_array_get_dimensions(sx, element_type) + 1);
+		vector_add(&sx->layouts, type_array_get_base_type(sx, element_type));
+	}
+	else
+	{
+		vector_add(&sx->layouts, 1);
+		vector_add(&sx->layouts, 1);
+		vector_add(&sx->layouts, 0);
+		vector_add(&sx->layouts, type);
+	}
+
+	if (vector_size(&sx->layouts_index) <= (size_t)type)
+	{
+		vector_increase(&sx->layouts_index, (size_t)type + 1 - vector_size(&sx->layouts_index));
+	}
+
+	vector_set(&sx->layouts_index, (size_t)type, (item_t)layout + 1);
+}
+
+static inline size_t member_hash(const size_t name)
+{
+	return (size_t)(((uint64_t)name * 0x9E3779B97F4A7C15u) >> 32);
+}
+
+/**	Таблица имён полей с открытой адресацией, в слотах хранятся номера полей, увеличенные на единицу */
+static size_t type_member_table(syntax *const sx, const item_t type, const size_t members)
+{
+	const size_t ref = type_layout(sx, type) + 4 + 2 * members;
+	const item_t table = vector_get(&sx->layouts, ref);
+	if (table != 0)
+	{
+		return (size_t)table;
+	}
+
+	size_t size = 1;
+	while (size < 2 * members)
+	{
+		size *= 2;
+	}
+
+	const size_t start = vector_size(&sx->layouts);
+	vector_add(&sx->layouts, (item_t)size);
+	vector_increase(&sx->layouts, size);
+
+	for (size_t i = 0; i < members; i++)
+	{
+		size_t slot = member_hash(type_structure_get_member_name(sx, type, i)) & (size - 1);
+		while (vector_get(&sx->layouts, start + 1 + slot) != 0)
+		{
+			slot = (slot + 1) & (size - 1);
+		}
+
+		vector_set(&sx->layouts, start + 1 + slot, (item_t)i + 1);
+	}
+
+	vector_set(&sx->layouts, ref, (item_t)start);
+	return start;
+}
+
+static inline void type_init(syntax *const sx)
+{
+	vector_increase(&sx->types, 1);
+	// занесение в types описателя struct {int numTh; int inf; }
+	sx->start_type = vector_add(&sx->types, 0);
+	vector_add(&sx->types, TYPE_STRUCTURE);
+	vector_add(&sx->types, 2);
+	vector_add(&sx->types, 4);
+	vector_add(&sx->types, TYPE_INTEGER);
+	vector_add(&sx->types, (item_t)map_reserve(&sx->representations, "numTh"));
+	vector_add(&sx->types, TYPE_INTEGER);
+	vector_add(&sx->types, (item_t)map_reserve(&sx->representations, "data"));
+
+	sx->types_index = vector_create(TYPES_INDEX_SIZE);
+	vector_increase(&sx->types_index, TYPES_INDEX_SIZE);
+	sx->types_indexed = 0;
+	type_index_add(sx, sx->start_type + 1);
+
+	sx->layouts = vector_create(LAYOUTS_SIZE);
+	sx->layouts_index = vector_create(TYPES_SIZE);
+	type_layout_add(sx, (item_t)sx->start_type + 1);
+}
+
+static inline item_t get_static(syntax *const sx, const item_t type)
+{
+	const item_t old_displ = sx->displ;
+	sx->displ += sx->lg * (item_t)type_size(sx, type);
+
+	if (sx->lg > 0)
+	{
+		sx->max_displ = sx->displ > sx->max_displ ? sx->displ : sx->max_displ;
+	}
+	else
+	{
+		sx->max_displg = -sx->displ;
+	}
+
+	return old_displ;
+}
+
 static void builtin_add(syntax *const sx, const char32_t *const eng, const char32_t *const rus, const item_t type)
 {
 	// Добавляем одно из написаний в таблицу representations
@@ -238,6 +451,62 @@ static item_t type_get(const syntax *const sx, const size_t index)
 }
 
 
+/**	Образ таблиц со встроенными идентификаторами и типами, строится один раз */
+static syntax builtins;
+
+#ifdef _WIN32
+	static INIT_ONCE builtins_once = INIT_ONCE_STATIC_INIT;
+#else
+	static pthread_once_t builtins_once = PTHREAD_ONCE_INIT;
+#endif
+
+static void builtins_init(void)
+{
+	builtins.io = NULL;
+
+	builtins.predef = vector_create(FUNCTIONS_SIZE);
+	builtins.predef_index = hash_create(FUNCTIONS_SIZE);
+	builtins.predef_pending = 0;
+	builtins.functions = vector_create(FUNCTIONS_SIZE);
+	vector_increase(&builtins.functions, 2);
+
+	builtins.identifiers = vector_create(IDENTIFIERS_SIZE);
+	vector_increase(&builtins.identifiers, 2);
+	builtins.cur_id = 2;
+
+	builtins.representations = map_create(REPRESENTATIONS_SIZE);
+	repr_init(&builtins.representations);
+
+	builtins.types = vector_create(TYPES_SIZE);
+	type_init(&builtins);
+
+	ident_init(&builtins);
+
+	builtins.max_displg = 3;
+	builtins.ref_main = 0;
+
+	builtins.max_displ = 3;
+	builtins.displ = -3;
+	builtins.lg = -1;
+
+	// Предописаний среди встроенных функций нет
+	vector_clear(&builtins.predef);
+	hash_clear(&builtins.predef_index);
+}
+
+#ifdef _WIN32
+static BOOL CALLBACK builtins_init_once(PINIT_ONCE once, PVOID parameter, PVOID *context)
+{
+	(void)once;
+	(void)parameter;
+	(void)context;
+
+	builtins_init();
+	return TRUE;
+}
+#endif
+
+
 /*
  *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
  *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
@@ -249,35 +518,31 @@ static item_t type_get(const syntax *const sx, const size_t index)
 
 syntax sx_create(const workspace *const ws, universal_io *const io)
 {
-	syntax sx;
+#ifdef _WIN32
+	InitOnceExecuteOnce(&builtins_once, &builtins_init_once, NULL, NULL);
+#else
+	pthread_once(&builtins_once, &builtins_init);
+#endif
+
+	// Встроенные идентификаторы и типы копируются из готового образа
+	syntax sx = builtins;
 	sx.io = io;
 
 	sx.string_literals = strings_create(STRINGS_SIZE);
 
 	sx.predef = vector_create(FUNCTIONS_SIZE);
-	sx.functions = vector_create(FUNCTIONS_SIZE);
-	vector_increase(&sx.functions, 2);
+	sx.predef_index = hash_create(FUNCTIONS_SIZE);
+	sx.functions = vector_copy(&builtins.functions);
 
-	sx.tree = vector_create(TREE_SIZE);
+	sx.tree = tree_create(TREE_SIZE);
 
-	sx.identifiers = vector_create(IDENTIFIERS_SIZE);
-	vector_increase(&sx.identifiers, 2);
-	sx.cur_id = 2;
+	sx.identifiers = vector_copy(&builtins.identifiers);
+	sx.representations = map_copy(&builtins.representations);
 
-	sx.representations = map_create(REPRESENTATIONS_SIZE);
-	repr_init(&sx.representations);
-
-	sx.types = vector_create(TYPES_SIZE);
-	type_init(&sx);
-
-	ident_init(&sx);
-
-	sx.max_displg = 3;
-	sx.ref_main = 0;
-
-	sx.max_displ = 3;
-	sx.displ = -3;
-	sx.lg = -1;
+	sx.types = vector_copy(&builtins.types);
+	sx.types_index = vector_copy(&builtins.types_index);
+	sx.layouts = vector_copy(&builtins.layouts);
+	sx.layouts_index = vector_copy(&builtins.layouts_index);
 
 	sx.rprt = reporter_create(ws);
 
@@ -298,11 +563,12 @@ bool sx_is_correct(syntax *const sx)
 		was_error = true;
 	}
 
-	for (size_t i = 0; i < vector_size(&sx->predef); i++)
+	for (size_t i = 0; sx->predef_pending != 0 && i < vector_size(&sx->predef); i++)
 	{
-		if (vector_get(&sx->predef, i))
+		const size_t repr = (size_t)vector_get(&sx->predef, i);
+		if (i >= (size_t)hash_get(&sx->predef_index, (item_t)repr, 0))
 		{
-			system_error(predef_but_notdef, repr_get_name(sx, (size_t)vector_get(&sx->predef, i)));
+			system_error(predef_but_notdef, repr_get_name(sx, repr));
 			was_error = true;
 		}
 	}
@@ -320,12 +586,16 @@ int sx_clear(syntax *const sx)
 	strings_clear(&sx->string_literals);
 
 	vector_clear(&sx->predef);
+	hash_clear(&sx->predef_index);
 	vector_clear(&sx->functions);
 
-	vector_clear(&sx->tree);
+	tree_clear(&sx->tree);
 
 	vector_clear(&sx->identifiers);
 	vector_clear(&sx->types);
+	vector_clear(&sx->types_index);
+	vector_clear(&sx->layouts);
+	vector_clear(&sx->layouts_index);
 	map_clear(&sx->representations);
 
 	return 0;
@@ -444,16 +714,26 @@ size_t ident_add(syntax *const sx, const size_t repr, const item_t kind, const i
 			// Это предописание функции
 			ident_set_repr(sx, last_id, -ident_get_repr(sx, last_id));
 			vector_add(&sx->predef, (item_t)repr);
+
+			// Для представления хранятся начало неразрешённых предописаний в predef и их количество
+			size_t index = hash_get_index(&sx->predef_index, (item_t)repr);
+			if (index == SIZE_MAX)
+			{
+				index = hash_add(&sx->predef_index, (item_t)repr, 2);
+			}
+
+			hash_set_by_index(&sx->predef_index, index, 1, hash_get_by_index(&sx->predef_index, index, 1) + 1);
+			sx->predef_pending++;
 		}
 		else
 		{
-			// Это описание функции
-			for (size_t i = 0; i < vector_size(&sx->predef); i++)
+			// Это описание функции, все предыдущие предописания разрешены
+			const size_t index = hash_get_index(&sx->predef_index, (item_t)repr);
+			if (index != SIZE_MAX)
 			{
-				if ((size_t)vector_get(&sx->predef, i) == repr)
-				{
-					vector_set(&sx->predef, i, 0);
-				}
+				sx->predef_pending -= (size_t)hash_get_by_index(&sx->predef_index, index, 1);
+				hash_set_by_index(&sx->predef_index, index, 0, (item_t)vector_size(&sx->predef));
+				hash_set_by_index(&sx->predef_index, index, 1, 0);
 			}
 		}
 	}
@@ -524,24 +804,26 @@ item_t type_add(syntax *const sx, const item_t *const record, const size_t size)
 		vector_add(&sx->types, record[i]);
 	}
 
+	// Перечисления не совпадают с ранее добавленными, так как их поля заносятся позже
+	const size_t type = sx->start_type + 1;
+	if (record[0] == TYPE_ENUM)
+	{
+		type_layout_add(sx, (item_t)type);
+		return (item_t)type;
+	}
+
 	// Checking mode duplicates
-	size_t old = (size_t)vector_get(&sx->types, sx->start_type);
-	while (old)
+	const item_t old = vector_get(&sx->types_index, type_index_find(sx, type));
+	if (old != 0)
 	{
-		if (type_is_equal(sx, sx->start_type + 1, old + 1))
-		{
-			const size_t start_type = sx->start_type;
-			sx->start_type = (size_t)vector_get(&sx->types, sx->start_type);
-			vector_resize(&sx->types, start_type);
-			return (item_t)old + 1;
-		}
-		else
-		{
-			old = (size_t)vector_get(&sx->types, old);
-		}
+		sx->start_type = (size_t)vector_get(&sx->types, sx->start_type);
+		vector_resize(&sx->types, type - 1);
+		return old;
 	}
 
-	return (item_t)sx->start_type + 1;
+	type_index_add(sx, type);
+	type_layout_add(sx, (item_t)type);
+	return (item_t)type;
 }
 
 item_t type_enum_add_fields(syntax *const sx, const item_t *const record, const size_t size)
@@ -566,22 +848,19 @@ type_t type_get_class(const syntax *const sx, const item_t type)
 
 size_t type_size(const syntax *const sx, const item_t type)
 {
-	if (type_is_const(sx, type))
-	{
-		return type_size(sx, type_const_get_unqualified_type(sx, type));
-	}
-	else if (type_is_structure(sx, type))
+	const size_t layout = type_layout(sx, type);
+	if (layout != SIZE_MAX)
 	{
-		return (size_t)type_get(sx, (size_t)type + 1);
-	}
-	else if (type_is_floating(sx, type))
-	{
-		return 2;
-	}
-	else
-	{
-		return 1;
+		return (size_t)vector_get(&sx->layouts, layout);
 	}
+
+	return type == TYPE_FLOATING ? 2 : 1;
+}
+
+size_t type_word_size(const syntax *const sx, const item_t type)
+{
+	const size_t layout = type_layout(sx, type);
+	return layout != SIZE_MAX ? (size_t)vector_get(&sx->layouts, layout + 1) : 1;
 }
 
 bool type_requires_initialization(const syntax *const sx, const item_t type)
@@ -717,6 +996,18 @@ item_t type_array_get_element_type(const syntax *const sx, const item_t type)
 								   : type_is_array(sx, type) ? type_get(sx, (size_t)type + 1) : ITEM_MAX;
 }
 
+size_t type_array_get_dimensions(const syntax *const sx, const item_t type)
+{
+	const size_t layout = type_layout(sx, type);
+	return layout != SIZE_MAX ? (size_t)vector_get(&sx->layouts, layout + 2) : 0;
+}
+
+item_t type_array_get_base_type(const syntax *const sx, const item_t type)
+{
+	const size_t layout = type_layout(sx, type);
+	return layout != SIZE_MAX ? vector_get(&sx->layouts, layout + 3) : type;
+}
+
 
 item_t type_structure(syntax *const sx, vector *const types, vector *const names)
 {
@@ -759,6 +1050,51 @@ item_t type_structure_get_member_type(const syntax *const sx, const item_t type,
 		: type_is_structure(sx, type) ? type_get(sx, (size_t)type + 3 + 2 * index) : ITEM_MAX;
 }
 
+size_t type_structure_get_member_index(syntax *const sx, const item_t type, const size_t name)
+{
+	if (type_is_const(sx, type))
+	{
+		return type_structure_get_member_index(sx, type_const_get_unqualified_type(sx, type), name);
+	}
+
+	if (!type_is_structure(sx, type))
+	{
+		return SIZE_MAX;
+	}
+
+	const size_t members = type_structure_get_member_amount(sx, type);
+	const size_t table = type_member_table(sx, type, members);
+	const size_t size = (size_t)vector_get(&sx->layouts, table);
+
+	for (size_t slot = member_hash(name) & (size - 1); ; slot = (slot + 1) & (size - 1))
+	{
+		const item_t member = vector_get(&sx->layouts, table + 1 + slot);
+		if (member == 0)
+		{
+			return SIZE_MAX;
+		}
+
+		if (type_structure_get_member_name(sx, type, (size_t)member - 1) == name)
+		{
+			return (size_t)member - 1;
+		}
+	}
+}
+
+size_t type_structure_get_member_displ(const syntax *const sx, const item_t type, const size_t index)
+{
+	return type_is_structure(sx, type) && index < type_structure_get_member_amount(sx, type)
+		? (size_t)vector_get(&sx->layouts, type_layout(sx, type) + 4 + 2 * index)
+		: SIZE_MAX;
+}
+
+size_t type_structure_get_member_word_displ(const syntax *const sx, const item_t type, const size_t index)
+{
+	return type_is_structure(sx, type) && index < type_structure_get_member_amount(sx, type)
+		? (size_t)vector_get(&sx->layouts, type_layout(sx, type) + 5 + 2 * index)
+		: SIZE_MAX;
+}
+
 
 item_t type_function_get_return_type(const syntax *const sx, const item_t type)
 {
@@ -891,9 +1227,16 @@ bool type_is_undefined(const item_t type)
 }
 
 
-size_t repr_reserve(syntax *const sx, char32_t *const last)
+token_t repr_read(syntax *const sx, char32_t *const last)
+{
+	size_t size = 0;
+	const char *const spelling = map_read_by_io(&sx->representations, sx->io, last, &size);
+	return spelling != NULL ? token_get_keyword_kind(spelling, size) : TK_IDENTIFIER;
+}
+
+size_t repr_reserve(syntax *const sx)
 {
-	return map_reserve_by_io(&sx->representations, sx->io, last);
+	return map_reserve_last_read(&sx->representations);
 }
 
 const char *repr_get_name(const syntax *const sx, const size_t index)
@@ -20,9 +20,11 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include "hash.h"
 #include "map.h"
 #include "reporter.h"
 #include "strings.h"
+#include "token.h"
 #include "tree.h"
 #include "vector.h"
 
@@ -68,15 +70,21 @@ typedef struct syntax
 	strings string_literals;	/**< String literals list */
 
 	vector predef;				/**< Predefined functions table */
+	hash predef_index;			/**< Pending predefinitions by representation */
+	size_t predef_pending;		/**< Number of pending predefinitions */
 	vector functions;			/**< Functions table */
 
-	vector tree;				/**< Tree table */
+	tree_table tree;			/**< Tree table */
 
 	vector identifiers;			/**< Identifiers table */
 	size_t cur_id;				/**< Start of current scope in identifiers table */
 
 	vector types;				/**< Types table */
 	size_t start_type;			/**< Start of last record in types table */
+	vector types_index;			/**< Hash index of types table records */
+	size_t types_indexed;		/**< Number of records in hash index */
+	vector layouts;				/**< Layouts of types table records */
+	vector layouts_index;		/**< Layout references by type */
 
 	map representations;		/**< Representations table */
 
@@ -375,6 +383,16 @@ type_t type_get_class(const syntax *const sx, const item_t type);
  */
 size_t type_size(const syntax *const sx, const item_t type);
 
+/**
+ *	Get type size in machine words, every scalar and array takes one word
+ *
+ *	@param	sx			Syntax structure
+ *	@param	type		Standard type or index of the types table
+ *
+ *	@return	Type size in words
+ */
+size_t type_word_size(const syntax *const sx, const item_t type);
+
 /**
  *	Check if variable of type requires initialization
  *
@@ -591,6 +609,26 @@ item_t type_const_get_unqualified_type(const syntax *const sx, const item_t type
  */
 item_t type_array_get_element_type(const syntax *const sx, const item_t type);
 
+/**
+ *	Get amount of array dimensions
+ *
+ *	@param	sx			Syntax structure
+ *	@param	type		Type
+ *
+ *	@return	Amount of dimensions, @c 0 for non-array type
+ */
+size_t type_array_get_dimensions(const syntax *const sx, const item_t type);
+
+/**
+ *	Get element type of the innermost dimension
+ *
+ *	@param	sx			Syntax structure
+ *	@param	type		Type
+ *
+ *	@return	Base element type, the same type for non-array type
+ */
+item_t type_array_get_base_type(const syntax *const sx, const item_t type);
+
 /**
  *	Create structure type
  *
@@ -634,6 +672,39 @@ size_t type_structure_get_member_name(const syntax *const sx, const item_t type,
  */
 item_t type_structure_get_member_type(const syntax *const sx, const item_t type, const size_t index);
 
+/**
+ *	Get member index by name
+ *
+ *	@param	sx			Syntax structure
+ *	@param	type		Structure type
+ *	@param	name		Member name
+ *
+ *	@return	Member number, @c SIZE_MAX on failure
+ */
+size_t type_structure_get_member_index(syntax *const sx, const item_t type, const size_t name);
+
+/**
+ *	Get member displacement by index
+ *
+ *	@param	sx			Syntax structure
+ *	@param	type		Structure type
+ *	@param	index		Member number
+ *
+ *	@return	Sum of sizes of previous members, @c SIZE_MAX on failure
+ */
+size_t type_structure_get_member_displ(const syntax *const sx, const item_t type, const size_t index);
+
+/**
+ *	Get member displacement in machine words by index
+ *
+ *	@param	sx			Syntax structure
+ *	@param	type		Structure type
+ *	@param	index		Member number
+ *
+ *	@return	Sum of word sizes of previous members, @c SIZE_MAX on failure
+ */
+size_t type_structure_get_member_word_displ(const syntax *const sx, const item_t type, const size_t index);
+
 /**
  *	Get return type
  *
@@ -737,14 +808,23 @@ item_t type_const(syntax *const sx, const item_t type);
 
 
 /**
- *	Add a new record from io to representations table or return existing
+ *	Read identifier or keyword from io
  *
  *	@param	sx			Syntax structure
  *	@param	last		Next character after key
  *
+ *	@return	Keyword token kind, @c TK_IDENTIFIER if read spelling is not a keyword
+ */
+token_t repr_read(syntax *const sx, char32_t *const last);
+
+/**
+ *	Add the last read identifier to representations table or return existing
+ *
+ *	@param	sx			Syntax structure
+ *
  *	@return	Index of record, @c SIZE_MAX on failure
  */
-size_t repr_reserve(syntax *const sx, char32_t *const last);
+size_t repr_reserve(syntax *const sx);
 
 /**
  *	Get identifier name from representations table
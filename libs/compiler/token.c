@@ -15,6 +15,146 @@
  */
 
 #include "token.h"
+#include <string.h>
+
+
+/* Generated by scripts/keywords.py, do not edit */
+
+#define KEYWORD_TABLE_SIZE 256
+#define KEYWORD_BUCKETS_SIZE 64
+#define KEYWORD_MAX_SIZE 24
+
+
+static const uint8_t keyword_displacements[KEYWORD_BUCKETS_SIZE] =
+{
+	0, 0, 0, 0, 0, 2, 1, 1, 4, 0, 0, 1, 0, 0, 0, 0,
+	3, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 2, 0, 0, 3, 0,
+	0, 2, 0, 0, 1, 0, 2, 1, 1, 1, 0, 2, 0, 0, 0, 0,
+	1, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+};
+
+static const struct { const char *spelling; token_t kind; } keyword_table[KEYWORD_TABLE_SIZE] =
+{
+	[0] = { "ИНАЧЕ", TK_ELSE },
+	[1] = { "if", TK_IF },
+	[2] = { "abs", TK_ABS },
+	[3] = { "char", TK_CHAR },
+	[4] = { "SWITCH", TK_SWITCH },
+	[5] = { "#строка", TK_LINE },
+	[6] = { "#СТРОКА", TK_LINE },
+	[8] = { "литера", TK_CHAR },
+	[9] = { "TRUE", TK_TRUE },
+	[12] = { "ВЫБОР", TK_SWITCH },
+	[14] = { "вещ", TK_FLOAT },
+	[17] = { "true", TK_TRUE },
+	[18] = { "ELSE", TK_ELSE },
+	[19] = { "LONG", TK_LONG },
+	[20] = { "СЛУЧАЙ", TK_CASE },
+	[30] = { "ДЛЯ", TK_FOR },
+	[33] = { "конст", TK_CONST },
+	[34] = { "INT", TK_INT },
+	[36] = { "выбор", TK_SWITCH },
+	[40] = { "while", TK_WHILE },
+	[45] = { "цел", TK_INT },
+	[46] = { "цикл", TK_DO },
+	[48] = { "ИСТИНА", TK_TRUE },
+	[54] = { "else", TK_ELSE },
+	[55] = { "float", TK_FLOAT },
+	[56] = { "case", TK_CASE },
+	[57] = { "ВОЗВРАТ", TK_RETURN },
+	[60] = { "АБС", TK_ABS },
+	[61] = { "ЕСЛИ", TK_IF },
+	[68] = { "ПЕРЕЧИСЛЕНИЕ", TK_ENUM },
+	[69] = { "ДВОЙНОЙ", TK_DOUBLE },
+	[74] = { "upb", TK_UPB },
+	[75] = { "double", TK_DOUBLE },
+	[76] = { "кол_во", TK_UPB },
+	[80] = { "пока", TK_WHILE },
+	[82] = { "иначе", TK_ELSE },
+	[85] = { "CONTINUE", TK_CONTINUE },
+	[87] = { "file", TK_FILE },
+	[91] = { "абс", TK_ABS },
+	[93] = { "ЛИТЕРА", TK_CHAR },
+	[94] = { "случай", TK_CASE },
+	[95] = { "switch", TK_SWITCH },
+	[99] = { "КОНСТ", TK_CONST },
+	[100] = { "ложь", TK_FALSE },
+	[102] = { "CHAR", TK_CHAR },
+	[105] = { "БУЛЕВО", TK_BOOL },
+	[106] = { "структура", TK_STRUCT },
+	[108] = { "файл", TK_FILE },
+	[109] = { "CASE", TK_CASE },
+	[110] = { "булево", TK_BOOL },
+	[113] = { "ПУСТО", TK_VOID },
+	[114] = { "void", TK_VOID },
+	[115] = { "CONST", TK_CONST },
+	[117] = { "NULL", TK_NULL },
+	[120] = { "FALSE", TK_FALSE },
+	[121] = { "ничто", TK_NULL },
+	[122] = { "#line", TK_LINE },
+	[123] = { "ЦИКЛ", TK_DO },
+	[125] = { "IF", TK_IF },
+	[126] = { "continue", TK_CONTINUE },
+	[127] = { "перечисление", TK_ENUM },
+	[129] = { "break", TK_BREAK },
+	[132] = { "ЛОЖЬ", TK_FALSE },
+	[134] = { "DO", TK_DO },
+	[141] = { "ENUM", TK_ENUM },
+	[144] = { "ПОКА", TK_WHILE },
+	[148] = { "ВЫХОД", TK_BREAK },
+	[149] = { "bool", TK_BOOL },
+	[150] = { "return", TK_RETURN },
+	[151] = { "FOR", TK_FOR },
+	[152] = { "длин", TK_LONG },
+	[153] = { "false", TK_FALSE },
+	[154] = { "ДЛИН", TK_LONG },
+	[155] = { "int", TK_INT },
+	[156] = { "КОЛ_ВО", TK_UPB },
+	[167] = { "ЦЕЛ", TK_INT },
+	[168] = { "BOOL", TK_BOOL },
+	[171] = { "UPB", TK_UPB },
+	[175] = { "для", TK_FOR },
+	[176] = { "enum", TK_ENUM },
+	[177] = { "WHILE", TK_WHILE },
+	[183] = { "выход", TK_BREAK },
+	[184] = { "двойной", TK_DOUBLE },
+	[186] = { "FILE", TK_FILE },
+	[188] = { "null", TK_NULL },
+	[190] = { "struct", TK_STRUCT },
+	[192] = { "ВЕЩ", TK_FLOAT },
+	[194] = { "RETURN", TK_RETURN },
+	[196] = { "если", TK_IF },
+	[198] = { "ПРОДОЛЖИТЬ", TK_CONTINUE },
+	[199] = { "умолчание", TK_DEFAULT },
+	[201] = { "ФАЙЛ", TK_FILE },
+	[202] = { "СТРУКТУРА", TK_STRUCT },
+	[204] = { "STRUCT", TK_STRUCT },
+	[207] = { "FLOAT", TK_FLOAT },
+	[208] = { "BREAK", TK_BREAK },
+	[209] = { "const", TK_CONST },
+	[210] = { "DEFAULT", TK_DEFAULT },
+	[211] = { "продолжить", TK_CONTINUE },
+	[212] = { "пусто", TK_VOID },
+	[213] = { "VOID", TK_VOID },
+	[216] = { "do", TK_DO },
+	[218] = { "ABS", TK_ABS },
+	[221] = { "#LINE", TK_LINE },
+	[222] = { "типопр", TK_TYPEDEF },
+	[223] = { "long", TK_LONG },
+	[228] = { "УМОЛЧАНИЕ", TK_DEFAULT },
+	[230] = { "TYPEDEF", TK_TYPEDEF },
+	[232] = { "DOUBLE", TK_DOUBLE },
+	[235] = { "возврат", TK_RETURN },
+	[240] = { "for", TK_FOR },
+	[244] = { "default", TK_DEFAULT },
+	[246] = { "НИЧТО", TK_NULL },
+	[248] = { "истина", TK_TRUE },
+	[254] = { "ТИПОПР", TK_TYPEDEF },
+	[255] = { "typedef", TK_TYPEDEF },
+};
+
+/* End of generated code */
+
 
 
 /*
@@ -121,3 +261,25 @@ token token_punctuator(const location loc, const token_t kind)
 {
 	return (token){ .loc = loc, .kind = kind };
 }
+
+
+token_t token_get_keyword_kind(const char *const spelling, const size_t size)
+{
+	if (size > KEYWORD_MAX_SIZE)
+	{
+		return TK_IDENTIFIER;
+	}
+
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash = (hash ^ (uint8_t)spelling[i]) * 16777619u;
+	}
+
+	const size_t slot = ((hash >> 8) + keyword_displacements[hash % KEYWORD_BUCKETS_SIZE] * ((hash >> 20) | 1))
+		% KEYWORD_TABLE_SIZE;
+	const char *const keyword = keyword_table[slot].spelling;
+	return keyword != NULL && strncmp(keyword, spelling, size) == 0 && keyword[size] == '\0'
+		? keyword_table[slot].kind
+		: TK_IDENTIFIER;
+}
@@ -126,19 +126,22 @@ typedef struct location
 	size_t end;
 } location;
 
+/** Token value */
+typedef union token_data
+{
+	size_t ident_repr;				/**< Index of representation in representation table */
+	char32_t char_value;			/**< Value of character literal */
+	uint64_t int_value;				/**< Value of integer literal */
+	double float_value;				/**< Value of floating literal */
+	size_t string_num;				/**< Index of string literal in strings vector */
+} token_data;
+
 /** Token representation */
 typedef struct token
 {
 	location loc;					/**< Source location */
 	token_t kind;					/**< Token kind */
-	union
-	{
-		size_t ident_repr;			/**< Index of representation in representation table */
-		char32_t char_value;		/**< Value of character literal */
-		uint64_t int_value;			/**< Value of integer literal */
-		double float_value;			/**< Value of floating literal */
-		size_t string_num;			/**< Index of string literal in strings vector */
-	} data;
+	token_data data;				/**< Token value */
 } token;
 
 
@@ -294,6 +297,16 @@ token token_keyword(const location loc, const token_t kind);
  */
 token token_punctuator(const location loc, const token_t kind);
 
+/**
+ *	Get kind of keyword by its spelling
+ *
+ *	@param	spelling	Spelling in UTF-8, may be not null-terminated
+ *	@param	size		Spelling size
+ *
+ *	@return	Keyword token kind, @c TK_IDENTIFIER if spelling is not a keyword
+ */
+token_t token_get_keyword_kind(const char *const spelling, const size_t size);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
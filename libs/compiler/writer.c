@@ -56,7 +56,7 @@ static void write_declaration(writer *const wrt, const node *const nd);
  */
 static inline void write(writer *const wrt, const char *const string)
 {
-	uni_printf(wrt->io, "%s", string);
+	uni_print_str(wrt->io, string);
 }
 
 /**
@@ -72,7 +72,7 @@ static inline void write_line(writer *const wrt, const char *const string)
 		write(wrt, INDENT);
 	}
 
-	uni_printf(wrt->io, "%s", string);
+	uni_print_str(wrt->io, string);
 }
 
 /**
@@ -2027,7 +2027,7 @@ static size_t write_instruction(universal_io *const io, const vector *const tabl
 
 	char buffer[MAX_ELEM_SIZE];
 	size_t argc = elem_get_name(type, 0, buffer);
-	uni_printf(io, "%s", buffer);
+	uni_print_str(io, buffer);
 
 	if (type == IC_LID)
 	{
@@ -2055,7 +2055,7 @@ static size_t write_instruction(universal_io *const io, const vector *const tabl
 		uni_printf(io, " %" PRIitem, vector_get(table, i++));
 	}
 
-	uni_printf(io, "\n");
+	uni_print_str(io, "\n");
 	return i;
 }
 
@@ -2204,7 +2204,7 @@ void write_codes(const char *const path, const vector *const memory)
 		return;
 	}
 
-	uni_printf(&io, "mem\n");
+	uni_print_str(&io, "mem\n");
 	size_t i = 0;
 	while (i < vector_size(memory))
 	{
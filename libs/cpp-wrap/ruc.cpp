@@ -0,0 +1,261 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "ruc.hpp"
+#include <cstdlib>
+
+
+namespace
+{
+
+const char *const DEFAULT_SOURCE = "main.c";
+
+const char *target_flag(const ruc::Target target)
+{
+	switch (target)
+	{
+		case ruc::Target::llvm:
+			return "-LLVM";
+		case ruc::Target::mips:
+			return "-MIPS";
+		default:
+			return "-VM";
+	}
+}
+
+} // namespace
+
+
+namespace ruc
+{
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+Workspace::Workspace() : ws(ws_create()), is_owner(true)
+{
+}
+
+Workspace::Workspace(const std::span<const char *const> args)
+	: ws(ws_parse_args(static_cast<int>(args.size()), args.data())), is_owner(true)
+{
+}
+
+Workspace::Workspace(Workspace &&other) noexcept : ws(other.ws), is_owner(other.is_owner)
+{
+	other.is_owner = false;
+}
+
+Workspace &Workspace::operator=(Workspace &&other) noexcept
+{
+	if (this != &other)
+	{
+		if (is_owner)
+		{
+			ws_clear(&ws);
+		}
+
+		ws = other.ws;
+		is_owner = other.is_owner;
+		other.is_owner = false;
+	}
+
+	return *this;
+}
+
+Workspace::~Workspace()
+{
+	if (is_owner)
+	{
+		ws_clear(&ws);
+	}
+}
+
+workspace *Workspace::get() noexcept
+{
+	return &ws;
+}
+
+const workspace *Workspace::get() const noexcept
+{
+	return &ws;
+}
+
+
+Buffer::Buffer(char *const text, const std::size_t length) noexcept : text(text), length(length)
+{
+}
+
+Buffer::Buffer(Buffer &&other) noexcept : text(other.text), length(other.length)
+{
+	other.text = nullptr;
+	other.length = 0;
+}
+
+Buffer &Buffer::operator=(Buffer &&other) noexcept
+{
+	if (this != &other)
+	{
+		std::free(text);
+
+		text = other.text;
+		length = other.length;
+
+		other.text = nullptr;
+		other.length = 0;
+	}
+
+	return *this;
+}
+
+Buffer::~Buffer()
+{
+	std::free(text);
+}
+
+const char *Buffer::data() const noexcept
+{
+	return text;
+}
+
+std::size_t Buffer::size() const noexcept
+{
+	return length;
+}
+
+bool Buffer::empty() const noexcept
+{
+	return length == 0;
+}
+
+std::string_view Buffer::view() const noexcept
+{
+	return text != nullptr ? std::string_view(text, length) : std::string_view();
+}
+
+Buffer::operator std::string_view() const noexcept
+{
+	return view();
+}
+
+
+Compiler::Compiler(const Target target) : target(target)
+{
+}
+
+Compiler &Compiler::add_flag(const std::string_view flag)
+{
+	flags.emplace_back(flag);
+	return *this;
+}
+
+Compiler &Compiler::add_header(const std::string_view name, const std::string_view text)
+{
+	headers.emplace_back(name, text);
+	return *this;
+}
+
+
+Session::Session(const Compiler &compiler)
+{
+	context.error_log = &Session::error_log;
+	context.warning_log = &Session::warning_log;
+	context.note_log = &Session::note_log;
+	context.data = this;
+
+	// Flags and headers are copied into workspace once, compilations replace only the main file text
+	source_index = ws_add_source(prepared.get(), DEFAULT_SOURCE, "", 0);
+	ws_add_file(prepared.get(), DEFAULT_SOURCE);
+	ws_add_flag(prepared.get(), target_flag(compiler.target));
+
+	for (const std::string &flag : compiler.flags)
+	{
+		ws_add_flag(prepared.get(), flag.c_str());
+	}
+
+	for (const auto &[name, text] : compiler.headers)
+	{
+		ws_add_source(prepared.get(), name.c_str(), text.data(), text.size());
+	}
+
+	ws_set_log_context(prepared.get(), &context);
+}
+
+Result Session::compile(const std::string_view source)
+{
+	ws_set_source(prepared.get(), source_index, source.data() != nullptr ? source.data() : "", source.size());
+	return run(prepared.get());
+}
+
+Result Session::compile(Workspace &ws)
+{
+	// Workspace belongs to caller, so its own logging context is restored after compilation
+	const logger_context *const previous = ws_get_log_context(ws.get());
+	ws_set_log_context(ws.get(), &context);
+	Result result = run(ws.get());
+	ws_set_log_context(ws.get(), previous);
+	return result;
+}
+
+std::span<const Diagnostic> Session::diagnostics() const noexcept
+{
+	return messages;
+}
+
+
+Result Session::run(workspace *const ws)
+{
+	messages.clear();
+
+	char *text = nullptr;
+	std::size_t length = 0;
+	const status_t status = compile_to_buffer(ws, &text, &length);
+	return Result{ status, Buffer(text, length) };
+}
+
+void Session::report(const Severity severity, const char *const tag, const char *const msg)
+{
+	// Context of the compiling thread refers to its session
+	Session *const session = static_cast<Session *>(get_log_context()->data);
+	if (session != nullptr)
+	{
+		const std::lock_guard<std::mutex> guard(session->messages_lock);
+		session->messages.push_back(Diagnostic{ severity, tag, msg });
+	}
+}
+
+void Session::error_log(const char *const tag, const char *const msg)
+{
+	report(Severity::error, tag, msg);
+}
+
+void Session::warning_log(const char *const tag, const char *const msg)
+{
+	report(Severity::warning, tag, msg);
+}
+
+void Session::note_log(const char *const tag, const char *const msg)
+{
+	report(Severity::note, tag, msg);
+}
+
+} // namespace ruc
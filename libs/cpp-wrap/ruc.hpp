@@ -0,0 +1,235 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "compiler.h"
+#include "logger.h"
+#include "workspace.h"
+
+
+namespace ruc
+{
+
+/** Target of code generation */
+enum class Target
+{
+	vm,							/**< RuC virtual machine code */
+	llvm,						/**< LLVM code */
+	mips,						/**< MIPS assembler */
+};
+
+/** Severity of diagnostic message */
+enum class Severity
+{
+	error,						/**< Error */
+	warning,					/**< Warning */
+	note,						/**< Note */
+};
+
+/** Diagnostic message of compilation */
+struct Diagnostic
+{
+	Severity severity;			/**< Message severity */
+	std::string tag;			/**< Message location */
+	std::string message;		/**< Message content */
+};
+
+
+/** Workspace owned by C++ object */
+class EXPORTED Workspace
+{
+public:
+	/** Create empty workspace */
+	Workspace();
+
+	/**
+	 *	Create workspace from command line arguments
+	 *
+	 *	@param	args		Command line arguments with program name
+	 */
+	explicit Workspace(std::span<const char *const> args);
+
+	Workspace(Workspace &&other) noexcept;
+	Workspace &operator=(Workspace &&other) noexcept;
+
+	Workspace(const Workspace &) = delete;
+	Workspace &operator=(const Workspace &) = delete;
+
+	~Workspace();
+
+	/** Get C workspace structure */
+	workspace *get() noexcept;
+	const workspace *get() const noexcept;
+
+private:
+	workspace ws;				/**< C workspace structure */
+	bool is_owner;				/**< Set, if structure should be cleared */
+};
+
+
+/** Output text of compilation, allocated by compiler */
+class EXPORTED Buffer
+{
+public:
+	Buffer() noexcept = default;
+
+	Buffer(Buffer &&other) noexcept;
+	Buffer &operator=(Buffer &&other) noexcept;
+
+	Buffer(const Buffer &) = delete;
+	Buffer &operator=(const Buffer &) = delete;
+
+	~Buffer();
+
+	const char *data() const noexcept;
+	std::size_t size() const noexcept;
+	bool empty() const noexcept;
+
+	std::string_view view() const noexcept;
+	operator std::string_view() const noexcept;
+
+private:
+	friend class Session;
+
+	Buffer(char *const text, const std::size_t length) noexcept;
+
+	char *text = nullptr;		/**< Output text */
+	std::size_t length = 0;		/**< Size of output text */
+};
+
+/** Result of compilation */
+struct Result
+{
+	status_t status = sts_success;	/**< Status code */
+	Buffer output;					/**< Output text, empty on failure */
+
+	bool is_success() const noexcept
+	{
+		return status == sts_success;
+	}
+};
+
+
+/**
+ *	Compiler settings shared by sessions.
+ *	Settings are copied into session on its creation, so changes affect only new sessions.
+ */
+class EXPORTED Compiler
+{
+public:
+	/**
+	 *	Create compiler settings
+	 *
+	 *	@param	target		Target of code generation
+	 */
+	explicit Compiler(const Target target = Target::vm);
+
+	/**
+	 *	Add command line flag
+	 *
+	 *	@param	flag		Flag, @c -I flags add include directories
+	 *
+	 *	@return	Compiler settings
+	 */
+	Compiler &add_flag(const std::string_view flag);
+
+	/**
+	 *	Add header in memory, its text is copied
+	 *
+	 *	@param	name		Header name in include directive
+	 *	@param	text		Header text
+	 *
+	 *	@return	Compiler settings
+	 */
+	Compiler &add_header(const std::string_view name, const std::string_view text);
+
+private:
+	friend class Session;
+
+	Target target;										/**< Target of code generation */
+	std::vector<std::string> flags;						/**< Command line flags */
+	std::vector<std::pair<std::string, std::string>> headers;	/**< Headers in memory */
+};
+
+
+/**
+ *	Compilation session with workspace prepared once from compiler settings,
+ *	each compilation of source text replaces only the main file of workspace.
+ *	One session compiles on one thread at a time, different sessions compile concurrently.
+ *	Logging context refers to session by address, so session is not copied or moved.
+ */
+class EXPORTED Session
+{
+public:
+	/**
+	 *	Create session
+	 *
+	 *	@param	compiler	Compiler settings
+	 */
+	explicit Session(const Compiler &compiler);
+
+	Session(const Session &) = delete;
+	Session &operator=(const Session &) = delete;
+
+	/**
+	 *	Compile source text with settings of compiler
+	 *
+	 *	@param	source		Source text, it is preprocessed as file "main.c"
+	 *
+	 *	@return	Result of compilation
+	 */
+	Result compile(const std::string_view source);
+
+	/**
+	 *	Compile files of workspace with its own flags
+	 *
+	 *	@param	ws			Workspace
+	 *
+	 *	@return	Result of compilation
+	 */
+	Result compile(Workspace &ws);
+
+	/**
+	 *	Get diagnostics of the last compilation
+	 *
+	 *	@return	Diagnostic messages
+	 */
+	std::span<const Diagnostic> diagnostics() const noexcept;
+
+private:
+	Result run(workspace *const ws);
+
+	static void report(const Severity severity, const char *const tag, const char *const msg);
+	static void error_log(const char *const tag, const char *const msg);
+	static void warning_log(const char *const tag, const char *const msg);
+	static void note_log(const char *const tag, const char *const msg);
+
+	Workspace prepared;						/**< Workspace prepared with compiler settings */
+	std::size_t source_index;				/**< Index of main file in memory */
+	logger_context context;					/**< Logging context of session */
+	std::vector<Diagnostic> messages;		/**< Diagnostics of the last compilation */
+	std::mutex messages_lock;				/**< Lock of diagnostics for preprocessor thread */
+};
+
+} // namespace ruc
@@ -305,7 +305,7 @@ static inline int computer_const_number(computer *const comp, const item_t pos,
  */
 
 
-computer computer_create(location *const loc, universal_io *const io, const char *const directive)
+computer computer_create(locator *const loc, universal_io *const io, const char *const directive)
 {
 	return (computer) { .loc = loc_copy(loc), .io = io, .directive = directive
 		, .numbers = stack_create(MAX_EXPRESSION_DAPTH)
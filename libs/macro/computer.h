@@ -72,7 +72,7 @@ typedef struct computer
 	stack numbers;					/**< Numbers stack */
 	stack operators;				/**< Operators stack */
 
-	location loc;					/**< Directive location */
+	locator loc;					/**< Directive location */
 	universal_io *io;				/**< IO for location assembly */
 	const char *directive;			/**< Directive name for error emitting */
 
@@ -89,7 +89,7 @@ typedef struct computer
  *
  *	@return	Computer structure
  */
-computer computer_create(location *const loc, universal_io *const io, const char *const directive);
+computer computer_create(locator *const loc, universal_io *const io, const char *const directive);
 
 
 /**
@@ -344,7 +344,7 @@ static void get_warning(const warning_t num, char *const msg, va_list args)
  */
 
 
-void macro_error(location *const loc, error_t num, ...)
+void macro_error(locator *const loc, error_t num, ...)
 {
 	va_list args;
 	va_start(args, num);
@@ -354,7 +354,7 @@ void macro_error(location *const loc, error_t num, ...)
 	va_end(args);
 }
 
-void macro_warning(location *const loc, warning_t num, ...)
+void macro_warning(locator *const loc, warning_t num, ...)
 {
 	va_list args;
 	va_start(args, num);
@@ -365,14 +365,14 @@ void macro_warning(location *const loc, warning_t num, ...)
 }
 
 
-void macro_verror(location *const loc, const error_t num, va_list args)
+void macro_verror(locator *const loc, const error_t num, va_list args)
 {
 	char msg[MAX_MSG_SIZE];
 	get_error(num, msg, args);
 	log_auto_error(loc, msg);
 }
 
-void macro_vwarning(location *const loc, const warning_t num, va_list args)
+void macro_vwarning(locator *const loc, const warning_t num, va_list args)
 {
 	char msg[MAX_MSG_SIZE];
 	get_warning(num, msg, args);
@@ -95,7 +95,7 @@ typedef enum WARNING
  *	@param	loc			Emitted location
  *	@param	num			Error code
  */
-void macro_error(location *const loc, error_t num, ...);
+void macro_error(locator *const loc, error_t num, ...);
 
 /**
  *	Emit a warning for some problem
@@ -103,7 +103,7 @@ void macro_error(location *const loc, error_t num, ...);
  *	@param	loc			Emitted location
  *	@param	num			Warning code
  */
-void macro_warning(location *const loc, warning_t num, ...);
+void macro_warning(locator *const loc, warning_t num, ...);
 
 
 /**
@@ -113,7 +113,7 @@ void macro_warning(location *const loc, warning_t num, ...);
  *	@param	num			Error code
  *	@param	args		Variable list
  */
-void macro_verror(location *const loc, const error_t num, va_list args);
+void macro_verror(locator *const loc, const error_t num, va_list args);
 
 /**
  *	Emit a warning (embedded version)
@@ -122,7 +122,7 @@ void macro_verror(location *const loc, const error_t num, va_list args);
  *	@param	num			Warning code
  *	@param	args		Variable list
  */
-void macro_vwarning(location *const loc, const warning_t num, va_list args);
+void macro_vwarning(locator *const loc, const warning_t num, va_list args);
 
 
 /**
@@ -15,19 +15,97 @@
  */
 
 #include "keywords.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "utf8.h"
 
 
 extern inline bool kw_is_correct(const keyword_t kw);
 
 
-static int add_keyword(map *const as
-	, const char32_t *const eng, const char32_t *const eng_up
-	, const char32_t *const rus, const char32_t *const rus_up
-	, const keyword_t kw)
+/* Generated by scripts/keywords.py, do not edit */
+
+#define KEYWORD_TABLE_SIZE 128
+#define KEYWORD_BUCKETS_SIZE 32
+#define KEYWORD_MAX_SIZE 29
+
+
+static const uint8_t keyword_displacements[KEYWORD_BUCKETS_SIZE] =
 {
-	return map_add_by_utf8(as, eng, kw) == SIZE_MAX || map_add_by_utf8(as, eng_up, kw) == SIZE_MAX
-		|| map_add_by_utf8(as, rus, kw) == SIZE_MAX || map_add_by_utf8(as, rus_up, kw) == SIZE_MAX;
-}
+	0, 3, 0, 1, 0, 3, 0, 3, 0, 6, 0, 0, 0, 0, 2, 3,
+	0, 2, 3, 5, 1, 0, 1, 1, 1, 2, 0, 4, 2, 0, 1, 0,
+};
+
+static const struct { const char *spelling; keyword_t kind; } keyword_table[KEYWORD_TABLE_SIZE] =
+{
+	[0] = { "#undef", KW_UNDEF },
+	[1] = { "#определить", KW_DEFINE },
+	[6] = { "#КОНЕЦЕСЛИ", KW_ENDIF },
+	[10] = { "#ВЫЧИСЛИТЬ", KW_EVAL },
+	[11] = { "#РАЗОПРЕДЕЛИТЬ", KW_UNDEF },
+	[12] = { "#макро", KW_MACRO },
+	[14] = { "#ЕСЛИ", KW_IF },
+	[15] = { "#else", KW_ELSE },
+	[18] = { "#конецесли", KW_ENDIF },
+	[19] = { "#DEFINE", KW_DEFINE },
+	[20] = { "#если", KW_IF },
+	[22] = { "#вычислить", KW_EVAL },
+	[23] = { "#КОНЕЦМ", KW_ENDM },
+	[24] = { "#СТРОКА", KW_LINE },
+	[25] = { "#переопределить", KW_SET },
+	[26] = { "#пока", KW_WHILE },
+	[27] = { "#ENDW", KW_ENDW },
+	[28] = { "#MACRO", KW_MACRO },
+	[32] = { "#EVAL", KW_EVAL },
+	[33] = { "#include", KW_INCLUDE },
+	[35] = { "#строка", KW_LINE },
+	[36] = { "#endw", KW_ENDW },
+	[38] = { "#иначе", KW_ELSE },
+	[39] = { "#IFNDEF", KW_IFNDEF },
+	[40] = { "#ИНАЧЕ", KW_ELSE },
+	[41] = { "#инесли", KW_ELIF },
+	[42] = { "#if", KW_IF },
+	[43] = { "#ПОКА", KW_WHILE },
+	[44] = { "#разопределить", KW_UNDEF },
+	[47] = { "#set", KW_SET },
+	[48] = { "#INCLUDE", KW_INCLUDE },
+	[54] = { "#while", KW_WHILE },
+	[55] = { "#ПЕРЕОПРЕДЕЛИТЬ", KW_SET },
+	[58] = { "#IF", KW_IF },
+	[60] = { "#eval", KW_EVAL },
+	[61] = { "#ОПРЕДЕЛИТЬ", KW_DEFINE },
+	[64] = { "#define", KW_DEFINE },
+	[66] = { "#МАКРО", KW_MACRO },
+	[71] = { "#macro", KW_MACRO },
+	[72] = { "#ELSE", KW_ELSE },
+	[75] = { "#ENDM", KW_ENDM },
+	[79] = { "#WHILE", KW_WHILE },
+	[81] = { "#ifdef", KW_IFDEF },
+	[82] = { "#UNDEF", KW_UNDEF },
+	[84] = { "#endm", KW_ENDM },
+	[87] = { "#ИНЕСЛИ", KW_ELIF },
+	[90] = { "#SET", KW_SET },
+	[93] = { "#LINE", KW_LINE },
+	[98] = { "#elif", KW_ELIF },
+	[99] = { "#ЕСЛИНЕБЫЛ", KW_IFNDEF },
+	[101] = { "#еслибыл", KW_IFDEF },
+	[102] = { "#конецм", KW_ENDM },
+	[104] = { "#ELIF", KW_ELIF },
+	[109] = { "#IFDEF", KW_IFDEF },
+	[110] = { "#еслинебыл", KW_IFNDEF },
+	[111] = { "#ЕСЛИБЫЛ", KW_IFDEF },
+	[112] = { "#ПОДКЛЮЧИТЬ", KW_INCLUDE },
+	[113] = { "#ENDIF", KW_ENDIF },
+	[116] = { "#подключить", KW_INCLUDE },
+	[119] = { "#endif", KW_ENDIF },
+	[122] = { "#line", KW_LINE },
+	[124] = { "#КОНЕЦП", KW_ENDW },
+	[125] = { "#конецп", KW_ENDW },
+	[127] = { "#ifndef", KW_IFNDEF },
+};
+
+/* End of generated code */
 
 
 /*
@@ -39,34 +117,25 @@ static int add_keyword(map *const as
  */
 
 
-int kw_add(map *const as)
+keyword_t kw_get(const char *const spelling, const size_t size)
 {
-	if (!map_is_correct(as))
+	if (spelling == NULL || size > KEYWORD_MAX_SIZE)
 	{
-		return -1;
+		return NON_KEYWORD;
 	}
 
-	return add_keyword(as, U"#include",		U"#INCLUDE",	U"#подключить",		U"#ПОДКЛЮЧИТЬ",		KW_INCLUDE)
-		|| add_keyword(as, U"#line",		U"#LINE",		U"#строка",			U"#СТРОКА",			KW_LINE)
-
-		|| add_keyword(as, U"#define",		U"#DEFINE",		U"#определить",		U"#ОПРЕДЕЛИТЬ",		KW_DEFINE)
-		|| add_keyword(as, U"#set",			U"#SET",		U"#переопределить",	U"#ПЕРЕОПРЕДЕЛИТЬ",	KW_SET)
-		|| add_keyword(as, U"#undef",		U"#UNDEF",		U"#разопределить",	U"#РАЗОПРЕДЕЛИТЬ",	KW_UNDEF)
-
-		|| add_keyword(as, U"#macro",		U"#MACRO",		U"#макро",			U"#МАКРО",			KW_MACRO)
-		|| add_keyword(as, U"#endm",		U"#ENDM",		U"#конецм",			U"#КОНЕЦМ",			KW_ENDM)
-
-		|| add_keyword(as, U"#ifdef",		U"#IFDEF",		U"#еслибыл",		U"#ЕСЛИБЫЛ",		KW_IFDEF)
-		|| add_keyword(as, U"#ifndef",		U"#IFNDEF",		U"#еслинебыл",		U"#ЕСЛИНЕБЫЛ",		KW_IFNDEF)
-		|| add_keyword(as, U"#if",			U"#IF",			U"#если",			U"#ЕСЛИ",			KW_IF)
-		|| add_keyword(as, U"#elif",		U"#ELIF",		U"#инесли",			U"#ИНЕСЛИ",			KW_ELIF)
-		|| add_keyword(as, U"#else",		U"#ELSE",		U"#иначе",			U"#ИНАЧЕ",			KW_ELSE)
-		|| add_keyword(as, U"#endif",		U"#ENDIF",		U"#конецесли",		U"#КОНЕЦЕСЛИ",		KW_ENDIF)
-
-		|| add_keyword(as, U"#eval",		U"#EVAL",		U"#вычислить",		U"#ВЫЧИСЛИТЬ",		KW_EVAL)
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash = (hash ^ (uint8_t)spelling[i]) * 16777619u;
+	}
 
-		|| add_keyword(as, U"#while",		U"#WHILE",		U"#пока",			U"#ПОКА",			KW_WHILE)
-		|| add_keyword(as, U"#endw",		U"#ENDW",		U"#конецп",			U"#КОНЕЦП",			KW_ENDW);
+	const size_t slot = ((hash >> 8) + keyword_displacements[hash % KEYWORD_BUCKETS_SIZE] * ((hash >> 20) | 1))
+		% KEYWORD_TABLE_SIZE;
+	const char *const keyword = keyword_table[slot].spelling;
+	return keyword != NULL && strncmp(keyword, spelling, size) == 0 && keyword[size] == '\0'
+		? keyword_table[slot].kind
+		: NON_KEYWORD;
 }
 
 size_t kw_without(const char *const directive, char *const buffer)
@@ -16,8 +16,8 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
-#include "map.h"
 
 
 #define MAX_KEYWORD_SIZE 64
@@ -60,13 +60,14 @@ typedef enum KEYWORD
 
 
 /**
- *	Initialize map structure by adding keywords
+ *	Get keyword by its spelling
  *
- *	@param	as				Map structure
+ *	@param	spelling		Spelling in UTF-8, may be not null-terminated
+ *	@param	size			Spelling size
  *
- *	@return	@c 0 on success, @c -1 on failure
+ *	@return	Keyword, @c NON_KEYWORD if spelling is not a keyword
  */
-int kw_add(map *const as);
+keyword_t kw_get(const char *const spelling, const size_t size);
 
 /**
  *	Get corresponding begin block keyword.
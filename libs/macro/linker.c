@@ -57,12 +57,24 @@ static void linker_make_path(char *const buffer, const char *const name, const c
 	buffer[index] = '\0';
 }
 
+static inline bool linker_exists(const linker *const lk, const char *const path)
+{
+	return ws_get_source(lk->ws, path) != NULL || access(path, F_OK) != -1;
+}
+
+static inline int linker_open(const linker *const lk, universal_io *const io, const size_t index)
+{
+	const char *const path = ws_get_file(lk->ws, index);
+	const char *const text = ws_get_source(lk->ws, path);
+	return text != NULL ? in_set_source(io, path, text) : in_set_mapped(io, path);
+}
+
 static inline size_t linker_internal_path(linker *const lk, const char *const file)
 {
 	char path[MAX_ARG_SIZE];
 	linker_make_path(path, file, ws_get_file(lk->ws, lk->current), true);
 
-	if (access(path, F_OK) != -1)
+	if (linker_exists(lk, path))
 	{
 		const size_t size = ws_get_files_num(lk->ws);
 		const size_t index = ws_add_file(lk->ws, path);
@@ -83,7 +95,7 @@ static inline size_t linker_external_path(linker *const lk, const char *const fi
 	{
 		linker_make_path(path, file, ws_get_dir(lk->ws, i), false);
 
-		if (access(path, F_OK) != -1)
+		if (linker_exists(lk, path))
 		{
 			const size_t size = ws_get_files_num(lk->ws);
 			const size_t index = ws_add_file(lk->ws, path);
@@ -122,7 +134,7 @@ universal_io linker_add_source(linker *const lk, const size_t index)
 {
 	universal_io input = io_create();
 
-	if (linker_is_correct(lk) && in_set_file(&input, ws_get_file(lk->ws, index)) == 0)
+	if (linker_is_correct(lk) && linker_open(lk, &input, index) == 0)
 	{
 		vector_set(&lk->included, index, 1);
 		lk->current = index;
@@ -135,7 +147,7 @@ universal_io linker_add_header(linker *const lk, const size_t index)
 {
 	universal_io input = io_create();
 	if (linker_is_correct(lk) && vector_get(&lk->included, index) != 1
-		&& in_set_file(&input, ws_get_file(lk->ws, index)) == 0)
+		&& linker_open(lk, &input, index) == 0)
 	{
 		vector_set(&lk->included, index, 1);
 		lk->current = index;
@@ -203,7 +215,7 @@ bool linker_is_correct(const linker *const lk)
 
 int linker_clear(linker *const lk)
 {
-	if (lk != NULL)
+	if (lk == NULL)
 	{
 		return -1;
 	}
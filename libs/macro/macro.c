@@ -16,6 +16,7 @@
 
 #include "macro.h"
 #include "linker.h"
+#include "logger.h"
 #include "parser.h"
 #include "storage.h"
 #include "uniio.h"
@@ -108,6 +109,9 @@ static inline int ws_parse(const workspace *const ws, storage *const stg)
 
 static int macro_form_io(workspace *const ws, universal_io *const output)
 {
+	const logger_context *const log = ws_get_log_context(ws);
+	const logger_context *const prev_log = log != NULL ? set_log_context(log) : NULL;
+
 	linker lk = linker_create(ws);
 	storage stg = storage_create();
 	parser prs = parser_create(&lk, &stg, output);
@@ -132,6 +136,11 @@ static int macro_form_io(workspace *const ws, universal_io *const output)
 	parser_clear(&prs);
 	storage_clear(&stg);
 	linker_clear(&lk);
+
+	if (log != NULL)
+	{
+		set_log_context(prev_log);
+	}
 	return ret;
 }
 
@@ -192,6 +201,30 @@ int macro_to_file(workspace *const ws, const char *const path)
 	return ret;
 }
 
+int macro_to_stream(workspace *const ws, stream *const stm)
+{
+	if (ws_get_files_num(ws) == 0)
+	{
+		macro_system_error(TAG_LINKER, LINKER_NO_INPUT);
+		stream_finish(stm);
+		return -1;
+	}
+
+	universal_io io = io_create();
+	if (out_set_stream(&io, stm))
+	{
+		macro_system_error(TAG_LINKER, LINKER_WRONG_IO);
+		stream_finish(stm);
+		return -1;
+	}
+
+	int ret = macro_form_io(ws, &io);
+
+	io_erase(&io);
+	stream_finish(stm);
+	return ret;
+}
+
 
 char *auto_macro(const int argc, const char *const *const argv)
 {
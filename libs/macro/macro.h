@@ -17,6 +17,7 @@
 #pragma once
 
 #include "dll.h"
+#include "stream.h"
 #include "workspace.h"
 
 
@@ -43,6 +44,17 @@ EXPORTED char *macro(workspace *const ws);
  */
 EXPORTED int macro_to_file(workspace *const ws, const char *const path);
 
+/**
+ *	Preprocess files from workspace into stream.
+ *	Stream is finished in any case, so consumer never waits forever.
+ *
+ *	@param	ws		Workspace
+ *	@param	stm		Output stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int macro_to_stream(workspace *const ws, stream *const stm);
+
 
 /**
  *	Preprocess files from terminal arguments
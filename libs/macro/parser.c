@@ -40,11 +40,11 @@ static const size_t MAX_ITERATION = 32768;
 
 static const size_t MAX_COMMENT_SIZE = 4096;
 static const size_t MAX_VALUE_SIZE = 4096;
-static const size_t MAX_PATH_SIZE = 1024;
+static const size_t BUFFERS_SIZE = 16;
 
 
 static keyword_t parse_directive(parser *const prs);
-static location parse_location(parser *const prs);
+static locator parse_location(parser *const prs);
 static bool parse_next(parser *const prs, const keyword_t begin, const keyword_t next);
 static bool parse_name(parser *const prs);
 static char32_t parse_line(parser *const prs);
@@ -57,7 +57,7 @@ static keyword_t parse_block(parser *const prs, const keyword_t begin);
  *	@param	prs			Parser structure
  *	@param	num			Error code
  */
-static void parser_error(parser *const prs, location *const loc, error_t num, ...)
+static void parser_error(parser *const prs, locator *const loc, error_t num, ...)
 {
 	if (prs->is_recovery_disabled && prs->was_error)
 	{
@@ -67,7 +67,12 @@ static void parser_error(parser *const prs, location *const loc, error_t num, ..
 	va_list args;
 	va_start(args, num);
 
+	const logger_context *const prev_log = prs->log != NULL ? set_log_context(prs->log) : NULL;
 	macro_verror(in_is_file(prs->io) ? loc : prs->prev, num, args);
+	if (prs->log != NULL)
+	{
+		set_log_context(prev_log);
+	}
 	prs->was_error = true;
 
 	va_end(args);
@@ -79,7 +84,7 @@ static void parser_error(parser *const prs, location *const loc, error_t num, ..
  *	@param	prs			Parser structure
  *	@param	num			Warning code
  */
-static void parser_warning(parser *const prs, location *const loc, warning_t num, ...)
+static void parser_warning(parser *const prs, locator *const loc, warning_t num, ...)
 {
 	if (prs->is_recovery_disabled)
 	{
@@ -89,12 +94,103 @@ static void parser_warning(parser *const prs, location *const loc, warning_t num
 	va_list args;
 	va_start(args, num);
 
+	const logger_context *const prev_log = prs->log != NULL ? set_log_context(prs->log) : NULL;
 	macro_vwarning(in_is_file(prs->io) ? loc : prs->prev, num, args);
+	if (prs->log != NULL)
+	{
+		set_log_context(prev_log);
+	}
 
 	va_end(args);
 }
 
 
+/**
+ *	Take empty output buffer for temporary text.
+ *	Buffers are reused in stack order,
+ *	so the last taken buffer should be released first.
+ *
+ *	@param	prs			Parser structure
+ *
+ *	@return	Output buffer, @c NULL on failure
+ */
+static universal_io *buffer_acquire(parser *const prs)
+{
+	if (prs->buffers_size == prs->buffers_alloc)
+	{
+		const size_t alloc = prs->buffers_alloc != 0 ? 2 * prs->buffers_alloc : BUFFERS_SIZE;
+		universal_io **const buffers = realloc(prs->buffers, alloc * sizeof(universal_io *));
+		if (buffers == NULL)
+		{
+			return NULL;
+		}
+
+		for (size_t i = prs->buffers_alloc; i < alloc; i++)
+		{
+			buffers[i] = NULL;
+		}
+
+		prs->buffers = buffers;
+		prs->buffers_alloc = alloc;
+	}
+
+	universal_io *io = prs->buffers[prs->buffers_size];
+	if (io == NULL)
+	{
+		io = malloc(sizeof(universal_io));
+		if (io == NULL)
+		{
+			return NULL;
+		}
+
+		*io = io_create();
+		if (out_set_buffer(io, MAX_VALUE_SIZE))
+		{
+			free(io);
+			return NULL;
+		}
+
+		prs->buffers[prs->buffers_size] = io;
+	}
+	else
+	{
+		out_reset_buffer(io);
+	}
+
+	prs->buffers_size++;
+	return io;
+}
+
+/**
+ *	Release the last taken output buffer
+ *
+ *	@param	prs			Parser structure
+ */
+static inline void buffer_release(parser *const prs)
+{
+	prs->buffers_size--;
+}
+
+/**
+ *	Get keyword index of directive name
+ *
+ *	@param	prs			Parser structure
+ *	@param	name		Directive name without hash
+ *
+ *	@return	Keyword index
+ */
+static size_t directive_keyword(parser *const prs, const char *const name)
+{
+	universal_io *const directive = buffer_acquire(prs);
+	uni_printf(directive, "#%s", name);
+
+	const char *const buffer = out_get_buffer(directive);
+	const size_t keyword = kw_get(buffer, strlen(buffer));
+	buffer_release(prs);
+	return keyword;
+}
+
+
 /**
  *	Skip single line comment after double slash read.
  *	All line breaks will be replaced by empty lines.
@@ -133,7 +229,7 @@ static inline void skip_multi_comment(parser *const prs)
 {
 	uni_unscan_char(prs->io, '*');
 	uni_unscan_char(prs->io, '/');
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 
 	universal_io out = io_create();
 	out_set_buffer(&out, MAX_COMMENT_SIZE);
@@ -151,7 +247,7 @@ static inline void skip_multi_comment(parser *const prs)
 		if (was_star && character == '/')
 		{
 			char *buffer = out_extract_buffer(&out);
-			uni_printf(prs->io, "%s", buffer);
+			uni_print_str(prs->io, buffer);
 			free(buffer);
 			return;
 		}
@@ -199,7 +295,7 @@ static inline void skip_multi_comment(parser *const prs)
 static char32_t skip_string(parser *const prs, const char32_t quote)
 {
 	uni_unscan_char(prs->io, quote);
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 	uni_scan_char(prs->io);
 
 	char32_t character = uni_scan_char(prs->io);
@@ -271,7 +367,7 @@ static char32_t skip_until(parser *const prs, const bool fill)
 				character = character == '\r' ? uni_scan_char(prs->io) : character;
 				if (character == '\n')
 				{
-					uni_printf(prs->io, "\\\n");
+					uni_print_str(prs->io, "\\\n");
 					loc_line_break(prs->loc);
 					continue;
 				}
@@ -402,11 +498,11 @@ static inline char32_t skip_macro(parser *const prs, const keyword_t keyword)
 		return skip_directive(prs);
 	}
 
-	location loc;
+	locator loc;
 	if (keyword != NON_KEYWORD)
 	{
 		loc = parse_location(prs);
-		uni_printf(prs->io, "%s", storage_last_read(prs->stg));
+		uni_print_str(prs->io, storage_last_read(prs->stg));
 	}
 
 	if (keyword == KW_INCLUDE)
@@ -435,13 +531,13 @@ static inline char32_t skip_macro(parser *const prs, const keyword_t keyword)
 
 	while (character != '\n' && character != (char32_t)EOF)
 	{
-		uni_printf(prs->io, "%s", in_get_position(prs->io) != position ? " " : "");
+		uni_print_str(prs->io, in_get_position(prs->io) != position ? " " : "");
 		if (utf8_is_letter(character))
 		{
 			const char *value = storage_get_by_index(prs->stg, storage_search(prs->stg, prs->io));
 			if (value == NULL)
 			{
-				uni_printf(prs->io, "%s", storage_last_read(prs->stg));
+				uni_print_str(prs->io, storage_last_read(prs->stg));
 			}
 			else if (keyword == KW_IFDEF || keyword == KW_IFNDEF)
 			{
@@ -535,7 +631,7 @@ static keyword_t skip_block(parser *const prs, const keyword_t begin)
 			return keyword;
 		}
 
-		location loc;
+		locator loc;
 		char directive[MAX_KEYWORD_SIZE];
 		if (keyword != NON_KEYWORD)
 		{
@@ -545,7 +641,7 @@ static keyword_t skip_block(parser *const prs, const keyword_t begin)
 
 		while (true)
 		{
-			uni_printf(prs->io, "%s", is_root_macro && character == '\0' ? "" : "\n");
+			uni_print_str(prs->io, is_root_macro && character == '\0' ? "" : "\n");
 			character = prs->is_macro_processed ? skip_macro(prs, keyword) : skip_directive(prs);
 
 			if (keyword != KW_IFDEF && keyword != KW_IFNDEF && keyword != KW_IF && keyword != KW_ELIF
@@ -581,45 +677,41 @@ static keyword_t skip_block(parser *const prs, const keyword_t begin)
  *	@param	arg			Argument number
  */
 static inline void parse_values(parser *const prs, const size_t index, storage *const stg
-	, char *const value, const size_t arg)
+	, const char *const value, const size_t arg)
 {
 	char mask[MAX_MASK_SIZE];
 	sprintf(mask, MASK_TOKEN_PASTE "%zu" MASK_SUFFIX "%zu", index, arg);
 	storage_set_by_index(stg, storage_add(stg, mask), value);
 
-	universal_io io = io_create();
-	in_set_buffer(&io, value);
-	out_set_buffer(&io, MAX_VALUE_SIZE);
-	out_swap(prs->io, &io);
-	parser_preprocess(prs, &io);
-	out_swap(prs->io, &io);
+	universal_io *const io = buffer_acquire(prs);
+	in_set_buffer(io, value);
+	out_swap(prs->io, io);
+	parser_preprocess(prs, io);
+	out_swap(prs->io, io);
 
-	char *buffer = out_extract_buffer(&io);
 	sprintf(mask, MASK_ARGUMENT "%zu" MASK_SUFFIX "%zu", index, arg);
-	storage_set_by_index(stg, storage_add(stg, mask), buffer);
-	free(buffer);
+	storage_set_by_index(stg, storage_add(stg, mask), out_get_buffer(io));
 
-	in_set_position(&io, 0);
-	out_set_buffer(&io, MAX_VALUE_SIZE);
-	uni_print_char(&io, '"');
-	for (char32_t ch = uni_scan_char(&io); ch != (char32_t)EOF; ch = uni_scan_char(&io))
+	in_set_position(io, 0);
+	out_reset_buffer(io);
+	uni_print_char(io, '"');
+	for (char32_t ch = uni_scan_char(io); ch != (char32_t)EOF; ch = uni_scan_char(io))
 	{
 		if (ch == '\\')
 		{
-			ch = uni_scan_char(&io);
-			uni_printf(&io, "%s", ch == '"' ? "\\\\" : ch != (char32_t)EOF ? "\\" : "");
+			ch = uni_scan_char(io);
+			uni_print_str(io, ch == '"' ? "\\\\" : ch != (char32_t)EOF ? "\\" : "");
 		}
 
-		uni_printf(&io, "%s", ch == '"' ? "\\" : "");
-		uni_print_char(&io, ch);
+		uni_print_str(io, ch == '"' ? "\\" : "");
+		uni_print_char(io, ch);
 	}
-	uni_print_char(&io, '"');
-	in_clear(&io);
+	uni_print_char(io, '"');
+	in_clear(io);
 
-	buffer = out_extract_buffer(&io);
 	sprintf(mask, MASK_STRING "%zu" MASK_SUFFIX "%zu", index, arg);
-	storage_set_by_index(stg, storage_add(stg, mask), buffer);
-	free(buffer);
+	storage_set_by_index(stg, storage_add(stg, mask), out_get_buffer(io));
+	buffer_release(prs);
 }
 
 /**
@@ -637,10 +729,10 @@ static inline size_t parse_brackets(parser *const prs, const size_t index, stora
 {
 	size_t arg = 0;
 	char32_t character = '\0';
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 
-	universal_io out = io_create();
-	out_swap(prs->io, &out);
+	universal_io *const out = buffer_acquire(prs);
+	out_swap(prs->io, out);
 
 	while (character != ')' && character != (char32_t)EOF)
 	{
@@ -649,10 +741,10 @@ static inline size_t parse_brackets(parser *const prs, const size_t index, stora
 		size_t position = in_get_position(prs->io);
 		size_t brackets = 0;
 
-		out_set_buffer(prs->io, MAX_VALUE_SIZE);
+		out_reset_buffer(prs->io);
 		while (brackets != 0 || (character != ',' && character != ')' && character != (char32_t)EOF))
 		{
-			uni_printf(prs->io, "%s", in_get_position(prs->io) != position ? " " : "");
+			uni_print_str(prs->io, in_get_position(prs->io) != position ? " " : "");
 			uni_print_char(prs->io, uni_scan_char(prs->io));
 			if (character == '\'' || character == '"')
 			{
@@ -672,14 +764,12 @@ static inline size_t parse_brackets(parser *const prs, const size_t index, stora
 
 		if (arg != SIZE_MAX)
 		{
-			char *buffer = out_extract_buffer(prs->io);
-			parse_values(prs, index, stg, buffer, arg++);
-			free(buffer);
+			parse_values(prs, index, stg, out_get_buffer(prs->io), arg++);
 		}
 	}
 
-	out_swap(prs->io, &out);
-	out_clear(&out);
+	out_swap(prs->io, out);
+	buffer_release(prs);
 	return arg;
 }
 
@@ -695,12 +785,11 @@ static inline size_t parse_brackets(parser *const prs, const size_t index, stora
 static inline void parse_observation(parser *const prs, const size_t index, storage *const stg)
 {
 	universal_io *io = prs->io;
-	universal_io value = io_create();
-	in_set_buffer(&value, storage_get_by_index(prs->stg, index));
-	out_set_buffer(&value, MAX_VALUE_SIZE);
-	prs->io = &value;
+	universal_io *const value = buffer_acquire(prs);
+	in_set_buffer(value, storage_get_by_index(prs->stg, index));
+	prs->io = value;
 
-	location *loc = prs->loc;
+	locator *loc = prs->loc;
 	prs->loc = NULL;
 
 	for (char32_t ch = skip_until(prs, true); ch != (char32_t)EOF; ch = skip_until(prs, true))
@@ -708,7 +797,7 @@ static inline void parse_observation(parser *const prs, const size_t index, stor
 		if (ch == '#' || utf8_is_letter(ch))
 		{
 			const size_t current = storage_search(stg, prs->io);
-			uni_printf(prs->io, "%s", kw_is_correct(current) || current == SIZE_MAX
+			uni_print_str(prs->io, kw_is_correct(current) || current == SIZE_MAX
 				? storage_last_read(stg) : storage_get_by_index(stg, current));
 		}
 		else if (ch == '\'' || ch == '"')
@@ -725,11 +814,10 @@ static inline void parse_observation(parser *const prs, const size_t index, stor
 	prs->loc = loc;
 	prs->io = io;
 
-	char *buffer = out_extract_buffer(&value);
-	in_set_buffer(&value, buffer);
-	parser_preprocess(prs, &value);
-	in_clear(&value);
-	free(buffer);
+	in_set_buffer(value, out_get_buffer(value));
+	parser_preprocess(prs, value);
+	in_clear(value);
+	buffer_release(prs);
 }
 
 /**
@@ -746,7 +834,7 @@ static bool parse_replacement(parser *const prs, const size_t index)
 {
 	const size_t expected = storage_get_args_by_index(prs->stg, index);
 	const size_t position = in_get_position(prs->io);
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 
 	if (expected == 0)
 	{
@@ -804,14 +892,14 @@ static inline void parse_identifier(parser *const prs)
 
 	if (index == SIZE_MAX)
 	{
-		uni_printf(prs->io, "%s", storage_last_read(prs->stg));
+		uni_print_str(prs->io, storage_last_read(prs->stg));
 		return;
 	}
 
 	if (prs->call > MAX_CALL_DEPTH)
 	{
 		parser_error(prs, NULL, CALL_DEPTH);
-		uni_printf(prs->io, "%s", storage_last_read(prs->stg));
+		uni_print_str(prs->io, storage_last_read(prs->stg));
 		return;
 	}
 
@@ -820,7 +908,7 @@ static inline void parse_identifier(parser *const prs)
 	{
 		const size_t end = in_get_position(prs->io);
 		in_set_position(prs->io, begin);
-		location loc = loc_copy(prs->loc);
+		locator loc = loc_copy(prs->loc);
 		prs->prev = &loc;
 
 		uni_print_char(prs->io, '\n');
@@ -913,13 +1001,12 @@ static inline char32_t parse_until(parser *const prs)
 static inline char32_t parse_hash(parser *const prs, universal_io *const out)
 {
 	out_swap(prs->io, out);
-	out_set_buffer(prs->io, MAX_COMMENT_SIZE);
 
 	while (true)
 	{
 		if (prs->is_line_required)
 		{
-			out_set_buffer(prs->io, MAX_COMMENT_SIZE);
+			out_reset_buffer(prs->io);
 			loc_update(prs->loc);
 		}
 
@@ -927,11 +1014,9 @@ static inline char32_t parse_hash(parser *const prs, universal_io *const out)
 		if (character != '\n')
 		{
 			out_swap(prs->io, out);
-			if (character != '#')
+			if (character != '#' && character != (char32_t)EOF)
 			{
-				char *buffer = out_extract_buffer(out);
-				uni_printf(prs->io, "%s", character != (char32_t)EOF ? buffer : "");
-				free(buffer);
+				uni_print_str(prs->io, out_get_buffer(out));
 			}
 
 			prs->is_line_required = false;
@@ -956,45 +1041,38 @@ static inline char32_t parse_hash(parser *const prs, universal_io *const out)
  */
 static keyword_t parse_directive(parser *const prs)
 {
-	universal_io out = io_create();
-	if (parse_hash(prs, &out) != '#')
+	universal_io *const out = buffer_acquire(prs);
+	if (parse_hash(prs, out) != '#')
 	{
+		buffer_release(prs);
 		return NON_KEYWORD;
 	}
 
-	location loc = loc_copy(prs->loc);
-	uni_print_char(&out, '#');
+	locator loc = loc_copy(prs->loc);
+	uni_print_char(out, '#');
 
 	size_t keyword = storage_search(prs->stg, prs->io);
 	if (storage_last_read(prs->stg)[1] == '\0')
 	{
-		out_swap(prs->io, &out);
+		out_swap(prs->io, out);
 		if (utf8_is_letter(skip_until(prs, true)))
 		{
 			loc = loc_copy(prs->loc);
 			storage_search(prs->stg, prs->io);
-
-			universal_io directive = io_create();
-			out_set_buffer(&directive, MAX_KEYWORD_SIZE);
-			uni_printf(&directive, "#%s", storage_last_read(prs->stg));
-
-			char *buffer = out_extract_buffer(&directive);
-			keyword = storage_get_index(prs->stg, buffer);
-			free(buffer);
+			keyword = directive_keyword(prs, storage_last_read(prs->stg));
 		}
-		out_swap(prs->io, &out);
+		out_swap(prs->io, out);
 	}
 
 	if (!kw_is_correct(keyword))
 	{
-		char *buffer = out_extract_buffer(&out);
-		uni_printf(prs->io, "%s", buffer);
+		uni_print_str(prs->io, out_get_buffer(out));
 
 		const char *directive = storage_last_read(prs->stg);
 		if (utf8_is_letter(utf8_convert(&directive[1])))
 		{
 			parser_error(prs, &loc, DIRECTIVE_INVALID, directive);
-			uni_printf(prs->io, "%s", &directive[1]);
+			uni_print_str(prs->io, &directive[1]);
 		}
 		else
 		{
@@ -1002,11 +1080,11 @@ static keyword_t parse_directive(parser *const prs)
 			uni_unscan(prs->io, &directive[1]);
 		}
 
-		free(buffer);
+		buffer_release(prs);
 		return ERROR_KEYWORD;
 	}
 
-	out_clear(&out);
+	buffer_release(prs);
 	return keyword;
 }
 
@@ -1019,7 +1097,7 @@ static keyword_t parse_directive(parser *const prs)
  *
  *	@return	Location of directive name
  */
-static location parse_location(parser *const prs)
+static locator parse_location(parser *const prs)
 {
 	const size_t position = in_get_position(prs->io);
 	uni_unscan(prs->io, storage_last_read(prs->stg));
@@ -1028,7 +1106,7 @@ static location parse_location(parser *const prs)
 		uni_unscan_char(prs->io, '#');
 	}
 
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 	in_set_position(prs->io, position);
 	return loc;
 }
@@ -1073,27 +1151,26 @@ static void parse_extra(parser *const prs, const char *const directive)
  */
 static inline void parse_path(parser *const prs, const char32_t quote)
 {
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 	uni_scan_char(prs->io);
 
-	universal_io out = io_create();
-	out_set_buffer(&out, MAX_PATH_SIZE);
-	out_swap(prs->io, &out);
+	universal_io *const out = buffer_acquire(prs);
+	out_swap(prs->io, out);
 	char32_t character = skip_string(prs, quote);
-	out_swap(prs->io, &out);
+	out_swap(prs->io, out);
 
 	if (character != quote)
 	{
 		parser_error(prs, &loc, INCLUDE_EXPECTS_FILENAME, storage_last_read(prs->stg));
-		out_clear(&out);
+		buffer_release(prs);
 		return;
 	}
 
-	char *path = out_extract_buffer(&out);
+	const char *const path = out_get_buffer(out);
 	size_t index = quote == '"'
 		? linker_search_internal(prs->lk, path)
 		: linker_search_external(prs->lk, path);
-	free(path);
+	buffer_release(prs);
 
 	if (index == SIZE_MAX)
 	{
@@ -1116,7 +1193,7 @@ static inline void parse_path(parser *const prs, const char32_t quote)
  */
 static inline char32_t parse_include(parser *const prs)
 {
-	location loc = parse_location(prs);
+	locator loc = parse_location(prs);
 	if (prs->include >= MAX_INCLUDE_DEPTH)
 	{
 		parser_error(prs, &loc, INCLUDE_DEPTH);
@@ -1194,7 +1271,7 @@ static inline bool parse_suffix(parser *const prs)
  */
 static inline bool parse_number(parser *const prs, computer *const comp, const size_t pos)
 {
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 
 	unsigned long long number = 0;
 	uni_scanf(prs->io, "%lld", &number);
@@ -1270,7 +1347,7 @@ static inline bool parse_number(parser *const prs, computer *const comp, const s
  */
 static inline bool parse_sequence(parser *const prs, computer *const comp, const size_t pos)
 {
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 	universal_io out = io_create();
 	out_set_buffer(&out, MAX_VALUE_SIZE);
 	out_swap(prs->io, &out);
@@ -1317,7 +1394,7 @@ static inline bool parse_sequence(parser *const prs, computer *const comp, const
  */
 static inline bool parse_token(parser *const prs, computer *const comp, const size_t pos)
 {
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 	char32_t character = uni_scan_char(prs->io);
 	size_t position = in_get_position(prs->io);
 	char32_t next = skip_until(prs, false);
@@ -1463,7 +1540,7 @@ static inline bool parse_token(parser *const prs, computer *const comp, const si
  */
 static item_t parse_expression(parser *const prs)
 {
-	location loc = parse_location(prs);
+	locator loc = parse_location(prs);
 	char directive[MAX_KEYWORD_SIZE];
 	const char *last_read = storage_last_read(prs->stg);
 	if (last_read)
@@ -1479,8 +1556,8 @@ static item_t parse_expression(parser *const prs)
 	}
 
 	universal_io *origin_io = prs->io;
-	location *origin_loc = prs->loc;
-	location *origin_prev = prs->prev;
+	locator *origin_loc = prs->loc;
+	locator *origin_prev = prs->prev;
 
 	computer comp = prs->prev == NULL ? computer_create(&loc, prs->io, directive)
 		: computer_create(prs->prev, NULL, directive);
@@ -1556,19 +1633,12 @@ static item_t parse_expression(parser *const prs)
 		}
 		else if (character == '#')
 		{
-			location current = loc_copy(prs->loc);
+			locator current = loc_copy(prs->loc);
 			uni_scan_char(prs->io);
 			skip_until(prs, false);
 
 			storage_search(prs->stg, prs->io);
-			out_set_buffer(&out, MAX_KEYWORD_SIZE);
-			uni_printf(&out, "#%s", storage_last_read(prs->stg));
-
-			char *extract = out_extract_buffer(&out);
-			const size_t keyword = storage_get_index(prs->stg, extract);
-			free(extract);
-
-			if (keyword != KW_EVAL)
+			if (directive_keyword(prs, storage_last_read(prs->stg)) != KW_EVAL)
 			{
 				parser_error(prs, &current, EXPR_INVALID_TOKEN, "#");
 				break;
@@ -1644,7 +1714,7 @@ static inline char32_t parse_eval(parser *const prs)
  */
 static bool parse_name(parser *const prs)
 {
-	location loc = parse_location(prs);
+	locator loc = parse_location(prs);
 	char32_t character = skip_until(prs, false);
 	if (utf8_is_letter(character))
 	{
@@ -1683,7 +1753,7 @@ static size_t parse_args(parser *const prs, storage *const stg, const size_t ind
 		return 0;
 	}
 
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 	uni_scan_char(prs->io);
 	char32_t character = skip_until(prs, false);
 
@@ -1747,7 +1817,7 @@ static size_t parse_args(parser *const prs, storage *const stg, const size_t ind
  */
 static inline bool parse_operator(parser *const prs, storage *const stg, const bool was_space)
 {
-	location loc = loc_copy(prs->loc);
+	locator loc = loc_copy(prs->loc);
 	uni_scan_char(prs->io);
 
 	char32_t character = uni_scan_char(prs->io);
@@ -1781,15 +1851,7 @@ static inline bool parse_operator(parser *const prs, storage *const stg, const b
 		return true;
 	}
 
-	universal_io directive = io_create();
-	out_set_buffer(&directive, MAX_KEYWORD_SIZE);
-	uni_printf(&directive, "#%s", storage_last_read(stg));
-
-	char *buffer = out_extract_buffer(&directive);
-	const size_t keyword = storage_get_index(stg, buffer);
-	free(buffer);
-
-	if (keyword != KW_EVAL)
+	if (directive_keyword(prs, storage_last_read(stg)) != KW_EVAL)
 	{
 		parser_error(prs, &loc, HASH_NOT_FOLLOWED, "#");
 		return false;
@@ -1832,7 +1894,7 @@ static inline char *parse_content(parser *const prs, storage *const stg)
 		}
 		else
 		{
-			uni_printf(prs->io, "%s", in_get_position(prs->io) != position ? " " : "");
+			uni_print_str(prs->io, in_get_position(prs->io) != position ? " " : "");
 			if (utf8_is_letter(character))
 			{
 				const char *value = storage_get_by_index(stg, storage_search(stg, prs->io));
@@ -1842,7 +1904,7 @@ static inline char *parse_content(parser *const prs, storage *const stg)
 				}
 				else
 				{
-					uni_printf(prs->io, "%s", storage_last_read(stg));
+					uni_print_str(prs->io, storage_last_read(stg));
 				}
 			}
 			else if (character == '\'' || character == '"')
@@ -2006,7 +2068,7 @@ static inline char32_t parse_undef(parser *const prs)
  */
 static inline char32_t parse_macro(parser *const prs)
 {
-	location loc = parse_location(prs);
+	locator loc = parse_location(prs);
 	char directive[MAX_KEYWORD_SIZE];
 	sprintf(directive, "%s", storage_last_read(prs->stg));
 
@@ -2075,7 +2137,7 @@ static inline char32_t parse_macro(parser *const prs)
  */
 static inline char32_t parse_while(parser *const prs)
 {
-	location loc = parse_location(prs);
+	locator loc = parse_location(prs);
 	char directive[MAX_KEYWORD_SIZE];
 	sprintf(directive, "%s", storage_last_read(prs->stg));
 
@@ -2116,7 +2178,7 @@ static inline char32_t parse_while(parser *const prs)
 		}
 
 		const size_t end = in_get_position(prs->io);
-		location copy = loc_copy(prs->loc);
+		locator copy = loc_copy(prs->loc);
 		in_set_position(prs->io, begin);
 		*prs->loc = loc;
 
@@ -2190,7 +2252,7 @@ static keyword_t parse_elif(parser *const prs)
  */
 static inline char32_t parse_if(parser *const prs)
 {
-	location loc = parse_location(prs);
+	locator loc = parse_location(prs);
 	char directive[MAX_KEYWORD_SIZE];
 	sprintf(directive, "%s", storage_last_read(prs->stg));
 
@@ -2213,7 +2275,7 @@ static inline char32_t parse_if(parser *const prs)
  */
 static inline char32_t parse_ifdef_ifndef(parser *const prs, keyword_t keyword)
 {
-	location loc = parse_location(prs);
+	locator loc = parse_location(prs);
 	char directive[MAX_KEYWORD_SIZE];
 	sprintf(directive, "%s", storage_last_read(prs->stg));
 
@@ -2396,6 +2458,12 @@ parser parser_create(linker *const lk, storage *const stg, universal_io *const o
 	prs.include = 0;
 	prs.call = 0;
 
+	prs.buffers = NULL;
+	prs.buffers_size = 0;
+	prs.buffers_alloc = 0;
+
+	prs.log = ws_get_log_context(lk->ws);
+
 	prs.is_recovery_disabled = false;
 	prs.is_line_required = false;
 	prs.is_macro_processed = false;
@@ -2417,8 +2485,8 @@ int parser_preprocess(parser *const prs, universal_io *const in)
 	prs->io = in;
 
 	prs->is_line_required = true;
-	location current = loc_search(prs->io);
-	location *loc = prs->loc;
+	locator current = loc_search(prs->io);
+	locator *loc = prs->loc;
 	prs->loc = &current;
 
 	parse_block(prs, NON_KEYWORD);
@@ -2449,6 +2517,19 @@ bool parser_is_correct(const parser *const prs)
 
 int parser_clear(parser *const prs)
 {
-	(void)prs;
+	if (prs == NULL)
+	{
+		return -1;
+	}
+
+	for (size_t i = 0; i < prs->buffers_alloc && prs->buffers[i] != NULL; i++)
+	{
+		io_erase(prs->buffers[i]);
+		free(prs->buffers[i]);
+	}
+
+	free(prs->buffers);
+	prs->buffers = NULL;
+	prs->buffers_alloc = 0;
 	return 0;
 }
@@ -19,6 +19,7 @@
 #include "error.h"
 #include "linker.h"
 #include "locator.h"
+#include "logger.h"
 #include "storage.h"
 #include "uniio.h"
 
@@ -34,12 +35,18 @@ typedef struct parser
 	storage *stg;					/**< Macro storage */
 
 	universal_io *io;				/**< Universal IO structure */
-	location *prev;					/**< Parent macro location */
-	location *loc;					/**< Current location */
+	locator *prev;					/**< Parent macro location */
+	locator *loc;					/**< Current location */
 
 	size_t include;					/**< Current include depth */
 	size_t call;					/**< Current macro call depth */
 
+	universal_io **buffers;			/**< Reusable output buffers for temporary text */
+	size_t buffers_size;			/**< Number of taken buffers */
+	size_t buffers_alloc;			/**< Number of allocated buffers */
+
+	const logger_context *log;		/**< Logging context of preprocessing */
+
 	bool is_recovery_disabled;		/**< Set, if error recovery & multiple output disabled */
 	bool is_line_required;			/**< Set, if position directive required */
 	bool is_macro_processed;		/**< Set, if macro block processed */
@@ -85,7 +85,6 @@ storage storage_create()
 	stg.hs = hash_create(MAX_MACRO);
 	stg.vec = strings_create(MAX_MACRO);
 
-	kw_add(&stg.as);
 	return stg;
 }
 
@@ -206,11 +205,20 @@ size_t storage_search(storage *const stg, universal_io *const io)
 	}
 
 	char32_t last = (char32_t)EOF;
-	const size_t index = map_get_index_by_io(&stg->as, io, &last);
+	size_t size = 0;
+	const char *const key = map_read_by_io(&stg->as, io, &last, &size);
+	const keyword_t kw = kw_get(key, size);
 	uni_unscan_char(io, last);
 
-	const item_t value = map_get_by_index(&stg->as, index);
-	return kw_is_correct(value) ? (size_t)value : hash_get_index(&stg->hs, (item_t)index);
+	// Key is copied at once, because io may be freed before storage_last_read
+	map_last_read(&stg->as);
+	if (kw_is_correct(kw))
+	{
+		return kw;
+	}
+
+	const size_t index = map_get_index_last_read(&stg->as);
+	return hash_get_index(&stg->hs, (item_t)index);
 }
 
 const char *storage_to_string(const storage *const stg, const size_t id)
@@ -218,7 +226,7 @@ const char *storage_to_string(const storage *const stg, const size_t id)
 	return storage_is_correct(stg) ? map_to_string(&stg->as, (size_t)hash_get_key(&stg->hs, id)) : NULL;
 }
 
-const char *storage_last_read(const storage *const stg)
+const char *storage_last_read(storage *const stg)
 {
 	return storage_is_correct(stg) ? map_last_read(&stg->as) : NULL;
 }
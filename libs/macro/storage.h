@@ -312,7 +312,7 @@ const char *storage_to_string(const storage *const stg, const size_t id);
  *
  *	@return	Macro, @c NULL on failure
  */
-const char *storage_last_read(const storage *const stg);
+const char *storage_last_read(storage *const stg);
 
 /**
  *	Check that macro storage is correct
@@ -15,6 +15,17 @@
  */
 
 #include "hash.h"
+#include <stdlib.h>
+
+
+#define HASH_SMALL_CLASSES 16
+
+
+struct hash_slot
+{
+	item_t key;					/**< Key of record */
+	size_t index;				/**< Index of record, @c 0 for empty slot */
+};
 
 
 extern item_t hash_get_key(const hash *const hs, const size_t index);
@@ -28,115 +39,294 @@ extern int hash_set_by_index(hash *const hs, const size_t index, const size_t nu
 extern size_t hash_set_double_by_index(hash *const hs, const size_t index, const size_t num, const double value);
 extern size_t hash_set_int64_by_index(hash *const hs, const size_t index, const size_t num, const int64_t value);
 
-extern int hash_remove_by_index(hash *const hs, const size_t index);
-
 extern bool hash_is_correct(const hash *const hs);
-extern int hash_clear(hash *const hs);
 
 
+static inline hash hash_broken(void)
+{
+	hash hs;
+	hs.records.array = NULL;
+	hs.removed.array = NULL;
+	hs.table = NULL;
+	return hs;
+}
+
 static inline size_t get_hash(const item_t key)
 {
-	return (size_t)key % MAX_HASH;
+	// Fibonacci hashing, so close keys are spread over the whole table
+	return (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15u) >> 32);
 }
 
+static inline size_t hash_find_slot(const hash *const hs, const item_t key)
+{
+	size_t slot = get_hash(key) & (hs->table_size - 1);
+	while (hs->table[slot].index != 0 && hs->table[slot].key != key)
+	{
+		slot = (slot + 1) & (hs->table_size - 1);
+	}
 
-/*
- *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
- *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
- *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
- *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
- *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
- */
+	return slot;
+}
 
+static int hash_grow_table(hash *const hs)
+{
+	const size_t table_size = 2 * hs->table_size;
+	hash_slot *const table = calloc(table_size, sizeof(hash_slot));
+	if (table == NULL)
+	{
+		return -1;
+	}
 
-hash hash_create(const size_t alloc)
+	for (size_t i = 0; i < hs->table_size; i++)
+	{
+		if (hs->table[i].index != 0)
+		{
+			size_t slot = get_hash(hs->table[i].key) & (table_size - 1);
+			while (table[slot].index != 0)
+			{
+				slot = (slot + 1) & (table_size - 1);
+			}
+
+			table[slot] = hs->table[i];
+		}
+	}
+
+	free(hs->table);
+	hs->table = table;
+	hs->table_size = table_size;
+	return 0;
+}
+
+/** Remove slot from table, shift the following slots of the same cluster back */
+static void hash_remove_slot(hash *const hs, size_t slot)
 {
-	hash hs = vector_create(MAX_HASH + alloc * (3 + VALUE_SIZE));
-	vector_increase(&hs, MAX_HASH);	// All set by zero
-	return hs;
+	const size_t mask = hs->table_size - 1;
+	size_t next = (slot + 1) & mask;
+
+	while (hs->table[next].index != 0)
+	{
+		const size_t home = get_hash(hs->table[next].key) & mask;
+		if (((next - home) & mask) >= ((next - slot) & mask))
+		{
+			hs->table[slot] = hs->table[next];
+			slot = next;
+		}
+
+		next = (next + 1) & mask;
+	}
+
+	hs->table[slot].index = 0;
+	hs->table_used--;
+}
+
+/** Size class of free block by its values capacity */
+static inline size_t hash_class(const size_t capacity)
+{
+	// Small blocks have own classes, larger ones are grouped by powers of two
+	size_t result = capacity < HASH_SMALL_CLASSES ? capacity : HASH_SMALL_CLASSES;
+	for (size_t size = capacity; size >= 2 * HASH_SMALL_CLASSES; size /= 2)
+	{
+		result++;
+	}
+
+	return result;
 }
 
+/** Values capacity of free block from the list of size class */
+static inline size_t hash_get_capacity(const hash *const hs, const size_t index, const size_t size_class)
+{
+	return size_class < HASH_SMALL_CLASSES ? size_class : (size_t)vector_get(&hs->records, index - MAX_HASH + 2);
+}
 
-size_t hash_add(hash *const hs, const item_t key, const size_t amount)
+/** Add free block to the list of its size class */
+static void hash_free_block(hash *const hs, const size_t index, const size_t capacity)
 {
-	if (!hash_is_correct(hs))
+	const size_t size_class = hash_class(capacity);
+	if (size_class >= vector_size(&hs->removed))
 	{
-		return SIZE_MAX;
+		vector_resize(&hs->removed, size_class + 1);		// New elements set by zero
+	}
+
+	// Free block is marked by amount, it keeps the next block of list instead of key.
+	// Capacity of small blocks is known from size class, larger ones keep it in the first value
+	vector_set(&hs->records, index - MAX_HASH, vector_get(&hs->removed, size_class));
+	vector_set(&hs->records, index - MAX_HASH + 1, ITEM_MAX);
+	if (size_class >= HASH_SMALL_CLASSES)
+	{
+		vector_set(&hs->records, index - MAX_HASH + 2, (item_t)capacity);
 	}
 
-	size_t prev = get_hash(key);
-	item_t index = vector_get(hs, prev);
+	vector_set(&hs->removed, size_class, (item_t)index);
+}
 
-	if (index != 0)
+/** Take the best fitting free block for values amount, @c 0 if there is no one */
+static size_t hash_take_block(hash *const hs, const size_t amount)
+{
+	for (size_t size_class = hash_class(amount); size_class < vector_size(&hs->removed); size_class++)
 	{
-		item_t record = ITEM_MAX;
-		while (index != ITEM_MAX && index != 0)
+		if (size_class < HASH_SMALL_CLASSES && size_class == amount + 1)
+		{
+			continue;
+		}
+
+		size_t best = 0;
+		size_t best_prev = 0;
+		size_t best_capacity = SIZE_MAX;
+
+		for (size_t prev = 0, index = (size_t)vector_get(&hs->removed, size_class); index != 0
+			; prev = index, index = (size_t)vector_get(&hs->records, index - MAX_HASH))
 		{
-			const item_t temp = vector_get(hs, (size_t)index + 1);
-			if (record == ITEM_MAX && temp == ITEM_MAX && (size_t)vector_get(hs, (size_t)index + 2) == amount)
+			// Rest of the block should fit another free block with key and amount
+			const size_t capacity = hash_get_capacity(hs, index, size_class);
+			if ((capacity == amount || capacity >= amount + 2) && capacity < best_capacity)
 			{
-				record = index;
+				best = index;
+				best_prev = prev;
+				best_capacity = capacity;
+
+				if (capacity == amount || size_class < HASH_SMALL_CLASSES)
+				{
+					break;
+				}
 			}
-			else if (temp == key)
+		}
+
+		if (best != 0)
+		{
+			const item_t next = vector_get(&hs->records, best - MAX_HASH);
+			if (best_prev == 0)
+			{
+				vector_set(&hs->removed, size_class, next);
+			}
+			else
 			{
-				return SIZE_MAX;
+				vector_set(&hs->records, best_prev - MAX_HASH, next);
 			}
 
-			prev = (size_t)index;
-			index = vector_get(hs, prev);
+			if (best_capacity != amount)
+			{
+				hash_free_block(hs, best + 2 + amount, best_capacity - amount - 2);
+			}
+
+			return best;
 		}
+	}
 
-		if (record != ITEM_MAX)
+	return 0;
+}
+
+/** Take free block for values amount or allocate new record at the end */
+static size_t hash_alloc_record(hash *const hs, const size_t amount)
+{
+	size_t index = hash_take_block(hs, amount);
+	if (index != 0)
+	{
+		for (size_t i = 0; i < amount; i++)
 		{
-			index = record;
-			for (size_t i = 0; i < amount; i++)
-			{
-				vector_set(hs, (size_t)index + 3 + i, 0);
-			}
+			vector_set(&hs->records, index - MAX_HASH + 2 + i, 0);
 		}
-		else if (index == ITEM_MAX)
+	}
+	else
+	{
+		index = vector_size(&hs->records) + MAX_HASH;
+		if (vector_increase(&hs->records, 2 + amount))	// New elements set by zero
 		{
 			return SIZE_MAX;
 		}
 	}
 
-	if (index == 0)
+	vector_set(&hs->records, index - MAX_HASH + 1, (item_t)amount);
+	return index;
+}
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+hash hash_create(const size_t alloc)
+{
+	hash hs;
+
+	hs.table_size = MAX_HASH;
+	while (4 * alloc > 3 * hs.table_size)
+	{
+		hs.table_size *= 2;
+	}
+
+	hs.table = calloc(hs.table_size, sizeof(hash_slot));
+	if (hs.table == NULL)
 	{
-		index = (item_t)vector_size(hs);
-		vector_set(hs, prev, index);
-		vector_increase(hs, 3 + amount);	// New elements set by zero
-		vector_set(hs, (size_t)index + 2, (item_t)amount);
+		return hash_broken();
 	}
 
-	vector_set(hs, (size_t)index + 1, key);
-	return (size_t)index;
+	hs.table_used = 0;
+	hs.records = vector_create(alloc * (2 + VALUE_SIZE));
+	hs.removed = vector_create(VALUE_SIZE);
+	if (!vector_is_correct(&hs.records) || !vector_is_correct(&hs.removed))
+	{
+		vector_clear(&hs.records);
+		vector_clear(&hs.removed);
+		free(hs.table);
+		return hash_broken();
+	}
+
+	return hs;
 }
 
 
-size_t hash_get_index(const hash *const hs, const item_t key)
+size_t hash_add(hash *const hs, const item_t key, const size_t amount)
 {
-	if (!hash_is_correct(hs))
+	if (!hash_is_correct(hs) || key == ITEM_MAX)
 	{
 		return SIZE_MAX;
 	}
 
-	size_t prev = get_hash(key);
-	item_t index = vector_get(hs, prev);
+	size_t slot = hash_find_slot(hs, key);
+	if (hs->table[slot].index != 0)
+	{
+		return SIZE_MAX;
+	}
 
-	while (index != ITEM_MAX && index != 0)
+	if (4 * (hs->table_used + 1) > 3 * hs->table_size)
 	{
-		if (vector_get(hs, (size_t)index + 1) == key)
+		if (hash_grow_table(hs))
 		{
-			return (size_t)index;
+			return SIZE_MAX;
 		}
 
-		prev = (size_t)index;
-		index = vector_get(hs, prev);
+		slot = hash_find_slot(hs, key);
 	}
 
-	return SIZE_MAX;
+	const size_t index = hash_alloc_record(hs, amount);
+	if (index == SIZE_MAX)
+	{
+		return SIZE_MAX;
+	}
+
+	vector_set(&hs->records, index - MAX_HASH, key);
+	hs->table[slot].key = key;
+	hs->table[slot].index = index;
+	hs->table_used++;
+	return index;
 }
 
+
+size_t hash_get_index(const hash *const hs, const item_t key)
+{
+	if (!hash_is_correct(hs) || key == ITEM_MAX)
+	{
+		return SIZE_MAX;
+	}
+
+	const size_t index = hs->table[hash_find_slot(hs, key)].index;
+	return index != 0 ? index : SIZE_MAX;
+}
 size_t hash_get_amount(const hash *const hs, const item_t key)
 {
 	return hash_get_amount_by_index(hs, hash_get_index(hs, key));
@@ -182,3 +372,45 @@ int hash_remove(hash *const hs, const item_t key)
 {
 	return hash_remove_by_index(hs, hash_get_index(hs, key));
 }
+
+int hash_remove_by_index(hash *const hs, const size_t index)
+{
+	const item_t key = hash_get_key(hs, index);
+	if (!hash_is_correct(hs) || index < MAX_HASH || key == ITEM_MAX)
+	{
+		return -1;
+	}
+
+	const size_t slot = hash_find_slot(hs, key);
+	if (hs->table[slot].index != index)
+	{
+		return -1;
+	}
+
+	hash_remove_slot(hs, slot);
+
+	// The last record is truncated, others become free blocks for new records
+	const size_t amount = hash_get_amount_by_index(hs, index);
+	if (index - MAX_HASH + 2 + amount == vector_size(&hs->records))
+	{
+		return vector_resize(&hs->records, index - MAX_HASH);
+	}
+
+	hash_free_block(hs, index, amount);
+	return 0;
+}
+
+
+int hash_clear(hash *const hs)
+{
+	if (!hash_is_correct(hs))
+	{
+		return -1;
+	}
+
+	free(hs->table);
+	hs->table = NULL;
+
+	vector_clear(&hs->removed);
+	return vector_clear(&hs->records);
+}
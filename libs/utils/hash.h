@@ -27,8 +27,23 @@
 extern "C" {
 #endif
 
-/** Hash table */
-typedef vector hash;
+/** Hash table slot */
+typedef struct hash_slot hash_slot;
+
+/**
+ *	Hash table with integer keys.
+ *	Records are placed contiguously as [key, amount, values...],
+ *	index of record is its position plus @c MAX_HASH and never changes.
+ */
+typedef struct hash
+{
+	vector records;				/**< Records storage */
+	vector removed;				/**< Heads of free blocks lists by size class */
+
+	hash_slot *table;			/**< Open addressing hash table of keys */
+	size_t table_size;			/**< Size of hash table, power of two */
+	size_t table_used;			/**< Number of used slots */
+} hash;
 
 
 /**
@@ -155,7 +170,8 @@ EXPORTED size_t hash_set_int64(hash *const hs, const item_t key, const size_t nu
  */
 inline item_t hash_get_key(const hash *const hs, const size_t index)
 {
-	return vector_get(hs, index + 1);
+	// Free blocks keep link to the next free block instead of key
+	return vector_get(&hs->records, index - MAX_HASH + 1) != ITEM_MAX ? vector_get(&hs->records, index - MAX_HASH) : ITEM_MAX;
 }
 
 /**
@@ -168,8 +184,8 @@ inline item_t hash_get_key(const hash *const hs, const size_t index)
  */
 inline size_t hash_get_amount_by_index(const hash *const hs, const size_t index)
 {
-	const item_t amount = vector_get(hs, index + 2);
-	return index != SIZE_MAX && amount != ITEM_MAX ? (size_t)amount : 0;
+	const item_t amount = vector_get(&hs->records, index - MAX_HASH + 1);
+	return index >= MAX_HASH && index != SIZE_MAX && amount != ITEM_MAX ? (size_t)amount : 0;
 }
 
 
@@ -184,7 +200,7 @@ inline size_t hash_get_amount_by_index(const hash *const hs, const size_t index)
  */
 inline item_t hash_get_by_index(const hash *const hs, const size_t index, const size_t num)
 {
-	return num < hash_get_amount_by_index(hs, index) ? vector_get(hs, index + 3 + num) : ITEM_MAX;
+	return num < hash_get_amount_by_index(hs, index) ? vector_get(&hs->records, index - MAX_HASH + 2 + num) : ITEM_MAX;
 }
 
 /**
@@ -198,7 +214,7 @@ inline item_t hash_get_by_index(const hash *const hs, const size_t index, const
  */
 inline double hash_get_double_by_index(const hash *const hs, const size_t index, const size_t num)
 {
-	return num + DOUBLE_SIZE <= hash_get_amount_by_index(hs, index) ? vector_get_double(hs, index + 3 + num) : DBL_MAX;
+	return num + DOUBLE_SIZE <= hash_get_amount_by_index(hs, index) ? vector_get_double(&hs->records, index - MAX_HASH + 2 + num) : DBL_MAX;
 }
 
 /**
@@ -212,7 +228,7 @@ inline double hash_get_double_by_index(const hash *const hs, const size_t index,
  */
 inline int64_t hash_get_int64_by_index(const hash *const hs, const size_t index, const size_t num)
 {
-	return num + INT64_SIZE <= hash_get_amount_by_index(hs, index) ? vector_get_int64(hs, index + 3 + num) : LLONG_MAX;
+	return num + INT64_SIZE <= hash_get_amount_by_index(hs, index) ? vector_get_int64(&hs->records, index - MAX_HASH + 2 + num) : LLONG_MAX;
 }
 
 
@@ -228,7 +244,7 @@ inline int64_t hash_get_int64_by_index(const hash *const hs, const size_t index,
  */
 inline int hash_set_by_index(hash *const hs, const size_t index, const size_t num, const item_t value)
 {
-	return num < hash_get_amount_by_index(hs, index) ? vector_set(hs, index + 3 + num, value) : -1;
+	return num < hash_get_amount_by_index(hs, index) ? vector_set(&hs->records, index - MAX_HASH + 2 + num, value) : -1;
 }
 
 /**
@@ -243,7 +259,7 @@ inline int hash_set_by_index(hash *const hs, const size_t index, const size_t nu
  */
 inline size_t hash_set_double_by_index(hash *const hs, const size_t index, const size_t num, const double value)
 {
-	return num + DOUBLE_SIZE <= hash_get_amount_by_index(hs, index) ? vector_set_double(hs, index + 3 + num, value) : SIZE_MAX;
+	return num + DOUBLE_SIZE <= hash_get_amount_by_index(hs, index) ? vector_set_double(&hs->records, index - MAX_HASH + 2 + num, value) : SIZE_MAX;
 }
 
 /**
@@ -258,7 +274,7 @@ inline size_t hash_set_double_by_index(hash *const hs, const size_t index, const
  */
 inline size_t hash_set_int64_by_index(hash *const hs, const size_t index, const size_t num, const int64_t value)
 {
-	return num + INT64_SIZE <= hash_get_amount_by_index(hs, index) ? vector_set_int64(hs, index + 3 + num, value) : SIZE_MAX;
+	return num + INT64_SIZE <= hash_get_amount_by_index(hs, index) ? vector_set_int64(&hs->records, index - MAX_HASH + 2 + num, value) : SIZE_MAX;
 }
 
 
@@ -280,10 +296,7 @@ EXPORTED int hash_remove(hash *const hs, const item_t key);
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-inline int hash_remove_by_index(hash *const hs, const size_t index)
-{
-	return index != SIZE_MAX ? vector_set(hs, index + 1, ITEM_MAX) : -1;
-}
+EXPORTED int hash_remove_by_index(hash *const hs, const size_t index);
 
 
 /**
@@ -295,7 +308,7 @@ inline int hash_remove_by_index(hash *const hs, const size_t index)
  */
 inline bool hash_is_correct(const hash *const hs)
 {
-	return vector_is_correct(hs) && vector_size(hs) >= MAX_HASH;
+	return hs != NULL && vector_is_correct(&hs->records) && hs->table != NULL;
 }
 
 
@@ -306,10 +319,7 @@ inline bool hash_is_correct(const hash *const hs)
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-inline int hash_clear(hash *const hs)
-{
-	return vector_clear(hs);
-}
+EXPORTED int hash_clear(hash *const hs);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -157,29 +157,29 @@ static bool mark_reverse_recognize(universal_io *const io
  */
 
 
-location loc_create(universal_io *const io)
+locator loc_create(universal_io *const io)
 {
-	location loc = loc_search(io);
+	locator loc = loc_search(io);
 	loc_update(&loc);
 	return loc;
 }
 
-location loc_create_begin(universal_io *const io)
+locator loc_create_begin(universal_io *const io)
 {
-	location loc = loc_search(io);
+	locator loc = loc_search(io);
 	loc_update_begin(&loc);
 	return loc;
 }
 
-location loc_create_end(universal_io *const io)
+locator loc_create_end(universal_io *const io)
 {
-	location loc = loc_search(io);
+	locator loc = loc_search(io);
 	loc_update_end(&loc);
 	return loc;
 }
 
 
-int loc_update(location *const loc)
+int loc_update(locator *const loc)
 {
 	char path[MAX_PATH];
 	if (loc_search_from(loc) || !loc_get_path(loc, path) || !out_is_correct(loc->io))
@@ -201,7 +201,7 @@ int loc_update(location *const loc)
 	return 0;
 }
 
-int loc_update_begin(location *const loc)
+int loc_update_begin(locator *const loc)
 {
 	char path[MAX_PATH];
 	if (loc_search_from(loc) || !loc_get_path(loc, path) || !out_is_correct(loc->io))
@@ -234,7 +234,7 @@ int loc_update_begin(location *const loc)
 	return 0;
 }
 
-int loc_update_end(location *const loc)
+int loc_update_end(locator *const loc)
 {
 	char path[MAX_PATH];
 	if (loc_search_from(loc) || !loc_get_path(loc, path) || !out_is_correct(loc->io))
@@ -256,9 +256,9 @@ int loc_update_end(location *const loc)
 }
 
 
-location loc_search(universal_io *const io)
+locator loc_search(universal_io *const io)
 {
-	location loc;
+	locator loc;
 
 	loc.io = io;
 	loc.path = SIZE_MAX;
@@ -274,7 +274,7 @@ location loc_search(universal_io *const io)
 	return loc;
 }
 
-int loc_search_from(location *const loc)
+int loc_search_from(locator *const loc)
 {
 	if (!loc_is_correct(loc))
 	{
@@ -351,17 +351,17 @@ int loc_search_from(location *const loc)
 }
 
 
-location loc_copy(location *const loc)
+locator loc_copy(locator *const loc)
 {
 	if (loc_search_from(loc))
 	{
-		return (location){ .io = NULL };
+		return (locator){ .io = NULL };
 	}
 
 	return *loc;
 }
 
-int loc_line_break(location *const loc)
+int loc_line_break(locator *const loc)
 {
 	if (!loc_is_correct(loc))
 	{
@@ -375,13 +375,13 @@ int loc_line_break(location *const loc)
 	return 0;
 }
 
-bool loc_is_correct(const location *const loc)
+bool loc_is_correct(const locator *const loc)
 {
 	return loc != NULL && in_is_correct(loc->io);
 }
 
 
-size_t loc_get_tag(location *const loc, char *const buffer)
+size_t loc_get_tag(locator *const loc, char *const buffer)
 {
 	const size_t size = loc_get_path(loc, buffer);
 	if (size == 0)
@@ -392,7 +392,7 @@ size_t loc_get_tag(location *const loc, char *const buffer)
 	return size + sprintf(&buffer[size], ":%zu:%zu", loc->line, loc->symbol);
 }
 
-size_t loc_get_code_line(location *const loc, char *const buffer)
+size_t loc_get_code_line(locator *const loc, char *const buffer)
 {
 	if (!loc_is_correct(loc) || buffer == NULL)
 	{
@@ -414,7 +414,7 @@ size_t loc_get_code_line(location *const loc, char *const buffer)
 	return size;
 }
 
-size_t loc_get_path(location *const loc, char *const buffer)
+size_t loc_get_path(locator *const loc, char *const buffer)
 {
 	if (!loc_is_correct(loc) || buffer == NULL)
 	{
@@ -441,17 +441,17 @@ size_t loc_get_path(location *const loc, char *const buffer)
 	return size;
 }
 
-size_t loc_get_line(const location *const loc)
+size_t loc_get_line(const locator *const loc)
 {
 	return loc_is_correct(loc) ? loc->line : FIRST_LINE;
 }
 
-size_t loc_get_symbol(const location *const loc)
+size_t loc_get_symbol(const locator *const loc)
 {
 	return loc_is_correct(loc) ? loc->symbol : FIRST_SYMBOL;
 }
 
-size_t loc_get_index(location *const loc)
+size_t loc_get_index(locator *const loc)
 {
 	if (!loc_is_correct(loc))
 	{
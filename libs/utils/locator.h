@@ -25,7 +25,7 @@ extern "C" {
 #endif
 
 /** Structure for storing information about location */
-typedef struct location
+typedef struct locator
 {
 	universal_io *io;	/**< IO to search and produce marks */
 
@@ -34,7 +34,7 @@ typedef struct location
 
 	size_t line;		/**< Line number */
 	size_t symbol;		/**< Symbol in line */
-} location;
+} locator;
 
 
 /**
@@ -44,7 +44,7 @@ typedef struct location
  *
  *	@return	Location statement
  */
-EXPORTED location loc_create(universal_io *const io);
+EXPORTED locator loc_create(universal_io *const io);
 
 /**
  *	Create location statement for the macro replacement begin mark
@@ -53,7 +53,7 @@ EXPORTED location loc_create(universal_io *const io);
  *
  *	@return	Location statement
  */
-EXPORTED location loc_create_begin(universal_io *const io);
+EXPORTED locator loc_create_begin(universal_io *const io);
 
 /**
  *	Create location statement for the macro replacement end mark
@@ -62,7 +62,7 @@ EXPORTED location loc_create_begin(universal_io *const io);
  *
  *	@return	Location statement
  */
-EXPORTED location loc_create_end(universal_io *const io);
+EXPORTED locator loc_create_end(universal_io *const io);
 
 
 /**
@@ -72,7 +72,7 @@ EXPORTED location loc_create_end(universal_io *const io);
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-EXPORTED int loc_update(location *const loc);
+EXPORTED int loc_update(locator *const loc);
 
 /**
  *	Update location for the macro replacement begin mark
@@ -81,7 +81,7 @@ EXPORTED int loc_update(location *const loc);
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-EXPORTED int loc_update_begin(location *const loc);
+EXPORTED int loc_update_begin(locator *const loc);
 
 /**
  *	Update location for the macro replacement end mark
@@ -90,7 +90,7 @@ EXPORTED int loc_update_begin(location *const loc);
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-EXPORTED int loc_update_end(location *const loc);
+EXPORTED int loc_update_end(locator *const loc);
 
 
 /**
@@ -100,7 +100,7 @@ EXPORTED int loc_update_end(location *const loc);
  *
  *	@return	Location statement
  */
-EXPORTED location loc_search(universal_io *const io);
+EXPORTED locator loc_search(universal_io *const io);
 
 /**
  *	Continue search from other location
@@ -109,7 +109,7 @@ EXPORTED location loc_search(universal_io *const io);
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-EXPORTED int loc_search_from(location *const loc);
+EXPORTED int loc_search_from(locator *const loc);
 
 
 /**
@@ -119,7 +119,7 @@ EXPORTED int loc_search_from(location *const loc);
  *
  *	@return	Location statement
  */
-EXPORTED location loc_copy(location *const loc);
+EXPORTED locator loc_copy(locator *const loc);
 
 /**
  *	Append line number when @c '\\n' character scanned
@@ -129,7 +129,7 @@ EXPORTED location loc_copy(location *const loc);
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-EXPORTED int loc_line_break(location *const loc);
+EXPORTED int loc_line_break(locator *const loc);
 
 /**
  *	Check that location is correct
@@ -138,7 +138,7 @@ EXPORTED int loc_line_break(location *const loc);
  *
  *	@return	@c 1 on true, @c 0 on false
  */
-EXPORTED bool loc_is_correct(const location *const loc);
+EXPORTED bool loc_is_correct(const locator *const loc);
 
 
 /**
@@ -149,7 +149,7 @@ EXPORTED bool loc_is_correct(const location *const loc);
  *
  *	@return Size of tag
  */
-EXPORTED size_t loc_get_tag(location *const loc, char *const buffer);
+EXPORTED size_t loc_get_tag(locator *const loc, char *const buffer);
 
 /**
  *	Get current code line
@@ -159,7 +159,7 @@ EXPORTED size_t loc_get_tag(location *const loc, char *const buffer);
  *
  *	@return Size of code line
  */
-EXPORTED size_t loc_get_code_line(location *const loc, char *const buffer);
+EXPORTED size_t loc_get_code_line(locator *const loc, char *const buffer);
 
 /**
  *	Get current filename path
@@ -169,7 +169,7 @@ EXPORTED size_t loc_get_code_line(location *const loc, char *const buffer);
  *
  *	@return Size of path
  */
-EXPORTED size_t loc_get_path(location *const loc, char *const buffer);
+EXPORTED size_t loc_get_path(locator *const loc, char *const buffer);
 
 /**
  *	Get normalized line number in code
@@ -178,7 +178,7 @@ EXPORTED size_t loc_get_path(location *const loc, char *const buffer);
  *
  *	@return	Line number
  */
-EXPORTED size_t loc_get_line(const location *const loc);
+EXPORTED size_t loc_get_line(const locator *const loc);
 
 /**
  *	Get normalized position in line
@@ -187,7 +187,7 @@ EXPORTED size_t loc_get_line(const location *const loc);
  *
  *	@return	Position in line
  */
-EXPORTED size_t loc_get_symbol(const location *const loc);
+EXPORTED size_t loc_get_symbol(const locator *const loc);
 
 /**
  *	Get character index of code line
@@ -196,7 +196,7 @@ EXPORTED size_t loc_get_symbol(const location *const loc);
  *
  *	@return	Index of code line
  */
-EXPORTED size_t loc_get_index(location *const loc);
+EXPORTED size_t loc_get_index(locator *const loc);
 
 #ifdef __cplusplus
 } /* extern "C" */
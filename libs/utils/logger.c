@@ -54,9 +54,44 @@ static void default_warning_log(const char *const tag, const char *const msg);
 static void default_note_log(const char *const tag, const char *const msg);
 
 
-static logger current_error_log = &default_error_log;
-static logger current_warning_log = &default_warning_log;
-static logger current_note_log = &default_note_log;
+#ifdef _MSC_VER
+	#define THREAD_LOCAL __declspec(thread)
+#else
+	#define THREAD_LOCAL _Thread_local
+#endif
+
+/** Default logging functions of thread */
+static THREAD_LOCAL logger_context thread_defaults = {
+	.error_log = &default_error_log,
+	.warning_log = &default_warning_log,
+	.note_log = &default_note_log,
+	.data = NULL
+};
+
+/** Logging context of thread, overrides default functions */
+static THREAD_LOCAL const logger_context *thread_context = NULL;
+
+
+static inline logger current_error_log(void)
+{
+	return thread_context != NULL && thread_context->error_log != NULL
+		? thread_context->error_log
+		: thread_defaults.error_log;
+}
+
+static inline logger current_warning_log(void)
+{
+	return thread_context != NULL && thread_context->warning_log != NULL
+		? thread_context->warning_log
+		: thread_defaults.warning_log;
+}
+
+static inline logger current_note_log(void)
+{
+	return thread_context != NULL && thread_context->note_log != NULL
+		? thread_context->note_log
+		: thread_defaults.note_log;
+}
 
 
 static inline void set_color(const uint8_t color)
@@ -143,6 +178,13 @@ static inline void print_msg(const uint8_t color, const char *const msg)
 
 static inline void default_log(const char *const tag, const char *const msg, const uint8_t color, const char *const tag_log)
 {
+	// Messages of concurrent compilations are not mixed
+#ifdef _WIN32
+	_lock_file(stderr);
+#else
+	flockfile(stderr);
+#endif
+
 	set_color(COLOR_TAG);
 	fprintf(stderr, "%s: ", tag);
 
@@ -161,6 +203,12 @@ static inline void default_log(const char *const tag, const char *const msg, con
 #else
 	print_msg(color, msg);
 #endif
+
+#ifdef _WIN32
+	_unlock_file(stderr);
+#else
+	funlockfile(stderr);
+#endif
 }
 
 static void default_error_log(const char *const tag, const char *const msg)
@@ -183,13 +231,13 @@ static int check_arg(const char *const arg)
 {
 	if (arg == NULL)
 	{
-		current_error_log(TAG_LOGGER, ERROR_LOGGER_ARG_NULL);
+		current_error_log()(TAG_LOGGER, ERROR_LOGGER_ARG_NULL);
 		return -1;
 	}
 
 	if (strchr(arg, '\n') != NULL)
 	{
-		current_error_log(TAG_LOGGER, ERROR_LOGGER_ARG_MULTILINE);
+		current_error_log()(TAG_LOGGER, ERROR_LOGGER_ARG_MULTILINE);
 		return -1;
 	}
 
@@ -284,7 +332,7 @@ static inline void log_main(const logger func, const char *const tag, const char
 
 	if (line == NULL)
 	{
-		current_error_log(TAG_LOGGER, ERROR_LOGGER_ARG_NULL);
+		current_error_log()(TAG_LOGGER, ERROR_LOGGER_ARG_NULL);
 		return;
 	}
 
@@ -294,7 +342,7 @@ static inline void log_main(const logger func, const char *const tag, const char
 	func(tag, buffer);
 }
 
-static inline void log_auto(const logger func, location *const loc, const char *const msg)
+static inline void log_auto(const logger func, locator *const loc, const char *const msg)
 {
 	if (check_arg(msg))
 	{
@@ -305,7 +353,7 @@ static inline void log_auto(const logger func, location *const loc, const char *
 	char line[MAX_MSG_SIZE];
 	if (!loc_get_tag(loc, tag) || !loc_get_code_line(loc, line))
 	{
-		current_error_log(TAG_LOGGER, ERROR_LOGGER_NO_LOCATION);
+		current_error_log()(TAG_LOGGER, ERROR_LOGGER_NO_LOCATION);
 		return;
 	}
 
@@ -332,7 +380,7 @@ int set_error_log(const logger func)
 		return -1;
 	}
 
-	current_error_log = func;
+	thread_defaults.error_log = func;
 	return 0;
 }
 
@@ -343,7 +391,7 @@ int set_warning_log(const logger func)
 		return -1;
 	}
 
-	current_warning_log = func;
+	thread_defaults.warning_log = func;
 	return 0;
 }
 
@@ -354,40 +402,53 @@ int set_note_log(const logger func)
 		return -1;
 	}
 
-	current_note_log = func;
+	thread_defaults.note_log = func;
 	return 0;
 }
 
 
+const logger_context *set_log_context(const logger_context *const context)
+{
+	const logger_context *const prev = thread_context;
+	thread_context = context;
+	return prev;
+}
+
+const logger_context *get_log_context(void)
+{
+	return thread_context != NULL ? thread_context : &thread_defaults;
+}
+
+
 void log_error(const char *const tag, const char *const msg, const char *const line, const size_t symbol)
 {
-	log_main(current_error_log, tag, msg, line, symbol);
+	log_main(current_error_log(), tag, msg, line, symbol);
 }
 
 void log_warning(const char *const tag, const char *const msg, const char *const line, const size_t symbol)
 {
-	log_main(current_warning_log, tag, msg, line, symbol);
+	log_main(current_warning_log(), tag, msg, line, symbol);
 }
 
 void log_note(const char *const tag, const char *const msg, const char *const line, const size_t symbol)
 {
-	log_main(current_note_log, tag, msg, line, symbol);
+	log_main(current_note_log(), tag, msg, line, symbol);
 }
 
 
-void log_auto_error(location *const loc, const char *const msg)
+void log_auto_error(locator *const loc, const char *const msg)
 {
-	log_auto(current_error_log, loc, msg);
+	log_auto(current_error_log(), loc, msg);
 }
 
-void log_auto_warning(location *const loc, const char *const msg)
+void log_auto_warning(locator *const loc, const char *const msg)
 {
-	log_auto(current_warning_log, loc, msg);
+	log_auto(current_warning_log(), loc, msg);
 }
 
-void log_auto_note(location *const loc, const char *const msg)
+void log_auto_note(locator *const loc, const char *const msg)
 {
-	log_auto(current_note_log, loc, msg);
+	log_auto(current_note_log(), loc, msg);
 }
 
 
@@ -398,7 +459,7 @@ void log_system_error(const char *const tag, const char *const msg)
 		return;
 	}
 
-	current_error_log(tag, msg);
+	current_error_log()(tag, msg);
 }
 
 void log_system_warning(const char *const tag, const char *const msg)
@@ -408,7 +469,7 @@ void log_system_warning(const char *const tag, const char *const msg)
 		return;
 	}
 
-	current_warning_log(tag, msg);
+	current_warning_log()(tag, msg);
 }
 
 void log_system_note(const char *const tag, const char *const msg)
@@ -418,5 +479,5 @@ void log_system_note(const char *const tag, const char *const msg)
 		return;
 	}
 
-	current_note_log(tag, msg);
+	current_note_log()(tag, msg);
 }
@@ -33,9 +33,18 @@ extern "C" {
  */
 typedef void (*logger)(const char *const tag, const char *const msg);
 
+/** Logging context of compilation */
+typedef struct logger_context
+{
+	logger error_log;			/**< Error logging function, thread default if @c NULL */
+	logger warning_log;			/**< Warning logging function, thread default if @c NULL */
+	logger note_log;			/**< Note logging function, thread default if @c NULL */
+	void *data;					/**< Data of logging functions */
+} logger_context;
+
 
 /**
- *	Set custom error logging function
+ *	Set custom error logging function for the current thread
  *
  *	@param	func	Custom logging function
  *
@@ -44,7 +53,7 @@ typedef void (*logger)(const char *const tag, const char *const msg);
 EXPORTED int set_error_log(const logger func);
 
 /**
- *	Set custom warning logging function
+ *	Set custom warning logging function for the current thread
  *
  *	@param	func	Custom logging function
  *
@@ -53,7 +62,7 @@ EXPORTED int set_error_log(const logger func);
 EXPORTED int set_warning_log(const logger func);
 
 /**
- *	Set custom note logging function
+ *	Set custom note logging function for the current thread
  *
  *	@param	func	Custom logging function
  *
@@ -61,6 +70,22 @@ EXPORTED int set_warning_log(const logger func);
  */
 EXPORTED int set_note_log(const logger func);
 
+/**
+ *	Set logging context for the current thread
+ *
+ *	@param	context	Logging context, @c NULL for thread defaults
+ *
+ *	@return	Previous logging context
+ */
+EXPORTED const logger_context *set_log_context(const logger_context *const context);
+
+/**
+ *	Get logging context used by the current thread
+ *
+ *	@return	Logging context, thread defaults if context is not set
+ */
+EXPORTED const logger_context *get_log_context(void);
+
 
 /**
  *	Add error message to log
@@ -99,7 +124,7 @@ EXPORTED void log_note(const char *const tag, const char *const msg, const char
  *	@param	loc		Message location
  *	@param	msg		Message content
  */
-EXPORTED void log_auto_error(location *const loc, const char *const msg);
+EXPORTED void log_auto_error(locator *const loc, const char *const msg);
 
 /**
  *	Add warning message to log
@@ -107,7 +132,7 @@ EXPORTED void log_auto_error(location *const loc, const char *const msg);
  *	@param	loc		Message location
  *	@param	msg		Message content
  */
-EXPORTED void log_auto_warning(location *const loc, const char *const msg);
+EXPORTED void log_auto_warning(locator *const loc, const char *const msg);
 
 /**
  *	Add note message to log
@@ -115,7 +140,7 @@ EXPORTED void log_auto_warning(location *const loc, const char *const msg);
  *	@param	loc		Message location
  *	@param	msg		Message content
  */
-EXPORTED void log_auto_note(location *const loc, const char *const msg);
+EXPORTED void log_auto_note(locator *const loc, const char *const msg);
 
 
 /**
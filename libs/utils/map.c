@@ -15,17 +15,22 @@
  */
 
 #include "map.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "uniscanner.h"
 #include "utf8.h"
 
 
-struct map_hash
+#define MAP_HASH_INIT 14695981039346656037u
+
+
+struct map_record
 {
-	size_t next;
-	size_t ref;
-	item_t value;
+	size_t ref;			/**< Key reference in keys storage */
+	size_t size;		/**< Key size in bytes */
+	size_t hash;		/**< Full hash of key */
+	item_t value;		/**< Value */
 };
 
 
@@ -48,34 +53,109 @@ static int map_add_key_symbol(map *const as, const char32_t ch)
 	return map_add_key_symbol(as, ch);
 }
 
-static size_t map_get_hash(map *const as, const char *const key)
+/** Add byte to FNV-1a hash */
+static inline uint64_t map_hash_byte(const uint64_t hash, const char byte)
 {
-	if (!map_is_correct(as) || key == NULL || key[0] == '\0')
+	return (hash ^ (uint8_t)byte) * 1099511628211u;
+}
+
+/**
+ *	Set the last read key
+ *
+ *	@param	as			Map structure
+ *	@param	key			Key, may be placed outside of keys storage
+ *	@param	size		Key size
+ *	@param	hash		FNV-1a hash of key
+ *
+ *	@return	Hash of key
+ */
+static inline size_t map_set_last_read(map *const as, const char *const key, const size_t size, const uint64_t hash)
+{
+	as->last_key = key;
+	as->last_size = size;
+
+	// SIZE_MAX is reserved for failure
+	as->last_hash = (size_t)(hash ^ (hash >> 32)) & (SIZE_MAX >> 1);
+	return as->last_hash;
+}
+
+/**
+ *	Set the key read into the end of keys storage as the last read key
+ *
+ *	@param	as			Map structure
+ *
+ *	@return	Hash of key
+ */
+static size_t map_set_last_read_from_keys(map *const as)
+{
+	uint64_t hash = MAP_HASH_INIT;
+	for (size_t i = as->keys_size; i < as->keys_next; i++)
 	{
-		return SIZE_MAX;
+		hash = map_hash_byte(hash, as->keys[i]);
 	}
 
-	as->keys_next = as->keys_size;
+	return map_set_last_read(as, &as->keys[as->keys_size], as->keys_next - as->keys_size, hash);
+}
 
-	char32_t ch = utf8_convert(key);
-	if (map_add_key_symbol(as, ch))
+/**
+ *	Copy the last read key into the end of keys storage, if it is placed outside
+ *
+ *	@param	as			Map structure
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+static int map_copy_last_read(map *const as)
+{
+	if (as->last_key == &as->keys[as->keys_size])
+	{
+		return 0;
+	}
+
+	if (as->keys_alloc - as->keys_size <= as->last_size)
+	{
+		size_t keys_alloc = 2 * as->keys_alloc;
+		while (keys_alloc - as->keys_size <= as->last_size)
+		{
+			keys_alloc *= 2;
+		}
+
+		char *keys_new = realloc(as->keys, keys_alloc * sizeof(char));
+		if (keys_new == NULL)
+		{
+			return -1;
+		}
+
+		as->keys_alloc = keys_alloc;
+		as->keys = keys_new;
+	}
+
+	memcpy(&as->keys[as->keys_size], as->last_key, as->last_size);
+	as->keys[as->keys_size + as->last_size] = '\0';
+
+	as->keys_next = as->keys_size + as->last_size;
+	as->last_key = &as->keys[as->keys_size];
+	return 0;
+}
+
+static size_t map_get_hash(map *const as, const char *const key)
+{
+	if (!map_is_correct(as) || key == NULL || key[0] == '\0')
 	{
 		return SIZE_MAX;
 	}
 
-	size_t hash = ch;
+	as->keys_next = as->keys_size;
+	as->last_key = NULL;
+
 	while (key[as->keys_next - as->keys_size] != '\0')
 	{
-		ch = utf8_convert(&key[as->keys_next - as->keys_size]);
-		if (map_add_key_symbol(as, ch))
+		if (map_add_key_symbol(as, utf8_convert(&key[as->keys_next - as->keys_size])))
 		{
 			return SIZE_MAX;
 		}
-
-		hash += ch;
 	}
 
-	return hash % MAP_HASH_MAX;
+	return map_set_last_read_from_keys(as);
 }
 
 static size_t map_get_hash_by_utf8(map *const as, const char32_t *const key)
@@ -86,19 +166,60 @@ static size_t map_get_hash_by_utf8(map *const as, const char32_t *const key)
 	}
 
 	as->keys_next = as->keys_size;
+	as->last_key = NULL;
 
-	size_t hash = 0;
 	for (size_t i = 0; key[i] != '\0'; i++)
 	{
 		if (map_add_key_symbol(as, key[i]))
 		{
 			return SIZE_MAX;
 		}
+	}
+
+	return map_set_last_read_from_keys(as);
+}
+
+/**
+ *	Read key directly from input buffer, key is not copied
+ *
+ *	@param	as			Map structure
+ *	@param	io			Universal io structure with input buffer
+ *	@param	last		Next character after key
+ *
+ *	@return	Hash of key, @c SIZE_MAX on failure
+ */
+static size_t map_get_hash_by_buffer(map *const as, universal_io *const io, char32_t *const last)
+{
+	const char *const begin = &io->in_buffer[io->in_position];
+	const char *const end = &io->in_buffer[io->in_size];
+
+	uint64_t hash = MAP_HASH_INIT;
+	const char *current = begin;
+	while (current < end)
+	{
+		const size_t size = utf8_symbol_size(*current);
+		if (size == 0 || current + size > end)
+		{
+			break;
+		}
 
-		hash += key[i];
+		const char32_t symbol = size == 1 ? (char32_t)*current : utf8_convert(current);
+		if (!utf8_is_letter(symbol) && (current == begin ? symbol != '#' : !utf8_is_digit(symbol)))
+		{
+			break;
+		}
+
+		for (size_t i = 0; i < size; i++)
+		{
+			hash = map_hash_byte(hash, current[i]);
+		}
+		current += size;
 	}
 
-	return hash % MAP_HASH_MAX;
+	io->in_position += (size_t)(current - begin);
+	*last = uni_scan_char(io);
+
+	return current != begin ? map_set_last_read(as, begin, (size_t)(current - begin), hash) : SIZE_MAX;
 }
 
 static size_t map_get_hash_by_io(map *const as, universal_io *const io, char32_t *const last)
@@ -108,6 +229,12 @@ static size_t map_get_hash_by_io(map *const as, universal_io *const io, char32_t
 		return SIZE_MAX;
 	}
 
+	as->last_key = NULL;
+	if (in_is_buffer(io))
+	{
+		return map_get_hash_by_buffer(as, io, last);
+	}
+
 	as->keys_next = as->keys_size;
 
 	*last = uni_scan_char(io);
@@ -121,7 +248,6 @@ static size_t map_get_hash_by_io(map *const as, universal_io *const io, char32_t
 		return SIZE_MAX;
 	}
 
-	size_t hash = *last;
 	*last = uni_scan_char(io);
 	while (utf8_is_letter(*last) || utf8_is_digit(*last))
 	{
@@ -130,42 +256,112 @@ static size_t map_get_hash_by_io(map *const as, universal_io *const io, char32_t
 			return SIZE_MAX;
 		}
 
-		hash += *last;
 		*last = uni_scan_char(io);
 	}
 
-	return hash % MAP_HASH_MAX;
+	return map_set_last_read_from_keys(as);
 }
 
 
-static inline int map_cmp_key(const map *const as, const size_t index)
+/**
+ *	Find slot of the read key in hash table
+ *
+ *	@param	as			Map structure
+ *	@param	hash		Hash of the read key
+ *
+ *	@return	Slot with index of record or empty slot, where key should be added
+ */
+static size_t map_find_slot(const map *const as, const size_t hash)
 {
-	return strcmp(&as->keys[as->values[index].ref], &as->keys[as->keys_size]);
+	const size_t mask = as->table_size - 1;
+
+	size_t slot = hash & mask;
+	while (as->table[slot] != SIZE_MAX)
+	{
+		const map_record *const record = &as->values[as->table[slot]];
+		if (record->hash == hash && record->size == as->last_size
+			&& memcmp(&as->keys[record->ref], as->last_key, as->last_size) == 0)
+		{
+			return slot;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
 }
 
-static inline size_t map_get_index_by_hash(const map *const as, const size_t hash)
+/**
+ *	Double the size of hash table and insert all records again
+ *
+ *	@param	as			Map structure
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+static int map_grow_table(map *const as)
 {
-	if (hash == SIZE_MAX)
+	const size_t table_size = 2 * as->table_size;
+	size_t *const table = malloc(table_size * sizeof(size_t));
+	if (table == NULL)
 	{
-		return SIZE_MAX;
+		return -1;
+	}
+
+	for (size_t i = 0; i < table_size; i++)
+	{
+		table[i] = SIZE_MAX;
 	}
 
-	size_t index = hash;
-	while (as->values[index].next != SIZE_MAX)
+	for (size_t i = 0; i < as->values_size; i++)
 	{
-		if (map_cmp_key(as, index) == 0)
+		if (as->values[i].ref == SIZE_MAX)
+		{
+			continue;
+		}
+
+		size_t slot = as->values[i].hash & (table_size - 1);
+		while (table[slot] != SIZE_MAX)
 		{
-			return index;
+			slot = (slot + 1) & (table_size - 1);
 		}
-		index = as->values[index].next;
+
+		table[slot] = i;
 	}
 
-	if (as->values[index].ref == SIZE_MAX || map_cmp_key(as, index) != 0)
+	free(as->table);
+	as->table = table;
+	as->table_size = table_size;
+	return 0;
+}
+
+/**
+ *	Get index of new record for key in keys storage.
+ *	Record indexes are written to compiler output, so they are chosen as in chained table:
+ *	the first key of bucket takes bucket index, other keys are placed after buckets.
+ *
+ *	@param	as			Map structure
+ *	@param	key			Key
+ *	@param	size		Key size
+ *
+ *	@return	Index of new record
+ */
+static size_t map_get_new_index(const map *const as, const char *const key, const size_t size)
+{
+	size_t bucket = 0;
+	for (size_t i = 0; i < size;)
 	{
-		return SIZE_MAX;
+		const size_t symbol_size = utf8_symbol_size(key[i]);
+		bucket += utf8_convert(&key[i]);
+		i += symbol_size != 0 ? symbol_size : 1;
 	}
 
-	return index;
+	bucket %= MAP_HASH_MAX;
+	return as->values[bucket].ref == SIZE_MAX ? bucket : as->values_size;
+}
+
+static inline size_t map_get_index_by_hash(const map *const as, const size_t hash)
+{
+	return hash != SIZE_MAX ? as->table[map_find_slot(as, hash)] : SIZE_MAX;
 }
 
 static size_t map_add_by_hash(map *const as, const size_t hash, const item_t value)
@@ -175,31 +371,32 @@ static size_t map_add_by_hash(map *const as, const size_t hash, const item_t val
 		return SIZE_MAX;
 	}
 
-	size_t index = hash;
-	while (as->values[index].next != SIZE_MAX)
+	size_t slot = map_find_slot(as, hash);
+	if (as->table[slot] != SIZE_MAX)
 	{
-		if (map_cmp_key(as, index) == 0)
-		{
-			return value == ITEM_MAX ? index : SIZE_MAX;
-		}
-		index = as->values[index].next;
+		return value == ITEM_MAX ? as->table[slot] : SIZE_MAX;
 	}
 
-	if (as->values[index].ref == SIZE_MAX)
+	// Load factor of hash table is kept below 3/4
+	if (4 * (as->values_size + 1) > 3 * as->table_size)
 	{
-		as->values[index].ref = as->keys_size;
-		as->keys_size = as->keys_next + 1;
-		as->values[index].value = value;
-		return index;
+		if (map_grow_table(as))
+		{
+			return SIZE_MAX;
+		}
+
+		slot = map_find_slot(as, hash);
 	}
-	else if (map_cmp_key(as, index) == 0)
+
+	if (map_copy_last_read(as))
 	{
-		return value == ITEM_MAX ? index : SIZE_MAX;
+		return SIZE_MAX;
 	}
 
-	if (as->values_size == as->values_alloc)
+	const size_t index = map_get_new_index(as, as->last_key, as->last_size);
+	if (index == as->values_size && as->values_size == as->values_alloc)
 	{
-		map_hash *values_new = realloc(as->values, 2 * as->values_alloc * sizeof(map_hash));
+		map_record *values_new = realloc(as->values, 2 * as->values_alloc * sizeof(map_record));
 		if (values_new == NULL)
 		{
 			return SIZE_MAX;
@@ -209,13 +406,15 @@ static size_t map_add_by_hash(map *const as, const size_t hash, const item_t val
 		as->values = values_new;
 	}
 
-	as->values[index].next = as->values_size;
-	index = as->values_size++;
-
-	as->values[index].next = SIZE_MAX;
+	as->values_size += index == as->values_size ? 1 : 0;
 	as->values[index].ref = as->keys_size;
-	as->keys_size = as->keys_next + 1;
+	as->values[index].size = as->last_size;
+	as->values[index].hash = hash;
 	as->values[index].value = value;
+
+	as->keys_size += as->last_size + 1;
+	as->last_key = NULL;
+	as->table[slot] = index;
 	return index;
 }
 
@@ -248,6 +447,7 @@ static inline map map_broken()
 	map as;
 	as.values = NULL;
 	as.keys = NULL;
+	as.table = NULL;
 	return as;
 }
 
@@ -268,7 +468,7 @@ map map_create(const size_t alloc)
 	as.values_size = MAP_HASH_MAX;
 	as.values_alloc = as.values_size + alloc;
 
-	as.values = malloc(as.values_alloc * sizeof(map_hash));
+	as.values = malloc(as.values_alloc * sizeof(map_record));
 	if (as.values == NULL)
 	{
 		return map_broken();
@@ -276,17 +476,40 @@ map map_create(const size_t alloc)
 
 	for (size_t i = 0; i < as.values_size; i++)
 	{
-		as.values[i].next = SIZE_MAX;
 		as.values[i].ref = SIZE_MAX;
 	}
 
+	as.table_size = MAP_TABLE_SIZE;
+	while (4 * as.values_alloc > 3 * as.table_size)
+	{
+		as.table_size *= 2;
+	}
+
+	as.table = malloc(as.table_size * sizeof(size_t));
+	if (as.table == NULL)
+	{
+		free(as.values);
+		return map_broken();
+	}
+
+	for (size_t i = 0; i < as.table_size; i++)
+	{
+		as.table[i] = SIZE_MAX;
+	}
+
 	as.keys_size = 0;
+	as.keys_next = 0;
+
+	as.last_key = NULL;
+	as.last_size = 0;
+	as.last_hash = SIZE_MAX;
 	as.keys_alloc = as.values_alloc * MAP_KEY_SIZE;
 
 	as.keys = malloc(as.keys_alloc * sizeof(char));
 	if (as.keys == NULL)
 	{
 		free(as.values);
+		free(as.table);
 		return map_broken();
 	}
 
@@ -294,6 +517,35 @@ map map_create(const size_t alloc)
 }
 
 
+map map_copy(const map *const as)
+{
+	if (!map_is_correct(as))
+	{
+		return map_broken();
+	}
+
+	map copy = *as;
+	copy.values = malloc(as->values_alloc * sizeof(map_record));
+	copy.table = malloc(as->table_size * sizeof(size_t));
+	copy.keys = malloc(as->keys_alloc * sizeof(char));
+	if (copy.values == NULL || copy.table == NULL || copy.keys == NULL)
+	{
+		free(copy.values);
+		free(copy.table);
+		free(copy.keys);
+		return map_broken();
+	}
+
+	memcpy(copy.values, as->values, as->values_size * sizeof(map_record));
+	memcpy(copy.table, as->table, as->table_size * sizeof(size_t));
+	memcpy(copy.keys, as->keys, as->keys_next * sizeof(char));
+
+	copy.last_key = NULL;
+	copy.last_size = 0;
+	copy.last_hash = SIZE_MAX;
+	return copy;
+}
+
 size_t map_reserve(map *const as, const char *const key)
 {
 	return map_add_by_hash(as, map_get_hash(as, key), ITEM_MAX);
@@ -309,6 +561,11 @@ size_t map_reserve_by_io(map *const as, universal_io *const io, char32_t *const
 	return map_add_by_hash(as, map_get_hash_by_io(as, io, last), ITEM_MAX);
 }
 
+size_t map_reserve_last_read(map *const as)
+{
+	return map_is_correct(as) && as->last_key != NULL ? map_add_by_hash(as, as->last_hash, ITEM_MAX) : SIZE_MAX;
+}
+
 
 size_t map_add(map *const as, const char *const key, const item_t value)
 {
@@ -368,6 +625,11 @@ size_t map_get_index_by_io(map *const as, universal_io *const io, char32_t *cons
 	return map_get_index_by_hash(as, map_get_hash_by_io(as, io, last));
 }
 
+size_t map_get_index_last_read(map *const as)
+{
+	return map_is_correct(as) && as->last_key != NULL ? map_get_index_by_hash(as, as->last_hash) : SIZE_MAX;
+}
+
 
 item_t map_get(map *const as, const char *const key)
 {
@@ -399,14 +661,25 @@ const char *map_to_string(const map *const as, const size_t index)
 		: NULL;
 }
 
-const char *map_last_read(const map *const as)
+const char *map_read_by_io(map *const as, universal_io *const io, char32_t *const last, size_t *const size)
 {
-	return map_is_correct(as) && as->keys_size < as->keys_next ? &as->keys[as->keys_size] : NULL;
+	if (size == NULL || map_get_hash_by_io(as, io, last) == SIZE_MAX)
+	{
+		return NULL;
+	}
+
+	*size = as->last_size;
+	return as->last_key;
+}
+
+const char *map_last_read(map *const as)
+{
+	return map_is_correct(as) && as->last_key != NULL && !map_copy_last_read(as) ? as->last_key : NULL;
 }
 
 bool map_is_correct(const map *const as)
 {
-	return as != NULL && as->values != NULL && as->keys != NULL;
+	return as != NULL && as->values != NULL && as->table != NULL && as->keys != NULL;
 }
 
 
@@ -420,6 +693,9 @@ int map_clear(map *const as)
 	free(as->values);
 	as->values = NULL;
 
+	free(as->table);
+	as->table = NULL;
+
 	free(as->keys);
 	as->keys = NULL;
 
@@ -26,11 +26,12 @@ extern "C" {
 #endif
 
 static const size_t MAP_HASH_MAX = 256;
+static const size_t MAP_TABLE_SIZE = 256;
 static const size_t MAP_KEY_SIZE = 8;
 
 
-/** Hash table */
-typedef struct map_hash map_hash;
+/** Map record */
+typedef struct map_record map_record;
 
 /** Associative array (Dictionary) */
 typedef struct map
@@ -40,9 +41,16 @@ typedef struct map
 	size_t keys_next;			/**< Next size position */
 	size_t keys_alloc;			/**< Allocated size of keys storage */
 
-	map_hash *values;			/**< Values storage */
+	const char *last_key;		/**< The last read key, may be placed in io buffer */
+	size_t last_size;			/**< Size of the last read key */
+	size_t last_hash;			/**< Hash of the last read key */
+
+	map_record *values;			/**< Values storage, starts with buckets, index of record never changes */
 	size_t values_size;			/**< Size of values storage */
 	size_t values_alloc;		/**< Allocated size of values storage */
+
+	size_t *table;				/**< Open addressing hash table of record indexes */
+	size_t table_size;			/**< Size of hash table, power of two */
 } map;
 
 
@@ -55,6 +63,15 @@ typedef struct map
  */
 EXPORTED map map_create(const size_t alloc);
 
+/**
+ *	Create a copy of map structure, the last read key is not copied
+ *
+ *	@param	as				Map structure
+ *
+ *	@return	Map structure
+ */
+EXPORTED map map_copy(const map *const as);
+
 
 /**
  *	Reserve new key or return existing
@@ -87,6 +104,15 @@ EXPORTED size_t map_reserve_by_utf8(map *const as, const char32_t *const key);
  */
 EXPORTED size_t map_reserve_by_io(map *const as, universal_io *const io, char32_t *const last);
 
+/**
+ *	Reserve the last read key or return existing
+ *
+ *	@param	as				Map structure
+ *
+ *	@return	Index of record, @c SIZE_MAX on failure
+ */
+EXPORTED size_t map_reserve_last_read(map *const as);
+
 
 /**
  *	Add new key-value pair
@@ -200,6 +226,15 @@ EXPORTED size_t map_get_index_by_utf8(map *const as, const char32_t *const key);
  */
 EXPORTED size_t map_get_index_by_io(map *const as, universal_io *const io, char32_t *const last);
 
+/**
+ *	Get index of record by the last read key
+ *
+ *	@param	as				Map structure
+ *
+ *	@return	Index of record, @c SIZE_MAX on failure
+ */
+EXPORTED size_t map_get_index_last_read(map *const as);
+
 
 /**
  *	Get value by key
@@ -254,13 +289,27 @@ EXPORTED item_t map_get_by_index(const map *const as, const size_t index);
 EXPORTED const char *map_to_string(const map *const as, const size_t index);
 
 /**
- *	Return the last read key
+ *	Read key from io without searching it in map.
+ *	If io is a buffer, key is not copied and points to the input buffer,
+ *	so it is not null-terminated.
+ *
+ *	@param	as				Map structure
+ *	@param	io				Universal io structure
+ *	@param	last			Next character after key
+ *	@param	size			Size of read key
+ *
+ *	@return	Read key, @c NULL on failure
+ */
+EXPORTED const char *map_read_by_io(map *const as, universal_io *const io, char32_t *const last, size_t *const size);
+
+/**
+ *	Return the last read key as null-terminated string
  *
  *	@param	as				Map structure
  *
  *	@return	Key, @c NULL on failure
  */
-EXPORTED const char *map_last_read(const map *const as);
+EXPORTED const char *map_last_read(map *const as);
 
 /**
  *	Check that map is correct
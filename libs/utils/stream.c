@@ -0,0 +1,273 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "stream.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+	#include <pthread.h>
+#endif
+
+
+#define CHUNK_SIZE 65536
+#define PUBLISH_SIZE 4096
+#define CHUNKS_ALLOC 16
+
+
+struct stream
+{
+	char **chunks;				/**< Chunks of text */
+	size_t chunks_size;			/**< Number of chunks */
+	size_t chunks_alloc;		/**< Allocated size of chunks array */
+
+	size_t size;				/**< Size of written text */
+	size_t published;			/**< Size of text available for consumer */
+	bool is_finished;			/**< Set, if producer has finished */
+
+#ifndef _WIN32
+	pthread_mutex_t mutex;		/**< Guard of chunks array and published size */
+	pthread_cond_t cond;		/**< Signal of published text */
+#endif
+};
+
+
+static inline void stream_lock(stream *const stm)
+{
+#ifndef _WIN32
+	pthread_mutex_lock(&stm->mutex);
+#else
+	(void)stm;
+#endif
+}
+
+static inline void stream_unlock(stream *const stm)
+{
+#ifndef _WIN32
+	pthread_mutex_unlock(&stm->mutex);
+#else
+	(void)stm;
+#endif
+}
+
+/** Publish written text, must be called under lock */
+static inline void stream_publish(stream *const stm)
+{
+	stm->published = stm->size;
+#ifndef _WIN32
+	pthread_cond_broadcast(&stm->cond);
+#endif
+}
+
+/** Wait until position is published or stream is finished, must be called under lock */
+static inline void stream_wait(stream *const stm, const size_t position)
+{
+	while (position >= stm->published && !stm->is_finished)
+	{
+#ifndef _WIN32
+		pthread_cond_wait(&stm->cond, &stm->mutex);
+#else
+		// Without threads producer always finishes before consumer starts
+		break;
+#endif
+	}
+}
+
+static int stream_add_chunk(stream *const stm)
+{
+	char *const chunk = malloc(CHUNK_SIZE * sizeof(char));
+	if (chunk == NULL)
+	{
+		return -1;
+	}
+
+	stream_lock(stm);
+	if (stm->chunks_size == stm->chunks_alloc)
+	{
+		char **const chunks_new = realloc(stm->chunks, 2 * stm->chunks_alloc * sizeof(char *));
+		if (chunks_new == NULL)
+		{
+			stream_unlock(stm);
+			free(chunk);
+			return -1;
+		}
+
+		stm->chunks_alloc *= 2;
+		stm->chunks = chunks_new;
+	}
+
+	stm->chunks[stm->chunks_size++] = chunk;
+	stream_unlock(stm);
+	return 0;
+}
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+stream *stream_create(void)
+{
+	stream *const stm = malloc(sizeof(stream));
+	if (stm == NULL)
+	{
+		return NULL;
+	}
+
+	stm->chunks_size = 0;
+	stm->chunks_alloc = CHUNKS_ALLOC;
+	stm->chunks = malloc(stm->chunks_alloc * sizeof(char *));
+	if (stm->chunks == NULL)
+	{
+		free(stm);
+		return NULL;
+	}
+
+	stm->size = 0;
+	stm->published = 0;
+	stm->is_finished = false;
+
+#ifndef _WIN32
+	pthread_mutex_init(&stm->mutex, NULL);
+	pthread_cond_init(&stm->cond, NULL);
+#endif
+
+	return stm;
+}
+
+
+int stream_write(stream *const stm, const char *const str, const size_t size)
+{
+	if (!stream_is_correct(stm) || str == NULL || stm->is_finished)
+	{
+		return -1;
+	}
+
+	// Producer is the only writer of chunks, so unpublished text is written without lock
+	size_t written = 0;
+	while (written < size)
+	{
+		const size_t offset = stm->size % CHUNK_SIZE;
+		if (offset == 0 && stm->size / CHUNK_SIZE == stm->chunks_size && stream_add_chunk(stm))
+		{
+			return -1;
+		}
+
+		const size_t part = size - written < CHUNK_SIZE - offset ? size - written : CHUNK_SIZE - offset;
+		memcpy(&stm->chunks[stm->size / CHUNK_SIZE][offset], &str[written], part);
+
+		stm->size += part;
+		written += part;
+	}
+
+	if (stm->size - stm->published >= PUBLISH_SIZE)
+	{
+		stream_lock(stm);
+		stream_publish(stm);
+		stream_unlock(stm);
+	}
+
+	return 0;
+}
+
+int stream_finish(stream *const stm)
+{
+	if (!stream_is_correct(stm))
+	{
+		return -1;
+	}
+
+	stream_lock(stm);
+	stm->is_finished = true;
+	stream_publish(stm);
+	stream_unlock(stm);
+	return 0;
+}
+
+
+const char *stream_get(stream *const stm, const size_t position, size_t *const available)
+{
+	*available = 0;
+	if (!stream_is_correct(stm))
+	{
+		return NULL;
+	}
+
+	stream_lock(stm);
+	stream_wait(stm, position);
+
+	if (position >= stm->published)
+	{
+		stream_unlock(stm);
+		return NULL;
+	}
+
+	const size_t chunk_end = (position / CHUNK_SIZE + 1) * CHUNK_SIZE;
+	*available = (stm->published < chunk_end ? stm->published : chunk_end) - position;
+
+	const char *const result = &stm->chunks[position / CHUNK_SIZE][position % CHUNK_SIZE];
+	stream_unlock(stm);
+	return result;
+}
+
+bool stream_is_reachable(stream *const stm, const size_t position)
+{
+	if (!stream_is_correct(stm))
+	{
+		return false;
+	}
+
+	stream_lock(stm);
+	stream_wait(stm, position);
+
+	const bool result = position <= stm->published;
+	stream_unlock(stm);
+	return result;
+}
+
+bool stream_is_correct(const stream *const stm)
+{
+	return stm != NULL && stm->chunks != NULL;
+}
+
+
+int stream_clear(stream *const stm)
+{
+	if (!stream_is_correct(stm))
+	{
+		return -1;
+	}
+
+	for (size_t i = 0; i < stm->chunks_size; i++)
+	{
+		free(stm->chunks[i]);
+	}
+
+	free(stm->chunks);
+
+#ifndef _WIN32
+	pthread_mutex_destroy(&stm->mutex);
+	pthread_cond_destroy(&stm->cond);
+#endif
+
+	free(stm);
+	return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dll.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *	Text stream between one producer and one consumer.
+ *	Text is stored in chunks that are never moved, so consumer can read
+ *	published part while producer is writing the next one.
+ *	Stream is not bounded: consumer may return to any earlier position,
+ *	so all chunks are kept until stream is cleared.
+ */
+typedef struct stream stream;
+
+
+/**
+ *	Create new stream
+ *
+ *	@return	Stream, @c NULL on failure
+ */
+EXPORTED stream *stream_create(void);
+
+
+/**
+ *	Append text to stream
+ *
+ *	@param	stm			Stream
+ *	@param	str			Text
+ *	@param	size		Text size
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int stream_write(stream *const stm, const char *const str, const size_t size);
+
+/**
+ *	Make all written text available and mark stream as finished
+ *
+ *	@param	stm			Stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int stream_finish(stream *const stm);
+
+
+/**
+ *	Get contiguous part of stream, wait for producer if necessary
+ *
+ *	@param	stm			Stream
+ *	@param	position	Position in stream
+ *	@param	available	Number of available characters from position
+ *
+ *	@return	Pointer to character at position, @c NULL on the end of stream
+ */
+EXPORTED const char *stream_get(stream *const stm, const size_t position, size_t *const available);
+
+/**
+ *	Check that position can be reached, wait for producer if necessary
+ *
+ *	@param	stm			Stream
+ *	@param	position	Position in stream
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool stream_is_reachable(stream *const stm, const size_t position);
+
+/**
+ *	Check that stream is correct
+ *
+ *	@param	stm			Stream
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool stream_is_correct(const stream *const stm);
+
+
+/**
+ *	Free allocated memory
+ *
+ *	@param	stm			Stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int stream_clear(stream *const stm);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -15,6 +15,24 @@
  */
 
 #include "tree.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+#define TREE_PATH_SIZE 64
+#define TREE_VALUES_SIZE 256
+#define TREE_SPAN_BLOCK_SIZE 32
+#define TREE_SPAN_BYTES_SIZE 64
+#define TREE_CURSORS_SIZE 16
+
+/** Minimal distance between node indexes, so every node has its own span slot */
+#define TREE_NODE_MIN_SIZE 7
+
+/** Children with lesser numbers are found from the first child without cursor */
+#define TREE_CURSOR_DISTANCE 8
+
+/** Argument cells not greater than limit refer to values table */
+#define TREE_CELL_LIMIT (-(1 << 30))
 
 
 static inline bool is_negative(const item_t value)
@@ -33,13 +51,445 @@ static inline size_t from_negative(const item_t value)
 }
 
 
-static inline void vector_swap(vector *const vec, size_t fst, size_t snd)
+static int cells_resize(tree_table *const tree, const size_t size)
+{
+	if (size > tree->size_alloc)
+	{
+		const size_t alloc_new = size > 2 * tree->size_alloc ? size : 2 * tree->size_alloc;
+		int32_t *cells_new = realloc(tree->cells, alloc_new * sizeof(int32_t));
+		if (cells_new == NULL)
+		{
+			return -1;
+		}
+
+		tree->size_alloc = alloc_new;
+		tree->cells = cells_new;
+	}
+
+	if (size > tree->size)
+	{
+		memset(&tree->cells[tree->size], 0, (size - tree->size) * sizeof(int32_t));
+	}
+
+	tree->size = size;
+	return 0;
+}
+
+static inline int cells_resize_by(tree_table *const tree, const size_t size)
+{
+	return cells_resize(tree, tree->size + size);
+}
+
+static inline size_t cells_size(const tree_table *const tree)
+{
+	return tree_is_correct(tree) ? tree->size : SIZE_MAX;
+}
+
+static inline item_t cell_get(const tree_table *const tree, const size_t index)
+{
+	return index < tree->size ? tree->cells[index] : ITEM_MAX;
+}
+
+static inline int cell_set(tree_table *const tree, const size_t index, const item_t value)
+{
+	if (index >= tree->size)
+	{
+		return -1;
+	}
+
+	tree->cells[index] = (int32_t)value;
+	return 0;
+}
+
+static inline size_t cell_add(tree_table *const tree, const item_t value)
+{
+	if (cells_resize_by(tree, 1))
+	{
+		return SIZE_MAX;
+	}
+
+	tree->cells[tree->size - 1] = (int32_t)value;
+	return tree->size - 1;
+}
+
+static inline void cell_swap(tree_table *const tree, size_t fst, size_t snd)
+{
+	const int32_t temp = tree->cells[fst];
+	tree->cells[fst] = tree->cells[snd];
+	tree->cells[snd] = temp;
+}
+
+
+static inline bool arg_is_cell(const item_t value)
+{
+	return value > TREE_CELL_LIMIT && value <= INT32_MAX;
+}
+
+static inline item_t arg_encode(tree_table *const tree, const item_t value)
+{
+	return arg_is_cell(value) ? value : TREE_CELL_LIMIT - (item_t)vector_add(&tree->values, value);
+}
+
+static inline item_t arg_get(const tree_table *const tree, const size_t index)
+{
+	const item_t cell = cell_get(tree, index);
+	return cell > TREE_CELL_LIMIT ? cell : vector_get(&tree->values, (size_t)(TREE_CELL_LIMIT - cell));
+}
+
+static inline int arg_set(tree_table *const tree, const size_t index, const item_t value)
+{
+	const item_t cell = cell_get(tree, index);
+	if (cell <= TREE_CELL_LIMIT && !arg_is_cell(value))
+	{
+		// Value slot is reused
+		return vector_set(&tree->values, (size_t)(TREE_CELL_LIMIT - cell), value);
+	}
+
+	return cell_set(tree, index, arg_encode(tree, value));
+}
+
+static inline size_t arg_add(tree_table *const tree, const item_t value)
+{
+	return cell_add(tree, arg_encode(tree, value));
+}
+
+static inline double arg_get_double(const tree_table *const tree, const size_t index)
+{
+	item_t stg[DOUBLE_SIZE];
+	for (size_t i = 0; i < DOUBLE_SIZE; i++)
+	{
+		stg[i] = arg_get(tree, index + i);
+	}
+
+	return item_restore_double(stg);
+}
+
+static inline int64_t arg_get_int64(const tree_table *const tree, const size_t index)
+{
+	item_t stg[INT64_SIZE];
+	for (size_t i = 0; i < INT64_SIZE; i++)
+	{
+		stg[i] = arg_get(tree, index + i);
+	}
+
+	return item_restore_int64(stg);
+}
+
+static inline size_t arg_set_double(tree_table *const tree, const size_t index, const double value)
+{
+	item_t stg[DOUBLE_SIZE];
+	const size_t size = item_store_double(value, stg);
+	for (size_t i = 0; i < DOUBLE_SIZE; i++)
+	{
+		arg_set(tree, index + i, stg[i]);
+	}
+
+	return size;
+}
+
+static inline size_t arg_set_int64(tree_table *const tree, const size_t index, const int64_t value)
+{
+	item_t stg[INT64_SIZE];
+	const size_t size = item_store_int64(value, stg);
+	for (size_t i = 0; i < INT64_SIZE; i++)
+	{
+		arg_set(tree, index + i, stg[i]);
+	}
+
+	return size;
+}
+
+static inline size_t arg_add_double(tree_table *const tree, const double value)
+{
+	const size_t index = cells_size(tree);
+	cells_resize_by(tree, DOUBLE_SIZE);
+	arg_set_double(tree, index, value);
+	return index;
+}
+
+static inline size_t arg_add_int64(tree_table *const tree, const int64_t value)
+{
+	const size_t index = cells_size(tree);
+	cells_resize_by(tree, INT64_SIZE);
+	arg_set_int64(tree, index, value);
+	return index;
+}
+
+
+struct tree_span
+{
+	uint8_t *data;			/**< Encoded spans */
+	size_t size;			/**< Number of used bytes */
+	size_t size_alloc;		/**< Allocated number of bytes */
+
+	size_t amount;			/**< Number of encoded slots */
+	size_t begin;			/**< Begin of the last encoded span */
+};
+
+/*
+ *	Span slot of node is its index divided by minimal node size, slots are grouped in blocks.
+ *	Every slot is encoded in block as varint of zigzag length plus one or zero for empty slot,
+ *	then varint of zigzag difference between span begin and the previous one in the same block.
+ *	Nodes are usually created in source order, so both numbers take one or two bytes.
+ */
+
+static inline uint64_t zigzag_encode(const int64_t value)
+{
+	return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline int64_t zigzag_decode(const uint64_t value)
+{
+	return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static int span_write(tree_span *const block, uint64_t value)
+{
+	// Varint takes at most 10 bytes
+	if (block->size + 10 > block->size_alloc)
+	{
+		const size_t alloc_new = block->size_alloc != 0 ? 2 * block->size_alloc : TREE_SPAN_BYTES_SIZE;
+		uint8_t *data_new = realloc(block->data, alloc_new);
+		if (data_new == NULL)
+		{
+			return -1;
+		}
+
+		block->size_alloc = alloc_new;
+		block->data = data_new;
+	}
+
+	do
+	{
+		const uint8_t byte = value & 0x7F;
+		value >>= 7;
+		block->data[block->size++] = value != 0 ? byte | 0x80 : byte;
+	} while (value != 0);
+
+	return 0;
+}
+
+static uint64_t span_read(const tree_span *const block, size_t *const position)
+{
+	uint64_t value = 0;
+	for (size_t shift = 0; *position < block->size; shift += 7)
+	{
+		const uint8_t byte = block->data[(*position)++];
+		value |= (uint64_t)(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+		{
+			break;
+		}
+	}
+
+	return value;
+}
+
+static int span_append(tree_span *const block, const bool has_span, const size_t begin, const size_t end)
+{
+	block->amount++;
+	if (!has_span)
+	{
+		return span_write(block, 0);
+	}
+
+	const int64_t length = (int64_t)(end - begin);
+	const int64_t delta = (int64_t)(begin - block->begin);
+	block->begin = begin;
+
+	return span_write(block, zigzag_encode(length) + 1) || span_write(block, zigzag_encode(delta));
+}
+
+static bool span_decode(const tree_span *const block, size_t *const position, size_t *const prev
+	, size_t *const begin, size_t *const end)
+{
+	const uint64_t length = span_read(block, position);
+	if (length == 0)
+	{
+		return false;
+	}
+
+	*begin = *prev + (size_t)zigzag_decode(span_read(block, position));
+	*end = *begin + (size_t)zigzag_decode(length - 1);
+	*prev = *begin;
+	return true;
+}
+
+static int span_get(const tree_table *const tree, const size_t index, size_t *const begin, size_t *const end)
+{
+	const size_t slot = index / TREE_NODE_MIN_SIZE;
+	const size_t number = slot / TREE_SPAN_BLOCK_SIZE;
+	const size_t offset = slot % TREE_SPAN_BLOCK_SIZE;
+	if (number >= tree->spans_size || offset >= tree->spans[number].amount)
+	{
+		return -1;
+	}
+
+	size_t position = 0;
+	size_t prev = 0;
+	for (size_t i = 0; i < offset; i++)
+	{
+		size_t skipped_begin;
+		size_t skipped_end;
+		span_decode(&tree->spans[number], &position, &prev, &skipped_begin, &skipped_end);
+	}
+
+	return span_decode(&tree->spans[number], &position, &prev, begin, end) ? 0 : -1;
+}
+
+static int span_set(tree_table *const tree, const size_t index, const bool has_span, const size_t begin, const size_t end)
+{
+	const size_t slot = index / TREE_NODE_MIN_SIZE;
+	const size_t number = slot / TREE_SPAN_BLOCK_SIZE;
+	const size_t offset = slot % TREE_SPAN_BLOCK_SIZE;
+
+	if (number >= tree->spans_size)
+	{
+		if (!has_span)
+		{
+			return 0;
+		}
+
+		const size_t size_new = number + 1 > 2 * tree->spans_size ? number + 1 : 2 * tree->spans_size;
+		tree_span *spans_new = realloc(tree->spans, size_new * sizeof(tree_span));
+		if (spans_new == NULL)
+		{
+			return -1;
+		}
+
+		memset(&spans_new[tree->spans_size], 0, (size_new - tree->spans_size) * sizeof(tree_span));
+		tree->spans_size = size_new;
+		tree->spans = spans_new;
+	}
+
+	tree_span *const block = &tree->spans[number];
+	if (offset >= block->amount)
+	{
+		if (!has_span)
+		{
+			return 0;
+		}
+
+		while (block->amount < offset)
+		{
+			if (span_append(block, false, 0, 0))
+			{
+				return -1;
+			}
+		}
+
+		return span_append(block, true, begin, end);
+	}
+
+	// Block is decoded and written again with the changed slot
+	bool has[TREE_SPAN_BLOCK_SIZE];
+	size_t begins[TREE_SPAN_BLOCK_SIZE];
+	size_t ends[TREE_SPAN_BLOCK_SIZE];
+
+	const size_t amount = block->amount;
+	size_t position = 0;
+	size_t prev = 0;
+	for (size_t i = 0; i < amount; i++)
+	{
+		has[i] = span_decode(block, &position, &prev, &begins[i], &ends[i]);
+	}
+
+	has[offset] = has_span;
+	begins[offset] = begin;
+	ends[offset] = end;
+
+	block->size = 0;
+	block->amount = 0;
+	block->begin = 0;
+	for (size_t i = 0; i < amount; i++)
+	{
+		if (span_append(block, has[i], begins[i], ends[i]))
+		{
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static inline void span_copy(tree_table *const dest, const size_t dest_index
+	, const tree_table *const src, const size_t src_index)
+{
+	size_t begin;
+	size_t end;
+	if (!span_get(src, src_index, &begin, &end))
+	{
+		span_set(dest, dest_index, true, begin, end);
+	}
+}
+
+
+struct tree_cursor
 {
-	const item_t temp = vector_get(vec, fst);
-	vector_set(vec, fst, vector_get(vec, snd));
-	vector_set(vec, snd, temp);
+	size_t parent;			/**< Index of parent node */
+	size_t number;			/**< Number of the last requested child */
+	size_t child;			/**< Index of the last requested child */
+};
+
+/*
+ *	Cursors keep the last requested child of several parents, so sequential access is constant.
+ *	Traversals are recursive, so cursor of the parent with the least remaining children is reused.
+ */
+
+static inline size_t cursor_remaining(const tree_table *const tree, const tree_cursor *const cursor)
+{
+	const size_t amount = (size_t)cell_get(tree, cursor->parent);
+	return amount > cursor->number ? amount - cursor->number : 0;
 }
 
+static tree_cursor *cursor_get(tree_table *const tree, const size_t parent)
+{
+	if (tree->cursors == NULL)
+	{
+		return NULL;
+	}
+
+	for (size_t i = 0; i < tree->cursors_size; i++)
+	{
+		if (tree->cursors[i].parent == parent)
+		{
+			return &tree->cursors[i];
+		}
+	}
+
+	if (tree->cursors_size < TREE_CURSORS_SIZE)
+	{
+		tree_cursor *const cursor = &tree->cursors[tree->cursors_size++];
+		cursor->parent = SIZE_MAX;
+		return cursor;
+	}
+
+	tree_cursor *cursor = &tree->cursors[0];
+	for (size_t i = 1; i < TREE_CURSORS_SIZE; i++)
+	{
+		if (cursor_remaining(tree, &tree->cursors[i]) < cursor_remaining(tree, cursor))
+		{
+			cursor = &tree->cursors[i];
+		}
+	}
+
+	cursor->parent = SIZE_MAX;
+	return cursor;
+}
+
+static inline void cursors_reset(tree_table *const tree)
+{
+	tree->cursors_size = 0;
+}
+
+
+/*
+ *	Node is stored in tree table as:
+ *	next, type, amount, children, parent, prev, argc, args...
+ *	where node index is the index of amount. The last child refers to parent by negative next,
+ *	the first child refers to the last one by prev, so the last child is found without own cell.
+ */
 
 static inline size_t ref_get_next(const node *const nd)
 {
@@ -56,30 +506,61 @@ static inline size_t ref_get_children(const node *const nd)
 	return nd->index + 1;
 }
 
-static inline size_t ref_get_argc(const node *const nd)
+static inline size_t ref_get_parent(const node *const nd)
 {
 	return nd->index + 2;
 }
 
+static inline size_t ref_get_prev(const node *const nd)
+{
+	return nd->index + 3;
+}
+
+static inline size_t ref_get_last(const node *const nd)
+{
+	const node first = { nd->tree, (size_t)cell_get(nd->tree, ref_get_children(nd)) };
+	return ref_get_prev(&first);
+}
+
+static inline size_t ref_get_argc(const node *const nd)
+{
+	return nd->index + 4;
+}
+
 
 static inline int ref_set_next(const node *const nd, const item_t value)
 {
-	return vector_set(nd->tree, ref_get_next(nd), value);
+	return cell_set(nd->tree, ref_get_next(nd), value);
 }
 
 static inline int ref_set_amount(const node *const nd, const item_t value)
 {
-	return vector_set(nd->tree, ref_get_amount(nd), value);
+	return cell_set(nd->tree, ref_get_amount(nd), value);
 }
 
 static inline int ref_set_children(const node *const nd, const item_t value)
 {
-	return vector_set(nd->tree, ref_get_children(nd), value);
+	return cell_set(nd->tree, ref_get_children(nd), value);
+}
+
+static inline int ref_set_last(const node *const nd, const item_t value)
+{
+	return cell_set(nd->tree, ref_get_last(nd), value);
+}
+
+static inline int ref_set_parent(const node *const nd, const item_t value)
+{
+	return cell_set(nd->tree, ref_get_parent(nd), value);
+}
+
+static inline int ref_set_prev(const node *const nd, const item_t value)
+{
+	return cell_set(nd->tree, ref_get_prev(nd), value);
 }
 
 static inline int ref_set_argc(const node *const nd, const item_t value)
 {
-	return vector_set(nd->tree, ref_get_argc(nd), value);
+	return cell_set(nd->tree, ref_get_argc(nd), value);
 }
 
 
@@ -90,28 +571,64 @@ static inline node node_broken()
 }
 
 
-static node node_search_parent(const node *const nd, size_t *const number)
+/** Get reference to the node from parent or previous sibling */
+static inline size_t node_get_forward_ref(const node *const parent, const node *const nd)
 {
-	if (!node_is_correct(nd) || nd->index == 0)
-	{
-		return node_broken();
-	}
+	const size_t prev = (size_t)cell_get(nd->tree, ref_get_prev(nd));
+	return (size_t)cell_get(nd->tree, ref_get_children(parent)) == nd->index ? ref_get_children(parent) : prev - 2;
+}
+
+/** Get reference to the node from next sibling or the first child, if node is the last */
+static inline size_t node_get_backward_ref(const node *const parent, const node *const nd)
+{
+	const item_t next = cell_get(nd->tree, ref_get_next(nd));
+	return is_negative(next) || next == 0 ? ref_get_last(parent) : (size_t)next + 3;
+}
 
-	size_t child_number = 1;
-	item_t index = vector_get(nd->tree, ref_get_next(nd));
-	while (!is_negative(index) && index != 0)
+/** Remove node from children of its parent, node cells are kept */
+static void node_unlink(const node *const parent, const node *const nd)
+{
+	const size_t amount = node_get_amount(parent) - 1;
+	if (amount != 0)
 	{
-		index = vector_get(nd->tree, (size_t)index - 2);
-		child_number++;
+		const size_t forward = node_get_forward_ref(parent, nd);
+		const size_t backward = node_get_backward_ref(parent, nd);
+		cell_set(nd->tree, forward, cell_get(nd->tree, ref_get_next(nd)));
+		cell_set(nd->tree, backward, cell_get(nd->tree, ref_get_prev(nd)));
 	}
 
-	node parent = { nd->tree, from_negative(index) };
-	if (number != NULL)
+	ref_set_amount(parent, (item_t)amount);
+	cursors_reset(nd->tree);
+}
+
+/** Get number of cells of the node with its subtree */
+static size_t node_get_cells(const node *const nd)
+{
+	size_t cells = 0;
+	node current = *nd;
+	do
 	{
-		*number = node_get_amount(&parent) - child_number;
-	}
+		cells += TREE_NODE_MIN_SIZE + node_get_argc(&current);
+		if (node_get_amount(&current) != 0)
+		{
+			current.index = (size_t)cell_get(current.tree, ref_get_children(&current));
+			continue;
+		}
 
-	return parent;
+		while (current.index != nd->index)
+		{
+			const item_t next = cell_get(current.tree, ref_get_next(&current));
+			if (!is_negative(next) && next != 0)
+			{
+				current.index = (size_t)next;
+				break;
+			}
+
+			current.index = from_negative(next);
+		}
+	} while (current.index != nd->index);
+
+	return cells;
 }
 
 
@@ -124,14 +641,14 @@ static node node_search_parent(const node *const nd, size_t *const number)
  */
 
 
-node node_get_root(vector *const tree)
+node node_get_root(tree_table *const tree)
 {
-	const size_t size = vector_size(tree);
+	const size_t size = cells_size(tree);
 	if (size == 0)
 	{
-		vector_increase(tree, 3);
+		cells_resize_by(tree, 5);
 	}
-	else if (size == SIZE_MAX || size < 3 || vector_get(tree, 2) < 0)
+	else if (size == SIZE_MAX || size < 5 || cell_get(tree, 4) < 0)
 	{
 		return node_broken();
 	}
@@ -142,15 +659,37 @@ node node_get_root(vector *const tree)
 
 node node_get_child(const node *const nd, const size_t index)
 {
-	if (!node_is_correct(nd) || index >= node_get_amount(nd))
+	const size_t amount = node_get_amount(nd);
+	if (!node_is_correct(nd) || index >= amount)
 	{
 		return node_broken();
 	}
 
-	size_t child_index = (size_t)vector_get(nd->tree, ref_get_children(nd));
-	for (size_t i = 0; i < index; i++)
+	if (index == amount - 1)
+	{
+		node child = { nd->tree, (size_t)cell_get(nd->tree, ref_get_last(nd)) };
+		return child;
+	}
+
+	size_t number = 0;
+	size_t child_index = (size_t)cell_get(nd->tree, ref_get_children(nd));
+	tree_cursor *const cursor = index >= TREE_CURSOR_DISTANCE ? cursor_get(nd->tree, nd->index) : NULL;
+	if (cursor != NULL && cursor->parent == nd->index && cursor->number <= index)
+	{
+		number = cursor->number;
+		child_index = cursor->child;
+	}
+
+	for (; number < index; number++)
+	{
+		child_index = (size_t)cell_get(nd->tree, child_index - 2);
+	}
+
+	if (cursor != NULL)
 	{
-		child_index = (size_t)vector_get(nd->tree, child_index - 2);
+		cursor->parent = nd->index;
+		cursor->number = index;
+		cursor->child = child_index;
 	}
 
 	node child = { nd->tree, child_index };
@@ -159,38 +698,44 @@ node node_get_child(const node *const nd, const size_t index)
 
 node node_get_parent(const node *const nd)
 {
-	return node_search_parent(nd, NULL);
+	if (!node_is_correct(nd) || nd->index == 0)
+	{
+		return node_broken();
+	}
+
+	node parent = { nd->tree, (size_t)cell_get(nd->tree, ref_get_parent(nd)) };
+	return parent;
 }
 
 
 item_t node_get_type(const node *const nd)
 {
-	return node_is_correct(nd) && nd->index != 0 ? vector_get(nd->tree, nd->index - 1) : ITEM_MAX;
+	return node_is_correct(nd) && nd->index != 0 ? cell_get(nd->tree, nd->index - 1) : ITEM_MAX;
 }
 
 size_t node_get_argc(const node *const nd)
 {
-	return node_is_correct(nd) ? (size_t)vector_get(nd->tree, ref_get_argc(nd)) : 0;
+	return node_is_correct(nd) ? (size_t)cell_get(nd->tree, ref_get_argc(nd)) : 0;
 }
 
 item_t node_get_arg(const node *const nd, const size_t index)
 {
-	return index < node_get_argc(nd) ? vector_get(nd->tree, ref_get_argc(nd) + 1 + index) : ITEM_MAX;
+	return index < node_get_argc(nd) ? arg_get(nd->tree, ref_get_argc(nd) + 1 + index) : ITEM_MAX;
 }
 
 double node_get_arg_double(const node *const nd, const size_t index)
 {
-	return index + DOUBLE_SIZE <= node_get_argc(nd) ? vector_get_double(nd->tree, ref_get_argc(nd) + 1 + index) : DBL_MAX;
+	return index + DOUBLE_SIZE <= node_get_argc(nd) ? arg_get_double(nd->tree, ref_get_argc(nd) + 1 + index) : DBL_MAX;
 }
 
 int64_t node_get_arg_int64(const node *const nd, const size_t index)
 {
-	return index + INT64_SIZE <= node_get_argc(nd) ? vector_get_int64(nd->tree, ref_get_argc(nd) + 1 + index) : LLONG_MAX;
+	return index + INT64_SIZE <= node_get_argc(nd) ? arg_get_int64(nd->tree, ref_get_argc(nd) + 1 + index) : LLONG_MAX;
 }
 
 size_t node_get_amount(const node *const nd)
 {
-	return node_is_correct(nd) ? (size_t)vector_get(nd->tree, ref_get_amount(nd)) : 0;
+	return node_is_correct(nd) ? (size_t)cell_get(nd->tree, ref_get_amount(nd)) : 0;
 }
 
 
@@ -201,15 +746,15 @@ node node_get_next(const node *const nd)
 		return node_broken();
 	}
 
-	node next = { nd->tree, (size_t)vector_get(nd->tree, ref_get_children(nd)) };
+	node next = { nd->tree, (size_t)cell_get(nd->tree, ref_get_children(nd)) };
 
 	if (node_get_amount(nd) == 0)
 	{
-		item_t index = vector_get(nd->tree, ref_get_next(nd));
+		item_t index = cell_get(nd->tree, ref_get_next(nd));
 		while (is_negative(index))
 		{
 			// Get next reference from parent
-			index = vector_get(nd->tree, from_negative(index) - 2);
+			index = cell_get(nd->tree, from_negative(index) - 2);
 		}
 
 		next.index = (size_t)index;
@@ -238,13 +783,15 @@ node node_add_child(const node *const nd, const item_t type)
 		return node_broken();
 	}
 
-	vector_add(nd->tree, to_negative(nd->index));
-	vector_add(nd->tree, type);
-	node child = { nd->tree, vector_add(nd->tree, 0) };
-	vector_increase(nd->tree, 2);
-
 	const size_t amount = node_get_amount(nd);
-	ref_set_amount(nd, (item_t)(amount + 1));
+	const item_t last = amount != 0 ? cell_get(nd->tree, ref_get_last(nd)) : 0;
+
+	cell_add(nd->tree, to_negative(nd->index));
+	cell_add(nd->tree, type);
+	node child = { nd->tree, cell_add(nd->tree, 0) };
+	cells_resize_by(nd->tree, 4);	// New elements set by zero
+	ref_set_parent(&child, (item_t)nd->index);
+	ref_set_prev(&child, last);
 
 	if (amount == 0)
 	{
@@ -252,10 +799,11 @@ node node_add_child(const node *const nd, const item_t type)
 	}
 	else
 	{
-		node prev = node_get_child(nd, amount - 1);
-		ref_set_next(&prev, (item_t)child.index);
+		cell_set(nd->tree, (size_t)last - 2, (item_t)child.index);
 	}
 
+	ref_set_amount(nd, (item_t)(amount + 1));
+	ref_set_last(nd, (item_t)child.index);
 	return child;
 }
 
@@ -271,7 +819,7 @@ int node_set_type(const node *const nd, const item_t type)
 		return -2;
 	}
 
-	return vector_set(nd->tree, nd->index - 1, type);
+	return cell_set(nd->tree, nd->index - 1, type);
 }
 
 int node_add_arg(const node *const nd, const item_t arg)
@@ -286,7 +834,7 @@ int node_add_arg(const node *const nd, const item_t arg)
 		return -2;
 	}
 	
-	vector_add(nd->tree, arg);
+	arg_add(nd->tree, arg);
 	ref_set_argc(nd, (item_t)node_get_argc(nd) + 1);
 
 	return 0;
@@ -304,7 +852,7 @@ int node_add_arg_double(const node *const nd, const double arg)
 		return -2;
 	}
 	
-	vector_add_double(nd->tree, arg);
+	arg_add_double(nd->tree, arg);
 	ref_set_argc(nd, (item_t)(node_get_argc(nd) + DOUBLE_SIZE));
 
 	return 0;
@@ -322,7 +870,7 @@ int node_add_arg_int64(const node *const nd, const int64_t arg)
 		return -2;
 	}
 	
-	vector_add_int64(nd->tree, arg);
+	arg_add_int64(nd->tree, arg);
 	ref_set_argc(nd, (item_t)(node_get_argc(nd) + INT64_SIZE));
 
 	return 0;
@@ -335,7 +883,7 @@ int node_set_arg(const node *const nd, const size_t index, const item_t arg)
 		return -1;
 	}
 
-	return vector_set(nd->tree, ref_get_argc(nd) + 1 + index, arg);
+	return arg_set(nd->tree, ref_get_argc(nd) + 1 + index, arg);
 }
 
 size_t node_set_arg_double(const node *const nd, const size_t index, const double arg)
@@ -345,7 +893,7 @@ size_t node_set_arg_double(const node *const nd, const size_t index, const doubl
 		return SIZE_MAX;
 	}
 
-	return vector_set_double(nd->tree, ref_get_argc(nd) + 1 + index, arg);
+	return arg_set_double(nd->tree, ref_get_argc(nd) + 1 + index, arg);
 }
 
 size_t node_set_arg_int64(const node *const nd, const size_t index, const int64_t arg)
@@ -355,7 +903,22 @@ size_t node_set_arg_int64(const node *const nd, const size_t index, const int64_
 		return SIZE_MAX;
 	}
 
-	return vector_set_int64(nd->tree, ref_get_argc(nd) + 1 + index, arg);
+	return arg_set_int64(nd->tree, ref_get_argc(nd) + 1 + index, arg);
+}
+
+int node_get_span(const node *const nd, size_t *const begin, size_t *const end)
+{
+	if (!node_is_correct(nd) || begin == NULL || end == NULL)
+	{
+		return -1;
+	}
+
+	return span_get(nd->tree, nd->index, begin, end);
+}
+
+int node_set_span(const node *const nd, const size_t begin, const size_t end)
+{
+	return node_is_correct(nd) ? span_set(nd->tree, nd->index, true, begin, end) : -1;
 }
 
 
@@ -377,9 +940,9 @@ size_t node_save(const node *const nd)
 		: SIZE_MAX;
 }
 
-node node_load(vector *const tree, const size_t index)
+node node_load(tree_table *const tree, const size_t index)
 {
-	if (!vector_is_correct(tree) || vector_get(tree, index + 2) >= (item_t)(vector_size(tree) - index - 2))
+	if (!tree_is_correct(tree) || cell_get(tree, index + 4) >= (item_t)(tree->size - index - 4))
 	{
 		return node_broken();
 	}
@@ -390,33 +953,31 @@ node node_load(vector *const tree, const size_t index)
 
 node node_insert(const node *const nd, const item_t type, const size_t argc)
 {
-	size_t index;
-	node parent = node_search_parent(nd, &index);
+	node parent = node_get_parent(nd);
 	if (!node_is_correct(&parent))
 	{
 		return node_broken();
 	}
 
-	size_t reference;
-	if (index == 0)
-	{
-		reference = ref_get_children(&parent);
-	}
-	else
-	{
-		const node prev = node_get_child(&parent, index - 1);
-		reference = ref_get_next(&prev);
-	}
-
-	vector_add(nd->tree, vector_get(nd->tree, ref_get_next(nd)));
-	vector_add(nd->tree, type);
-	node child = { nd->tree, vector_add(nd->tree, 1) };
-	vector_add(nd->tree, (item_t)nd->index);
-	vector_add(nd->tree, (item_t)argc);
-	vector_increase(nd->tree, argc);
-
-	vector_set(nd->tree, reference, (item_t)child.index);
+	const size_t forward = node_get_forward_ref(&parent, nd);
+	const size_t backward = node_get_backward_ref(&parent, nd);
+	const item_t prev = cell_get(nd->tree, ref_get_prev(nd));
+
+	cell_add(nd->tree, cell_get(nd->tree, ref_get_next(nd)));
+	cell_add(nd->tree, type);
+	node child = { nd->tree, cell_add(nd->tree, 1) };
+	cell_add(nd->tree, (item_t)nd->index);
+	cell_add(nd->tree, (item_t)parent.index);
+	cell_add(nd->tree, prev != (item_t)nd->index ? prev : (item_t)child.index);
+	cell_add(nd->tree, (item_t)argc);
+	cells_resize_by(nd->tree, argc);
+
+	cell_set(nd->tree, forward, (item_t)child.index);
+	cell_set(nd->tree, backward, (item_t)child.index);
 	ref_set_next(nd, to_negative(child.index));
+	ref_set_parent(nd, (item_t)child.index);
+	ref_set_prev(nd, (item_t)nd->index);
+	cursors_reset(nd->tree);
 	return child;
 }
 
@@ -427,10 +988,17 @@ int node_order(const node *const fst, const node *const snd)
 		return -1;
 	}
 
-	vector_swap(fst->tree, ref_get_amount(fst), ref_get_amount(snd));
-	vector_swap(fst->tree, ref_get_children(fst), ref_get_children(snd));
+	cell_swap(fst->tree, ref_get_amount(fst), ref_get_amount(snd));
+	cell_swap(fst->tree, ref_get_children(fst), ref_get_children(snd));
+	cursors_reset(fst->tree);
 
 	const size_t fst_amount = node_get_amount(fst);
+	for (size_t i = 0; i < fst_amount; i++)
+	{
+		const node child = node_get_child(fst, i);
+		ref_set_parent(&child, (item_t)fst->index);
+	}
+
 	if (fst_amount != 0)
 	{
 		const node child = node_get_child(fst, fst_amount - 1);
@@ -438,6 +1006,12 @@ int node_order(const node *const fst, const node *const snd)
 	}
 
 	const size_t snd_amount = node_get_amount(snd);
+	for (size_t i = 0; i < snd_amount; i++)
+	{
+		const node child = node_get_child(snd, i);
+		ref_set_parent(&child, (item_t)snd->index);
+	}
+
 	if (snd_amount != 0)
 	{
 		const node child = node_get_child(snd, snd_amount - 1);
@@ -449,74 +1023,148 @@ int node_order(const node *const fst, const node *const snd)
 
 int node_swap(const node *const fst, const node *const snd)
 {
-	size_t fst_index = 0;
-	const node fst_parent = node_search_parent(fst, &fst_index);
-
-	size_t snd_index = 0;
-	const node snd_parent = node_search_parent(snd, &snd_index);
+	const node fst_parent = node_get_parent(fst);
+	const node snd_parent = node_get_parent(snd);
 
 	if (!node_is_correct(&fst_parent) || !node_is_correct(&snd_parent) || fst->tree != snd->tree)
 	{
 		return -1;
 	}
 
-	vector *const tree = fst->tree;
-	if (fst_index == 0 && snd_index == 0)
-	{
-		vector_swap(tree, ref_get_children(&fst_parent), ref_get_children(&snd_parent));
-	}
-	else if (fst_index == 0)	// && snd_index != 0
+	// All references are found before changes, so neighbouring nodes are swapped too
+	tree_table *const tree = fst->tree;
+	const size_t fst_forward = node_get_forward_ref(&fst_parent, fst);
+	const size_t snd_forward = node_get_forward_ref(&snd_parent, snd);
+	const size_t fst_backward = node_get_backward_ref(&fst_parent, fst);
+	const size_t snd_backward = node_get_backward_ref(&snd_parent, snd);
+
+	cell_swap(tree, fst_forward, snd_forward);
+	cell_swap(tree, fst_backward, snd_backward);
+	cell_swap(tree, ref_get_next(fst), ref_get_next(snd));
+	cell_swap(tree, ref_get_prev(fst), ref_get_prev(snd));
+	cell_swap(tree, ref_get_parent(fst), ref_get_parent(snd));
+
+	cursors_reset(tree);
+	return 0;
+}
+
+int node_move(const node *const nd, const node *const parent)
+{
+	const node prev_parent = node_get_parent(nd);
+	if (!node_is_correct(&prev_parent) || !node_is_correct(parent) || nd->tree != parent->tree)
 	{
-		const node snd_prev = node_get_child(&snd_parent, snd_index - 1);
-		vector_swap(tree, ref_get_children(&fst_parent), ref_get_next(&snd_prev));
+		return -1;
 	}
-	else if (snd_index == 0)	// && fst_index != 0
+
+	node_unlink(&prev_parent, nd);
+
+	const size_t amount = node_get_amount(parent);
+	const item_t last = amount != 0 ? cell_get(nd->tree, ref_get_last(parent)) : 0;
+	if (amount == 0)
 	{
-		const node fst_prev = node_get_child(&fst_parent, fst_index - 1);
-		vector_swap(tree, ref_get_next(&fst_prev), ref_get_children(&snd_parent));
+		ref_set_children(parent, (item_t)nd->index);
 	}
-	else						// fst_index != 0 && snd_index != 0
+	else
 	{
-		const node fst_prev = node_get_child(&fst_parent, fst_index - 1);
-		const node snd_prev = node_get_child(&snd_parent, snd_index - 1);
-		vector_swap(tree, ref_get_next(&fst_prev), ref_get_next(&snd_prev));
+		cell_set(nd->tree, (size_t)last - 2, (item_t)nd->index);
 	}
 
-	vector_swap(tree, ref_get_next(fst), ref_get_next(snd));
+	ref_set_next(nd, to_negative(parent->index));
+	ref_set_prev(nd, last);
+	ref_set_parent(nd, (item_t)parent->index);
+
+	ref_set_amount(parent, (item_t)(amount + 1));
+	ref_set_last(parent, (item_t)nd->index);
 	return 0;
 }
 
-int node_remove(node *const nd)
+node node_replace(const node *const nd, const item_t type, const size_t argc)
 {
-	size_t index;
-	node parent = node_search_parent(nd, &index);
-	if (!node_is_correct(&parent))
+	if (!node_is_correct(nd) || nd->index == 0)
 	{
-		return -1;
+		return node_broken();
 	}
 
-	if (index == 0)
+	const size_t prev_argc = node_get_argc(nd);
+	const bool is_last = ref_get_argc(nd) + prev_argc == cells_size(nd->tree) - 1;
+	if (argc <= prev_argc || is_last)
 	{
-		ref_set_amount(&parent, (item_t)node_get_amount(&parent) - 1);
+		if (is_last)
+		{
+			cells_resize(nd->tree, ref_get_argc(nd) + 1 + argc);
+		}
+		else
+		{
+			nd->tree->garbage += prev_argc - argc;
+		}
 
-		if (node_get_amount(&parent) != 0)
+		for (size_t i = 0; i < argc; i++)
 		{
-			ref_set_children(&parent, vector_get(nd->tree, ref_get_next(nd)));
+			cell_set(nd->tree, ref_get_argc(nd) + 1 + i, 0);
 		}
+
+		node_set_type(nd, type);
+		ref_set_argc(nd, (item_t)argc);
+		return *nd;
 	}
-	else
+
+	// Node is moved to the end of tree table, its children are not copied
+	const node parent = node_get_parent(nd);
+	const size_t forward = node_get_forward_ref(&parent, nd);
+	const size_t backward = node_get_backward_ref(&parent, nd);
+	const item_t prev = cell_get(nd->tree, ref_get_prev(nd));
+
+	cell_add(nd->tree, cell_get(nd->tree, ref_get_next(nd)));
+	cell_add(nd->tree, type);
+	const node result = { nd->tree, cell_add(nd->tree, cell_get(nd->tree, ref_get_amount(nd))) };
+	cell_add(nd->tree, cell_get(nd->tree, ref_get_children(nd)));
+	cell_add(nd->tree, (item_t)parent.index);
+	cell_add(nd->tree, prev != (item_t)nd->index ? prev : (item_t)result.index);
+	cell_add(nd->tree, (item_t)argc);
+	cells_resize_by(nd->tree, argc);
+
+	cell_set(nd->tree, forward, (item_t)result.index);
+	cell_set(nd->tree, backward, (item_t)result.index);
+	cursors_reset(nd->tree);
+
+	const size_t amount = node_get_amount(&result);
+	for (size_t i = 0; i < amount; i++)
 	{
-		*nd = node_get_child(&parent, index - 1);
-		const size_t reference = (size_t)vector_get(nd->tree, ref_get_next(nd));
-		ref_set_next(nd, vector_get(nd->tree, reference - 2));
+		const node child = node_get_child(&result, i);
+		ref_set_parent(&child, (item_t)result.index);
+	}
 
-		nd->index = reference;
-		ref_set_amount(&parent, (item_t)node_get_amount(&parent) - 1);
+	if (amount != 0)
+	{
+		const node child = node_get_child(&result, amount - 1);
+		ref_set_next(&child, to_negative(result.index));
 	}
 
-	if (node_get_amount(nd) == 0 && (ref_get_argc(nd) + node_get_argc(nd)) == vector_size(nd->tree) - 1)
+	span_copy(nd->tree, result.index, nd->tree, nd->index);
+	span_set(nd->tree, nd->index, false, 0, 0);
+	nd->tree->garbage += TREE_NODE_MIN_SIZE + prev_argc;
+	return result;
+}
+
+int node_remove(node *const nd)
+{
+	node parent = node_get_parent(nd);
+	if (!node_is_correct(&parent))
 	{
-		vector_resize(nd->tree, ref_get_next(nd));
+		return -1;
+	}
+
+	node_unlink(&parent, nd);
+
+	if (node_get_amount(nd) == 0 && (ref_get_argc(nd) + node_get_argc(nd)) == cells_size(nd->tree) - 1)
+	{
+		// Index will be reused by the next node
+		span_set(nd->tree, nd->index, false, 0, 0);
+		cells_resize(nd->tree, ref_get_next(nd));
+	}
+	else
+	{
+		nd->tree->garbage += node_get_cells(nd);
 	}
 
 	*nd = node_broken();
@@ -525,5 +1173,140 @@ int node_remove(node *const nd)
 
 bool node_is_correct(const node *const nd)
 {
-	return nd != NULL && vector_is_correct(nd->tree) && nd->index != SIZE_MAX;
+	return nd != NULL && tree_is_correct(nd->tree) && nd->index != SIZE_MAX;
+}
+
+
+tree_table tree_create(const size_t alloc)
+{
+	tree_table tree;
+
+	tree.size = 0;
+	tree.size_alloc = alloc != 0 ? alloc : 1;
+	tree.cells = malloc(tree.size_alloc * sizeof(int32_t));
+	tree.values = vector_create(TREE_VALUES_SIZE);
+
+	tree.spans = NULL;
+	tree.spans_size = 0;
+
+	tree.cursors = malloc(TREE_CURSORS_SIZE * sizeof(tree_cursor));
+	tree.cursors_size = 0;
+
+	tree.garbage = 0;
+	return tree;
+}
+
+size_t tree_size(const tree_table *const tree)
+{
+	if (!tree_is_correct(tree))
+	{
+		return 0;
+	}
+
+	size_t size = tree->size * sizeof(int32_t) + vector_size(&tree->values) * sizeof(item_t);
+	for (size_t i = 0; i < tree->spans_size; i++)
+	{
+		size += sizeof(tree_span) + tree->spans[i].size;
+	}
+
+	return size;
+}
+
+bool tree_is_correct(const tree_table *const tree)
+{
+	return tree != NULL && tree->cells != NULL && vector_is_correct(&tree->values);
+}
+
+size_t tree_compact(tree_table *const tree)
+{
+	node prev = node_get_root(tree);
+	if (!node_is_correct(&prev))
+	{
+		return SIZE_MAX;
+	}
+
+	if (tree->garbage == 0)
+	{
+		return 0;
+	}
+
+	tree_table compacted = tree_create(tree->size - tree->garbage);
+	const node root = node_get_root(&compacted);
+	for (size_t i = 0; i < node_get_argc(&prev); i++)
+	{
+		node_add_arg(&root, node_get_arg(&prev, i));
+	}
+
+	span_copy(&compacted, root.index, tree, prev.index);
+
+	// Path from root to the current node as pairs of previous and new indexes
+	vector path = vector_create(2 * TREE_PATH_SIZE);
+	vector_add(&path, 0);
+	vector_add(&path, 0);
+
+	while (!node_set_next(&prev))
+	{
+		const item_t parent = cell_get(tree, ref_get_parent(&prev));
+		while (vector_get(&path, vector_size(&path) - 2) != parent)
+		{
+			vector_remove(&path);
+			vector_remove(&path);
+		}
+
+		const node new_parent = { &compacted, (size_t)vector_get(&path, vector_size(&path) - 1) };
+		const node nd = node_add_child(&new_parent, node_get_type(&prev));
+
+		const size_t argc = node_get_argc(&prev);
+		for (size_t i = 0; i < argc; i++)
+		{
+			arg_add(&compacted, arg_get(tree, ref_get_argc(&prev) + 1 + i));
+		}
+
+		ref_set_argc(&nd, (item_t)argc);
+		span_copy(&compacted, nd.index, tree, prev.index);
+		vector_add(&path, (item_t)prev.index);
+		vector_add(&path, (item_t)nd.index);
+	}
+
+	vector_clear(&path);
+
+	// Values and spans are not reused, so rewritten table may be larger
+	const size_t size = tree_size(tree);
+	const size_t compacted_size = tree_size(&compacted);
+	if (compacted_size >= size)
+	{
+		tree_clear(&compacted);
+		return 0;
+	}
+
+	tree_clear(tree);
+	*tree = compacted;
+	return size - compacted_size;
+}
+
+
+int tree_clear(tree_table *const tree)
+{
+	if (!tree_is_correct(tree))
+	{
+		return -1;
+	}
+
+	free(tree->cells);
+	tree->cells = NULL;
+
+	for (size_t i = 0; i < tree->spans_size; i++)
+	{
+		free(tree->spans[i].data);
+	}
+
+	free(tree->spans);
+	tree->spans = NULL;
+	tree->spans_size = 0;
+
+	free(tree->cursors);
+	tree->cursors = NULL;
+	tree->cursors_size = 0;
+
+	return vector_clear(&tree->values);
 }
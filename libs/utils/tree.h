@@ -23,10 +23,40 @@
 extern "C" {
 #endif
 
+/** Block of node spans */
+typedef struct tree_span tree_span;
+
+/** Cursor of children access */
+typedef struct tree_cursor tree_cursor;
+
+/**
+ *	Tree table.
+ *	Nodes are stored in 32-bit cells independently of item size,
+ *	arguments, which do not fit in cell, are placed in values table.
+ *	Source spans of nodes are kept apart in delta encoded blocks.
+ *	Children access moves cursors of table, so table is read by one thread at a time.
+ */
+typedef struct tree_table
+{
+	int32_t *cells;			/**< Cells of nodes */
+	size_t size;			/**< Number of used cells */
+	size_t size_alloc;		/**< Allocated number of cells */
+
+	vector values;			/**< Values table of wide arguments */
+
+	tree_span *spans;		/**< Blocks of node spans */
+	size_t spans_size;		/**< Number of span blocks */
+
+	tree_cursor *cursors;	/**< Cursors of the last requested children */
+	size_t cursors_size;	/**< Number of used cursors */
+
+	size_t garbage;			/**< Number of unreachable cells */
+} tree_table;
+
 /** Tree node */
 typedef struct node
 {
-	vector *tree;			/**< Tree reference */
+	tree_table *tree;		/**< Tree reference */
 	size_t index;			/**< Node index */
 } node;
 
@@ -38,7 +68,7 @@ typedef struct node
  *
  *	@return	Root node
  */
-EXPORTED node node_get_root(vector *const tree);
+EXPORTED node node_get_root(tree_table *const tree);
 
 /**
  *	Get child from node by index
@@ -228,6 +258,28 @@ EXPORTED size_t node_set_arg_double(const node *const nd, const size_t index, co
  */
 EXPORTED size_t node_set_arg_int64(const node *const nd, const size_t index, const int64_t arg);
 
+/**
+ *	Get source span of node
+ *
+ *	@param	nd			Node structure
+ *	@param	begin		Span begin
+ *	@param	end			Span end
+ *
+ *	@return	@c 0 on success, @c -1 on failure or node without span
+ */
+EXPORTED int node_get_span(const node *const nd, size_t *const begin, size_t *const end);
+
+/**
+ *	Set source span of node
+ *
+ *	@param	nd			Node structure
+ *	@param	begin		Span begin
+ *	@param	end			Span end
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int node_set_span(const node *const nd, const size_t begin, const size_t end);
+
 
 /**
  *	Copy source node to destination
@@ -256,7 +308,7 @@ EXPORTED size_t node_save(const node *const nd);
  *
  *	@return	Rebuilt node
  */
-EXPORTED node node_load(vector *const tree, const size_t index);
+EXPORTED node node_load(tree_table *const tree, const size_t index);
 
 /**
  *	Insert new node before existing
@@ -289,6 +341,30 @@ EXPORTED int node_order(const node *const fst, const node *const snd);
  */
 EXPORTED int node_swap(const node *const fst, const node *const snd);
 
+/**
+ *	Move node with its children to the end of parent children,
+ *	parent must not be in the subtree of node
+ *
+ *	@param	nd			Node structure
+ *	@param	parent		New parent node
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int node_move(const node *const nd, const node *const parent);
+
+/**
+ *	Replace node type and arguments, children are kept.
+ *	Node is rewritten in place, if new arguments fit or node is the last in tree table,
+ *	otherwise it is moved to the end of tree table and its previous cells become unreachable.
+ *
+ *	@param	nd			Node structure
+ *	@param	type		New node type
+ *	@param	argc		Amount of new node arguments
+ *
+ *	@return	Replaced node
+ */
+EXPORTED node node_replace(const node *const nd, const item_t type, const size_t argc);
+
 /**
  *	Remove node from tree
  *
@@ -307,6 +383,53 @@ EXPORTED int node_remove(node *const nd);
  */
 EXPORTED bool node_is_correct(const node *const nd);
 
+
+/**
+ *	Create new tree table
+ *
+ *	@param	alloc		Initializer of allocated cells
+ *
+ *	@return	Tree table
+ */
+EXPORTED tree_table tree_create(const size_t alloc);
+
+/**
+ *	Get size of tree table in bytes
+ *
+ *	@param	tree		Tree table
+ *
+ *	@return	Size of tree table, @c 0 on failure
+ */
+EXPORTED size_t tree_size(const tree_table *const tree);
+
+/**
+ *	Check that tree table is correct
+ *
+ *	@param	tree		Tree table
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool tree_is_correct(const tree_table *const tree);
+
+/**
+ *	Rewrite tree table in pre-order without unreachable cells, previous nodes become invalid.
+ *	Table is kept, if it has no unreachable cells or rewritten table is not smaller.
+ *
+ *	@param	tree		Tree table
+ *
+ *	@return	Number of reclaimed bytes, @c SIZE_MAX on failure
+ */
+EXPORTED size_t tree_compact(tree_table *const tree);
+
+/**
+ *	Free allocated memory
+ *
+ *	@param	tree		Tree table
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int tree_clear(tree_table *const tree);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
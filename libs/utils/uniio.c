@@ -15,6 +15,7 @@
  */
 
 #include "uniio.h"
+#include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -26,13 +27,21 @@
 	extern intptr_t _get_osfhandle(int fd);
 #elif __APPLE__
 	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
 #else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
 	#include <unistd.h>
 
 	#define MAX_LINK_SIZE 20
 #endif
 
 #define MAX_FORMAT_SIZE 128
+#define MAX_STREAM_SCAN_SIZE 256
+#define MAX_STREAM_PRINT_SIZE 1024
+#define OUT_CACHE_SIZE 65536
 
 
 static inline bool is_specifier(const char ch)
@@ -83,6 +92,44 @@ static int scan_buffer_arg(universal_io *const io, const char *const format, con
 	return io->in_position < io->in_size || number != 0 ? ret : 0;
 }
 
+/** Receive part of input stream with position, return @c false on the end of stream */
+static inline bool in_stream_window(universal_io *const io, const size_t position)
+{
+	if (position >= io->in_window_begin && position < io->in_window_end)
+	{
+		return true;
+	}
+
+	size_t available = 0;
+	io->in_window = stream_get(io->in_stream, position, &available);
+	io->in_window_begin = position;
+	io->in_window_end = position + available;
+	return io->in_window != NULL;
+}
+
+static int scan_stream_arg(universal_io *const io, const char *const format, const size_t size, void *arg)
+{
+	// Numbers are short, so copy of the beginning of stream is enough for sscanf
+	char text[MAX_STREAM_SCAN_SIZE + 1];
+	size_t length = 0;
+	while (length < MAX_STREAM_SCAN_SIZE && in_stream_window(io, io->in_position + length))
+	{
+		text[length] = io->in_window[io->in_position + length - io->in_window_begin];
+		length++;
+	}
+	text[length] = '\0';
+
+	char buffer[MAX_FORMAT_SIZE];
+	strncpy(buffer, format, size);
+	sprintf(&buffer[size], "%%zn");
+
+	size_t number = 0;
+	int ret = sscanf(text, buffer, arg, &number);
+	io->in_position += number;
+
+	return number != 0 ? ret : 0;
+}
+
 static inline int in_func_position(universal_io *const io, const char *const format, va_list args
 	, int (*scan_arg)(universal_io *const, const char *const, const size_t, void *))
 {
@@ -144,44 +191,240 @@ static int in_func_file(universal_io *const io, const char *const format, va_lis
 
 static int in_func_buffer(universal_io *const io, const char *const format, va_list args)
 {
+	if (format[0] == '%' && format[1] == 'c' && format[2] == '\0')
+	{
+		// Single characters are taken directly, sscanf measures the whole rest of buffer on each call
+		if (io->in_position >= io->in_size)
+		{
+			return 0;
+		}
+
+		*va_arg(args, char *) = io->in_buffer[io->in_position++];
+		return 1;
+	}
+
 	return in_func_position(io, format, args, &scan_buffer_arg);
 }
 
+static int in_func_stream(universal_io *const io, const char *const format, va_list args)
+{
+	if (format[0] == '%' && format[1] == 'c' && format[2] == '\0')
+	{
+		if (!in_stream_window(io, io->in_position))
+		{
+			return 0;
+		}
+
+		*va_arg(args, char *) = io->in_window[io->in_position - io->in_window_begin];
+		io->in_position++;
+		return 1;
+	}
+
+	return in_func_position(io, format, args, &scan_stream_arg);
+}
+
 static int in_func_user(universal_io *const io, const char *const format, va_list args)
 {
 	return io->in_user_func(format, args);
 }
 
 
+static inline int out_flush_cache(universal_io *const io)
+{
+	const size_t size = io->out_cache_position;
+	io->out_cache_position = 0;
+	return fwrite(io->out_cache, sizeof(char), size, io->out_file) == size ? 0 : -1;
+}
+
 static int out_func_file(universal_io *const io, const char *const format, va_list args)
 {
+	if (io->out_cache == NULL)
+	{
+		return vfprintf(io->out_file, format, args);
+	}
+
+	va_list local;
+	va_copy(local, args);
+
+	const size_t free_space = OUT_CACHE_SIZE - io->out_cache_position;
+	const int ret = vsnprintf(&io->out_cache[io->out_cache_position], free_space, format, local);
+	va_end(local);
+
+	if (ret < 0)
+	{
+		return ret;
+	}
+
+	if ((size_t)ret < free_space)
+	{
+		io->out_cache_position += (size_t)ret;
+		return ret;
+	}
+
+	if (out_flush_cache(io))
+	{
+		return -1;
+	}
+
+	if ((size_t)ret < OUT_CACHE_SIZE)
+	{
+		io->out_cache_position = (size_t)vsnprintf(io->out_cache, OUT_CACHE_SIZE, format, args);
+		return ret;
+	}
+
 	return vfprintf(io->out_file, format, args);
 }
 
+/** Chunk of output buffer */
+struct io_chunk
+{
+	io_chunk *next;				/**< Next chunk */
+	char *data;					/**< Text, always null-terminated */
+	size_t size;				/**< Size of text */
+	size_t alloc;				/**< Allocated size of text */
+};
+
+
+static io_chunk *chunk_create(const size_t alloc)
+{
+	io_chunk *const chunk = malloc(sizeof(io_chunk));
+	if (chunk == NULL)
+	{
+		return NULL;
+	}
+
+	chunk->data = malloc(alloc * sizeof(char));
+	if (chunk->data == NULL)
+	{
+		free(chunk);
+		return NULL;
+	}
+
+	chunk->next = NULL;
+	chunk->data[0] = '\0';
+	chunk->size = 0;
+	chunk->alloc = alloc;
+	return chunk;
+}
+
+static void chunk_clear(io_chunk *chunk)
+{
+	while (chunk != NULL)
+	{
+		io_chunk *const next = chunk->next;
+		free(chunk->data);
+		free(chunk);
+		chunk = next;
+	}
+}
+
+/** Append chunk with place for at least size characters */
+static inline io_chunk *out_add_chunk(universal_io *const io, const size_t size)
+{
+	const size_t alloc = 2 * io->out_tail->alloc > size + 1 ? 2 * io->out_tail->alloc : size + 1;
+	io_chunk *const chunk = chunk_create(alloc);
+	if (chunk == NULL)
+	{
+		return NULL;
+	}
+
+	io->out_tail->next = chunk;
+	io->out_tail = chunk;
+	return chunk;
+}
+
+/** Join chunks of output buffer into the first one, so its text becomes contiguous */
+static int out_join_chunks(universal_io *const io)
+{
+	io_chunk *const head = io->out_head;
+	if (head == io->out_tail)
+	{
+		return 0;
+	}
+
+	char *const data = realloc(head->data, (io->out_size + 1) * sizeof(char));
+	if (data == NULL)
+	{
+		return -1;
+	}
+
+	head->data = data;
+	head->alloc = io->out_size + 1;
+	for (io_chunk *chunk = head->next; chunk != NULL; chunk = chunk->next)
+	{
+		memcpy(&head->data[head->size], chunk->data, chunk->size);
+		head->size += chunk->size;
+	}
+	head->data[head->size] = '\0';
+
+	chunk_clear(head->next);
+	head->next = NULL;
+	io->out_tail = head;
+	return 0;
+}
+
 static int out_func_buffer(universal_io *const io, const char *const format, va_list args)
 {
 	va_list local;
 	va_copy(local, args);
 
-	int ret = vsnprintf(&io->out_buffer[io->out_position], io->out_size - io->out_position, format, local);
+	io_chunk *chunk = io->out_tail;
+	int ret = vsnprintf(&chunk->data[chunk->size], chunk->alloc - chunk->size, format, local);
+	va_end(local);
+
+	if (ret < 0)
+	{
+		return ret;
+	}
+
+	if ((size_t)ret >= chunk->alloc - chunk->size)
+	{
+		// Text is formatted again into the new chunk, previous one keeps its text
+		chunk->data[chunk->size] = '\0';
+		chunk = out_add_chunk(io, (size_t)ret);
+		if (chunk == NULL)
+		{
+			return -1;
+		}
+
+		vsnprintf(chunk->data, chunk->alloc, format, args);
+	}
+
+	chunk->size += (size_t)ret;
+	io->out_size += (size_t)ret;
+	return ret;
+}
+
+static int out_func_stream(universal_io *const io, const char *const format, va_list args)
+{
+	va_list local;
+	va_copy(local, args);
+
+	char buffer[MAX_STREAM_PRINT_SIZE];
+	const int ret = vsnprintf(buffer, MAX_STREAM_PRINT_SIZE, format, local);
+	va_end(local);
 
-	if (ret != -1 && (size_t)ret + io->out_position < io->out_size)
+	if (ret < 0)
 	{
-		io->out_position += (size_t)ret;
 		return ret;
 	}
 
-	io->out_buffer[io->out_position] = '\0';
+	if ((size_t)ret < MAX_STREAM_PRINT_SIZE)
+	{
+		return stream_write(io->out_stream, buffer, (size_t)ret) ? -1 : ret;
+	}
 
-	char *new_buffer = realloc(io->out_buffer, 2 * io->out_size * sizeof(char));
-	if (new_buffer == NULL)
+	char *const text = malloc(((size_t)ret + 1) * sizeof(char));
+	if (text == NULL)
 	{
 		return -1;
 	}
 
-	io->out_size *= 2;
-	io->out_buffer = new_buffer;
-	return out_func_buffer(io, format, args);
+	vsnprintf(text, (size_t)ret + 1, format, args);
+	const int written = stream_write(io->out_stream, text, (size_t)ret) ? -1 : ret;
+
+	free(text);
+	return written;
 }
 
 static int out_func_user(universal_io *const io, const char *const format, va_list args)
@@ -189,6 +432,17 @@ static int out_func_user(universal_io *const io, const char *const format, va_li
 	return io->out_user_func(format, args);
 }
 
+static int out_call_func(universal_io *const io, const char *const format, ...)
+{
+	va_list args;
+	va_start(args, format);
+
+	const int ret = io->out_func(io, format, args);
+
+	va_end(args);
+	return ret;
+}
+
 
 static inline size_t io_get_path(FILE *const file, char *const buffer)
 {
@@ -223,6 +477,84 @@ static inline size_t io_get_path(FILE *const file, char *const buffer)
 }
 
 
+static inline char *io_read_file(FILE *const file, const size_t size)
+{
+	char *const buffer = malloc((size + 1) * sizeof(char));
+	if (buffer == NULL)
+	{
+		return NULL;
+	}
+
+	if (fread(buffer, sizeof(char), size, file) != size)
+	{
+		free(buffer);
+		return NULL;
+	}
+
+	buffer[size] = '\0';
+	return buffer;
+}
+
+/** Heap copy is used instead of mapping when the terminating zero does not fit into the last page */
+static inline bool io_is_heap_mapping(const size_t size)
+{
+#ifdef _WIN32
+	(void)size;
+	return true;
+#else
+	return size % (size_t)sysconf(_SC_PAGESIZE) == 0;
+#endif
+}
+
+static inline char *io_map_file(FILE *const file, size_t *const size)
+{
+#ifdef _WIN32
+	if (fseek(file, 0, SEEK_END) != 0)
+	{
+		return NULL;
+	}
+
+	const long length = ftell(file);
+	if (length < 0 || fseek(file, 0, SEEK_SET) != 0)
+	{
+		return NULL;
+	}
+
+	*size = (size_t)length;
+	return io_read_file(file, *size);
+#else
+	struct stat stat_buf;
+	if (fstat(fileno(file), &stat_buf) != 0 || !S_ISREG(stat_buf.st_mode))
+	{
+		return NULL;
+	}
+
+	*size = (size_t)stat_buf.st_size;
+	if (io_is_heap_mapping(*size))
+	{
+		return io_read_file(file, *size);
+	}
+
+	// The rest of the last page is filled with zeros, so mapping is null-terminated
+	void *const mapping = mmap(NULL, *size + 1, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+	return mapping != MAP_FAILED ? mapping : NULL;
+#endif
+}
+
+static inline void io_unmap_file(char *const mapping, const size_t size)
+{
+#ifndef _WIN32
+	if (!io_is_heap_mapping(size))
+	{
+		munmap(mapping, size + 1);
+		return;
+	}
+#endif
+
+	free(mapping);
+}
+
+
 /*
  *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
  *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
@@ -238,18 +570,29 @@ universal_io io_create(void)
 
 	io.in_file = NULL;
 	io.in_buffer = NULL;
+	io.in_mapping = NULL;
+	io.in_path = NULL;
 
 	io.in_size = 0;
 	io.in_position = 0;
 
+	io.in_stream = NULL;
+	io.in_window = NULL;
+	io.in_window_begin = 0;
+	io.in_window_end = 0;
+
 	io.in_user_func = NULL;
 	io.in_func = NULL;
 
 	io.out_file = NULL;
-	io.out_buffer = NULL;
+	io.out_cache = NULL;
+	io.out_cache_position = 0;
 
+	io.out_head = NULL;
+	io.out_tail = NULL;
 	io.out_size = 0;
-	io.out_position = 0;
+
+	io.out_stream = NULL;
 
 	io.out_user_func = NULL;
 	io.out_func = NULL;
@@ -278,6 +621,35 @@ int in_set_file(universal_io *const io, const char *const path)
 	return 0;
 }
 
+int in_set_mapped(universal_io *const io, const char *const path)
+{
+	if (path == NULL || in_clear(io))
+	{
+		return -1;
+	}
+
+	io->in_file = fopen(path, "rb");
+	if (io->in_file == NULL)
+	{
+		return -1;
+	}
+
+	io->in_mapping = io_map_file(io->in_file, &io->in_size);
+	if (io->in_mapping == NULL)
+	{
+		in_close_file(io);
+		io->in_size = 0;
+		return -1;
+	}
+
+	io->in_buffer = io->in_mapping;
+	io->in_position = 0;
+
+	io->in_func = &in_func_buffer;
+
+	return 0;
+}
+
 int in_set_buffer(universal_io *const io, const char *const buffer)
 {
 	if (buffer == NULL || in_clear(io))
@@ -295,6 +667,44 @@ int in_set_buffer(universal_io *const io, const char *const buffer)
 	return 0;
 }
 
+int in_set_source(universal_io *const io, const char *const path, const char *const buffer)
+{
+	if (path == NULL || in_set_buffer(io, buffer))
+	{
+		return -1;
+	}
+
+	// Path is copied, because the owner of file list may reallocate it
+	io->in_path = malloc(strlen(path) + 1);
+	if (io->in_path == NULL)
+	{
+		in_clear(io);
+		return -1;
+	}
+
+	strcpy(io->in_path, path);
+	return 0;
+}
+
+int in_set_stream(universal_io *const io, stream *const stm)
+{
+	if (!stream_is_correct(stm) || in_clear(io))
+	{
+		return -1;
+	}
+
+	io->in_stream = stm;
+	io->in_window = NULL;
+	io->in_window_begin = 0;
+	io->in_window_end = 0;
+
+	io->in_position = 0;
+
+	io->in_func = &in_func_stream;
+
+	return 0;
+}
+
 int in_set_func(universal_io *const io, const io_user_func func)
 {
 	if (in_clear(io))
@@ -334,6 +744,17 @@ int in_set_position(universal_io *const io, const size_t position)
 		return -1;
 	}
 
+	if (in_is_stream(io))
+	{
+		if (stream_is_reachable(io->in_stream, position))
+		{
+			io->in_position = position;
+			return 0;
+		}
+
+		return -1;
+	}
+
 	return -1;
 }
 
@@ -352,6 +773,30 @@ int in_swap(universal_io *const fst, universal_io *const snd)
 	fst->in_buffer = snd->in_buffer;
 	snd->in_buffer = buffer;
 
+	char *mapping = fst->in_mapping;
+	fst->in_mapping = snd->in_mapping;
+	snd->in_mapping = mapping;
+
+	char *path = fst->in_path;
+	fst->in_path = snd->in_path;
+	snd->in_path = path;
+
+	stream *const stm = fst->in_stream;
+	fst->in_stream = snd->in_stream;
+	snd->in_stream = stm;
+
+	const char *window = fst->in_window;
+	fst->in_window = snd->in_window;
+	snd->in_window = window;
+
+	const size_t window_begin = fst->in_window_begin;
+	fst->in_window_begin = snd->in_window_begin;
+	snd->in_window_begin = window_begin;
+
+	const size_t window_end = fst->in_window_end;
+	fst->in_window_end = snd->in_window_end;
+	snd->in_window_end = window_end;
+
 	const size_t size = fst->in_size;
 	fst->in_size = snd->in_size;
 	snd->in_size = size;
@@ -374,12 +819,12 @@ int in_swap(universal_io *const fst, universal_io *const snd)
 
 bool in_is_correct(const universal_io *const io)
 {
-	return io != NULL && (in_is_file(io) || in_is_buffer(io) || in_is_func(io));
+	return io != NULL && (in_is_file(io) || in_is_buffer(io) || in_is_stream(io) || in_is_func(io));
 }
 
 bool in_is_file(const universal_io *const io)
 {
-	return io != NULL && io->in_file != NULL;
+	return io != NULL && (io->in_file != NULL || io->in_path != NULL);
 }
 
 bool in_is_buffer(const universal_io *const io)
@@ -387,6 +832,16 @@ bool in_is_buffer(const universal_io *const io)
 	return io != NULL && io->in_buffer != NULL;
 }
 
+bool in_is_mapped(const universal_io *const io)
+{
+	return io != NULL && io->in_mapping != NULL;
+}
+
+bool in_is_stream(const universal_io *const io)
+{
+	return io != NULL && io->in_stream != NULL;
+}
+
 bool in_is_func(const universal_io *const io)
 {
 	return io != NULL && io->in_user_func != NULL;
@@ -400,6 +855,12 @@ io_func in_get_func(const universal_io *const io)
 
 size_t in_get_path(const universal_io *const io, char *const buffer)
 {
+	if (io != NULL && io->in_path != NULL)
+	{
+		strcpy(buffer, io->in_path);
+		return strlen(buffer);
+	}
+
 	return in_is_file(io) ? io_get_path(io->in_file, buffer) : 0;
 }
 
@@ -410,7 +871,7 @@ const char *in_get_buffer(const universal_io *const io)
 
 size_t in_get_position(const universal_io *const io)
 {
-	return in_is_buffer(io) || in_is_file(io) ? io->in_position : 0;
+	return in_is_buffer(io) || in_is_file(io) || in_is_stream(io) ? io->in_position : 0;
 }
 
 
@@ -421,9 +882,29 @@ int in_close_file(universal_io *const io)
 		return -1;
 	}
 
+	if (io->in_path != NULL)
+	{
+		free(io->in_path);
+		io->in_path = NULL;
+		io->in_buffer = NULL;
+
+		io->in_size = 0;
+		io->in_position = 0;
+		return 0;
+	}
+
 	int ret = fclose(io->in_file);
 	io->in_file = NULL;
 
+	if (in_is_mapped(io))
+	{
+		io_unmap_file(io->in_mapping, io->in_size);
+		io->in_mapping = NULL;
+
+		io->in_buffer = NULL;
+		io->in_size = 0;
+	}
+
 	io->in_position = 0;
 
 	return ret;
@@ -447,6 +928,15 @@ int in_clear(universal_io *const io)
 		io->in_size = 0;
 		io->in_position = 0;
 	}
+	else if (in_is_stream(io))
+	{
+		io->in_stream = NULL;
+		io->in_window = NULL;
+		io->in_window_begin = 0;
+		io->in_window_end = 0;
+
+		io->in_position = 0;
+	}
 	else
 	{
 		io->in_user_func = NULL;
@@ -470,6 +960,10 @@ int out_set_file(universal_io *const io, const char *const path)
 		return -1;
 	}
 
+	// Without write-behind buffer output goes to file directly
+	io->out_cache = malloc(OUT_CACHE_SIZE * sizeof(char));
+	io->out_cache_position = 0;
+
 	io->out_func = &out_func_file;
 
 	return 0;
@@ -482,23 +976,33 @@ int out_set_buffer(universal_io *const io, const size_t size)
 		return -1;
 	}
 
-	io->out_size = size + 1;
-	io->out_buffer = malloc(io->out_size * sizeof(char));
-
-	if (io->out_buffer == NULL)
+	io->out_head = chunk_create(size + 1);
+	if (io->out_head == NULL)
 	{
-		io->out_size = 0;
 		return -1;
 	}
 
-	io->out_buffer[0] = '\0';
-	io->out_position = 0;
+	io->out_tail = io->out_head;
+	io->out_size = 0;
 
 	io->out_func = &out_func_buffer;
 
 	return 0;
 }
 
+int out_set_stream(universal_io *const io, stream *const stm)
+{
+	if (!stream_is_correct(stm) || out_clear(io))
+	{
+		return -1;
+	}
+
+	io->out_stream = stm;
+	io->out_func = &out_func_stream;
+
+	return 0;
+}
+
 int out_set_func(universal_io *const io, const io_user_func func)
 {
 	if (out_clear(io))
@@ -512,6 +1016,143 @@ int out_set_func(universal_io *const io, const io_user_func func)
 	return 0;
 }
 
+int out_write(universal_io *const io, const char *const str, const size_t size)
+{
+	if (str == NULL || size > INT_MAX)
+	{
+		return -1;
+	}
+
+	if (out_is_buffer(io))
+	{
+		io_chunk *chunk = io->out_tail;
+		const size_t part = chunk->alloc - chunk->size - 1 < size ? chunk->alloc - chunk->size - 1 : size;
+
+		memcpy(&chunk->data[chunk->size], str, part);
+		chunk->size += part;
+		chunk->data[chunk->size] = '\0';
+
+		if (part < size)
+		{
+			chunk = out_add_chunk(io, size - part);
+			if (chunk == NULL)
+			{
+				io->out_size += part;
+				return -1;
+			}
+
+			memcpy(chunk->data, &str[part], size - part);
+			chunk->size = size - part;
+			chunk->data[chunk->size] = '\0';
+		}
+
+		io->out_size += size;
+		return (int)size;
+	}
+
+	if (out_is_file(io))
+	{
+		if (io->out_cache == NULL)
+		{
+			return fwrite(str, sizeof(char), size, io->out_file) == size ? (int)size : -1;
+		}
+
+		if (io->out_cache_position + size > OUT_CACHE_SIZE && out_flush_cache(io))
+		{
+			return -1;
+		}
+
+		if (size > OUT_CACHE_SIZE)
+		{
+			return fwrite(str, sizeof(char), size, io->out_file) == size ? (int)size : -1;
+		}
+
+		memcpy(&io->out_cache[io->out_cache_position], str, size);
+		io->out_cache_position += size;
+		return (int)size;
+	}
+
+	if (out_is_stream(io))
+	{
+		return stream_write(io->out_stream, str, size) ? -1 : (int)size;
+	}
+
+	if (out_is_func(io))
+	{
+		return out_call_func(io, "%.*s", (int)size, str);
+	}
+
+	return -1;
+}
+
+int out_splice(universal_io *const io, universal_io *const src)
+{
+	if (!out_is_buffer(src) || !out_is_correct(io) || io == src)
+	{
+		return -1;
+	}
+
+	if (!out_is_buffer(io))
+	{
+		for (io_chunk *chunk = src->out_head; chunk != NULL; chunk = chunk->next)
+		{
+			if (out_write(io, chunk->data, chunk->size) == -1)
+			{
+				return -1;
+			}
+		}
+
+		return out_reset_buffer(src);
+	}
+
+	io_chunk *const head = chunk_create(src->out_head->alloc);
+	if (head == NULL)
+	{
+		return -1;
+	}
+
+	io->out_tail->next = src->out_head;
+	io->out_tail = src->out_tail;
+	io->out_size += src->out_size;
+
+	src->out_head = head;
+	src->out_tail = head;
+	src->out_size = 0;
+	return 0;
+}
+
+int out_reset_buffer(universal_io *const io)
+{
+	if (!out_is_buffer(io))
+	{
+		return -1;
+	}
+
+	chunk_clear(io->out_head->next);
+	io->out_head->next = NULL;
+	io->out_head->data[0] = '\0';
+	io->out_head->size = 0;
+
+	io->out_tail = io->out_head;
+	io->out_size = 0;
+	return 0;
+}
+
+int out_flush(universal_io *const io)
+{
+	if (!out_is_file(io))
+	{
+		return -1;
+	}
+
+	if (io->out_cache != NULL && out_flush_cache(io))
+	{
+		return -1;
+	}
+
+	return fflush(io->out_file) == 0 ? 0 : -1;
+}
+
 int out_swap(universal_io *const fst, universal_io *const snd)
 {
 	if (fst == NULL || snd == NULL)
@@ -523,18 +1164,30 @@ int out_swap(universal_io *const fst, universal_io *const snd)
 	fst->out_file = snd->out_file;
 	snd->out_file = file;
 
-	char *buffer = fst->out_buffer;
-	fst->out_buffer = snd->out_buffer;
-	snd->out_buffer = buffer;
+	char *cache = fst->out_cache;
+	fst->out_cache = snd->out_cache;
+	snd->out_cache = cache;
+
+	const size_t cache_position = fst->out_cache_position;
+	fst->out_cache_position = snd->out_cache_position;
+	snd->out_cache_position = cache_position;
+
+	io_chunk *head = fst->out_head;
+	fst->out_head = snd->out_head;
+	snd->out_head = head;
+
+	io_chunk *tail = fst->out_tail;
+	fst->out_tail = snd->out_tail;
+	snd->out_tail = tail;
+
+	stream *const stm = fst->out_stream;
+	fst->out_stream = snd->out_stream;
+	snd->out_stream = stm;
 
 	const size_t size = fst->out_size;
 	fst->out_size = snd->out_size;
 	snd->out_size = size;
 
-	const size_t position = fst->out_position;
-	fst->out_position = snd->out_position;
-	snd->out_position = position;
-
 	const io_user_func user_func = fst->out_user_func;
 	fst->out_user_func = snd->out_user_func;
 	snd->out_user_func = user_func;
@@ -549,7 +1202,7 @@ int out_swap(universal_io *const fst, universal_io *const snd)
 
 bool out_is_correct(const universal_io *const io)
 {
-	return io != NULL && (out_is_file(io) || out_is_buffer(io) || out_is_func(io));;
+	return io != NULL && (out_is_file(io) || out_is_buffer(io) || out_is_stream(io) || out_is_func(io));
 }
 
 bool out_is_file(const universal_io *const io)
@@ -559,7 +1212,12 @@ bool out_is_file(const universal_io *const io)
 
 bool out_is_buffer(const universal_io *const io)
 {
-	return io != NULL && io->out_buffer != NULL;
+	return io != NULL && io->out_head != NULL;
+}
+
+bool out_is_stream(const universal_io *const io)
+{
+	return io != NULL && io->out_stream != NULL;
 }
 
 bool out_is_func(const universal_io *const io)
@@ -584,6 +1242,11 @@ size_t out_get_path(const universal_io *const io, char *const buffer)
 }
 
 
+const char *out_get_buffer(universal_io *const io)
+{
+	return out_is_buffer(io) && !out_join_chunks(io) ? io->out_head->data : NULL;
+}
+
 char *out_extract_buffer(universal_io *const io)
 {
 	if (!out_is_buffer(io))
@@ -591,11 +1254,17 @@ char *out_extract_buffer(universal_io *const io)
 		return NULL;
 	}
 
-	char *buffer = io->out_buffer;
-	io->out_buffer = NULL;
+	char *buffer = NULL;
+	if (!out_join_chunks(io))
+	{
+		buffer = io->out_head->data;
+		io->out_head->data = NULL;
+	}
 
+	chunk_clear(io->out_head);
+	io->out_head = NULL;
+	io->out_tail = NULL;
 	io->out_size = 0;
-	io->out_position = 0;
 
 	io->out_func = NULL;
 	return buffer;
@@ -608,9 +1277,13 @@ int out_close_file(universal_io *const io)
 		return -1;
 	}
 
-	int ret = fclose(io->out_file);
+	const int flushed = io->out_cache != NULL ? out_flush_cache(io) : 0;
+	const int ret = fclose(io->out_file) || flushed ? -1 : 0;
 	io->out_file = NULL;
 
+	free(io->out_cache);
+	io->out_cache = NULL;
+
 	return ret;
 }
 
@@ -627,7 +1300,14 @@ int out_clear(universal_io *const io)
 	}
 	else if (out_is_buffer(io))
 	{
-		free(out_extract_buffer(io));
+		chunk_clear(io->out_head);
+		io->out_head = NULL;
+		io->out_tail = NULL;
+		io->out_size = 0;
+	}
+	else if (out_is_stream(io))
+	{
+		io->out_stream = NULL;
 	}
 	else
 	{
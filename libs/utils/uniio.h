@@ -21,6 +21,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include "dll.h"
+#include "stream.h"
 #include "utf8.h"
 
 
@@ -29,6 +30,7 @@ extern "C" {
 #endif
 
 typedef struct universal_io universal_io;
+typedef struct io_chunk io_chunk;
 
 
 /**
@@ -58,18 +60,29 @@ struct universal_io
 {
 	FILE *in_file;				/**< Input file */
 	const char *in_buffer;		/**< Input buffer */
+	char *in_mapping;			/**< Memory mapped input file */
+	char *in_path;				/**< Path of input file in memory */
 
 	size_t in_size;				/**< Size of input buffer */
 	size_t in_position;			/**< Current position of input buffer */
 
+	stream *in_stream;			/**< Input stream */
+	const char *in_window;		/**< Last received part of input stream */
+	size_t in_window_begin;		/**< Position of received part */
+	size_t in_window_end;		/**< End position of received part */
+
 	io_user_func in_user_func;	/**< Input user function */
 	io_func in_func;			/**< Current input function */
 
 	FILE *out_file;				/**< Output file */
-	char *out_buffer;			/**< Output buffer */
+	char *out_cache;			/**< Write-behind buffer of output file */
+	size_t out_cache_position;	/**< Current position of write-behind buffer */
+
+	io_chunk *out_head;			/**< First chunk of output buffer */
+	io_chunk *out_tail;			/**< Last chunk of output buffer */
+	size_t out_size;			/**< Size of text in output buffer */
 
-	size_t out_size;			/**< Size of output buffer */
-	size_t out_position;		/**< Current position of output buffer */
+	stream *out_stream;			/**< Output stream */
 
 	io_user_func out_user_func;	/**< Output user function */
 	io_func out_func;			/**< Current output function */
@@ -94,6 +107,37 @@ EXPORTED universal_io io_create(void);
  */
 EXPORTED int in_set_file(universal_io *const io, const char *const path);
 
+/**
+ *	Set memory mapped input file
+ *
+ *	@param	io			Universal io structure
+ *	@param	path		Input file path
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int in_set_mapped(universal_io *const io, const char *const path);
+
+/**
+ *	Set input file from memory, it is treated like a file with this path
+ *
+ *	@param	io			Universal io structure
+ *	@param	path		Input file path
+ *	@param	buffer		Input file text
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int in_set_source(universal_io *const io, const char *const path, const char *const buffer);
+
+/**
+ *	Set input stream
+ *
+ *	@param	io			Universal io structure
+ *	@param	stm			Input stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int in_set_stream(universal_io *const io, stream *const stm);
+
 /**
  *	Set input buffer
  *
@@ -145,7 +189,7 @@ EXPORTED int in_swap(universal_io *const fst, universal_io *const snd);
 EXPORTED bool in_is_correct(const universal_io *const io);
 
 /**
- *	Check that current input option is file
+ *	Check that current input option is file or file from memory
  *
  *	@param	io			Universal io structure
  *
@@ -162,6 +206,24 @@ EXPORTED bool in_is_file(const universal_io *const io);
  */
 EXPORTED bool in_is_buffer(const universal_io *const io);
 
+/**
+ *	Check that current input option is memory mapped file
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool in_is_mapped(const universal_io *const io);
+
+/**
+ *	Check that current input option is stream
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool in_is_stream(const universal_io *const io);
+
 /**
  *	Check that current input option is function
  *
@@ -240,15 +302,26 @@ EXPORTED int in_clear(universal_io *const io);
 EXPORTED int out_set_file(universal_io *const io, const char *const path);
 
 /**
- *	Set output buffer
+ *	Set output buffer.
+ *	Buffer grows by chunks, so written text is never moved.
  *
  *	@param	io			Universal io structure
- *	@param	size		Output buffer size
+ *	@param	size		Size of the first chunk
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
 EXPORTED int out_set_buffer(universal_io *const io, const size_t size);
 
+/**
+ *	Set output stream
+ *
+ *	@param	io			Universal io structure
+ *	@param	stm			Output stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int out_set_stream(universal_io *const io, stream *const stm);
+
 /**
  *	Set output function
  *
@@ -259,6 +332,46 @@ EXPORTED int out_set_buffer(universal_io *const io, const size_t size);
  */
 EXPORTED int out_set_func(universal_io *const io, const io_user_func func);
 
+/**
+ *	Write string of known size to output
+ *
+ *	@param	io			Universal io structure
+ *	@param	str			String
+ *	@param	size		String size
+ *
+ *	@return	Number of written characters, @c -1 on failure
+ */
+EXPORTED int out_write(universal_io *const io, const char *const str, const size_t size);
+
+/**
+ *	Move text of output buffer to the end of another output.
+ *	If destination is buffer too, chunks are linked without copying.
+ *
+ *	@param	io			Universal io structure
+ *	@param	src			Universal io structure with output buffer, becomes empty
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int out_splice(universal_io *const io, universal_io *const src);
+
+/**
+ *	Discard text of output buffer, keeping the first chunk for reuse
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int out_reset_buffer(universal_io *const io);
+
+/**
+ *	Write pending output to file
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int out_flush(universal_io *const io);
+
 /**
  *	Swap output option between two streams
  *
@@ -297,6 +410,15 @@ EXPORTED bool out_is_file(const universal_io *const io);
  */
 EXPORTED bool out_is_buffer(const universal_io *const io);
 
+/**
+ *	Check that current output option is stream
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool out_is_stream(const universal_io *const io);
+
 /**
  *	Check that current output option is function
  *
@@ -327,6 +449,16 @@ EXPORTED io_func out_get_func(const universal_io *const io);
 EXPORTED size_t out_get_path(const universal_io *const io, char *const buffer);
 
 
+/**
+ *	Get text of output buffer, keeping it in universal io structure.
+ *	Chunks are joined into the first one, so text is valid until the next output.
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	Text of output buffer, @c NULL on failure
+ */
+EXPORTED const char *out_get_buffer(universal_io *const io);
+
 /**
  *	Extract output buffer from universal io structure
  *
@@ -16,9 +16,35 @@
 
 #include "uniprinter.h"
 #include <stdarg.h>
+#include <string.h>
 #include "utf8.h"
 
 
+#define MAX_NUMBER_SIZE 24
+#define MAX_DOUBLE_SIZE 512
+
+
+/**
+ *	Convert unsigned integer to decimal digits
+ *
+ *	@param	end			End of output buffer
+ *	@param	value		Integer value
+ *
+ *	@return	Beginning of digits
+ */
+static inline char *uint_to_string(char *const end, uintmax_t value)
+{
+	char *current = end;
+	do
+	{
+		*--current = (char)('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	return current;
+}
+
+
 int uni_printf(universal_io *const io, const char *const format, ...)
 {
 	if (!out_is_correct(io))
@@ -39,11 +65,54 @@ int uni_printf(universal_io *const io, const char *const format, ...)
 int uni_print_char(universal_io *const io, const char32_t wchar)
 {
 	char buffer[8];
+	const size_t size = utf8_to_string(buffer, wchar);
 
-	if (!utf8_to_string(buffer, wchar))
+	if (!size)
 	{
 		return 0;
 	}
 
-	return uni_printf(io, "%s", buffer);
+	return out_write(io, buffer, size);
+}
+
+int uni_print_str(universal_io *const io, const char *const str)
+{
+	return str != NULL ? out_write(io, str, strlen(str)) : -1;
+}
+
+int uni_print_int(universal_io *const io, const intmax_t value)
+{
+	char buffer[MAX_NUMBER_SIZE];
+	char *const end = &buffer[MAX_NUMBER_SIZE];
+
+	// Modulo is taken in unsigned type, so minimal value is negated correctly
+	char *begin = uint_to_string(end, value < 0 ? -(uintmax_t)value : (uintmax_t)value);
+	if (value < 0)
+	{
+		*--begin = '-';
+	}
+
+	return out_write(io, begin, (size_t)(end - begin));
+}
+
+int uni_print_uint(universal_io *const io, const uintmax_t value)
+{
+	char buffer[MAX_NUMBER_SIZE];
+	char *const end = &buffer[MAX_NUMBER_SIZE];
+
+	const char *const begin = uint_to_string(end, value);
+	return out_write(io, begin, (size_t)(end - begin));
+}
+
+int uni_print_double(universal_io *const io, const double value)
+{
+	char buffer[MAX_DOUBLE_SIZE];
+	const int size = snprintf(buffer, MAX_DOUBLE_SIZE, "%f", value);
+
+	if (size < 0 || size >= MAX_DOUBLE_SIZE)
+	{
+		return uni_printf(io, "%f", value);
+	}
+
+	return out_write(io, buffer, (size_t)size);
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <stdio.h>
 #include "dll.h"
 #include "uniio.h"
@@ -47,6 +48,46 @@ EXPORTED int uni_printf(universal_io *const io, const char *const format, ...)
  */
 EXPORTED int uni_print_char(universal_io *const io, const char32_t wchar);
 
+/**
+ *	Universal function for printing strings without format parsing
+ *
+ *	@param	io			Universal io structure
+ *	@param	str			NULL-terminated string
+ *
+ *	@return	Return printf-like value
+ */
+EXPORTED int uni_print_str(universal_io *const io, const char *const str);
+
+/**
+ *	Universal function for printing signed integers in decimal notation
+ *
+ *	@param	io			Universal io structure
+ *	@param	value		Integer value
+ *
+ *	@return	Return printf-like value
+ */
+EXPORTED int uni_print_int(universal_io *const io, const intmax_t value);
+
+/**
+ *	Universal function for printing unsigned integers in decimal notation
+ *
+ *	@param	io			Universal io structure
+ *	@param	value		Integer value
+ *
+ *	@return	Return printf-like value
+ */
+EXPORTED int uni_print_uint(universal_io *const io, const uintmax_t value);
+
+/**
+ *	Universal function for printing floating numbers like @c %f specifier
+ *
+ *	@param	io			Universal io structure
+ *	@param	value		Floating value
+ *
+ *	@return	Return printf-like value
+ */
+EXPORTED int uni_print_double(universal_io *const io, const double value);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
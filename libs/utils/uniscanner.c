@@ -20,6 +20,90 @@
 #include "utf8.h"
 
 
+/**
+ *	Decode UTF-8 character directly from input buffer
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	UTF-8 character
+ */
+static inline char32_t scan_buffer_char(universal_io *const io)
+{
+	const size_t position = io->in_position;
+	if (position >= io->in_size)
+	{
+		return (char32_t)EOF;
+	}
+
+	const unsigned char first = (unsigned char)io->in_buffer[position];
+	if (first < 0x80)
+	{
+		io->in_position = position + 1;
+		return first;
+	}
+
+	const size_t size = utf8_symbol_size((char)first);
+	if (position + size > io->in_size)
+	{
+		io->in_position = io->in_size;
+		return (char32_t)EOF;
+	}
+
+	io->in_position = position + size;
+	return utf8_convert(&io->in_buffer[position]);
+}
+
+static inline bool is_ascii_identifier_char(const unsigned char ch)
+{
+	return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+/**
+ *	Scan identifier as span of input buffer
+ *
+ *	@param	io			Universal io structure
+ *	@param	buffer		Output string
+ *
+ *	@return	Size of identifier in string
+ */
+static size_t scan_buffer_identifier(universal_io *const io, char *const buffer)
+{
+	const char *const begin = &io->in_buffer[io->in_position];
+	const char *const end = &io->in_buffer[io->in_size];
+
+	const char *current = begin;
+	while (current < end)
+	{
+		const unsigned char ch = (unsigned char)*current;
+		if (ch < 0x80)
+		{
+			if (!is_ascii_identifier_char(ch) || (current == begin && ch >= '0' && ch <= '9'))
+			{
+				break;
+			}
+
+			current++;
+			continue;
+		}
+
+		const size_t size = utf8_symbol_size((char)ch);
+		if (current + size > end || !utf8_is_letter(utf8_convert(current)))
+		{
+			break;
+		}
+
+		current += size;
+	}
+
+	const size_t size = (size_t)(current - begin);
+	memcpy(buffer, begin, size);
+	buffer[size] = '\0';
+
+	io->in_position += size;
+	return size;
+}
+
+
 int uni_scanf(universal_io *const io, const char *const format, ...)
 {
 	if (!in_is_correct(io))
@@ -39,6 +123,11 @@ int uni_scanf(universal_io *const io, const char *const format, ...)
 
 char32_t uni_scan_char(universal_io *const io)
 {
+	if (in_is_buffer(io))
+	{
+		return scan_buffer_char(io);
+	}
+
 	char buffer[MAX_SYMBOL_SIZE];
 	if (!uni_scanf(io, "%c", &buffer[0]))
 	{
@@ -59,6 +148,20 @@ char32_t uni_scan_char(universal_io *const io)
 
 size_t uni_scan_number(universal_io *const io, char *const buffer)
 {
+	if (in_is_buffer(io))
+	{
+		const char *const begin = &io->in_buffer[io->in_position];
+		char *end = NULL;
+		strtod(begin, &end);
+
+		const size_t size = (size_t)(end - begin);
+		memcpy(buffer, begin, size);
+		buffer[size] = '\0';
+
+		io->in_position += size;
+		return size;
+	}
+
 	const size_t begin = in_get_position(io);
 	double number = 0;
 	uni_scanf(io, "%lf", &number);
@@ -74,6 +177,11 @@ size_t uni_scan_number(universal_io *const io, char *const buffer)
 
 size_t uni_scan_identifier(universal_io *const io, char *const buffer)
 {
+	if (in_is_buffer(io))
+	{
+		return scan_buffer_identifier(io, buffer);
+	}
+
 	char32_t character = uni_scan_char(io);
 	if (!utf8_is_letter(character))
 	{
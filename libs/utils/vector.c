@@ -64,6 +64,23 @@ vector vector_create(const size_t alloc)
 	return vec;
 }
 
+vector vector_copy(const vector *const vec)
+{
+	if (!vector_is_correct(vec))
+	{
+		return vector_create(0);
+	}
+
+	vector copy = vector_create(vec->size);
+	if (copy.array != NULL)
+	{
+		memcpy(copy.array, vec->array, vec->size * sizeof(item_t));
+		copy.size = vec->size;
+	}
+
+	return copy;
+}
+
 
 size_t vector_add(vector *const vec, const item_t value)
 {
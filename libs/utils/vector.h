@@ -42,6 +42,15 @@ typedef struct vector
  */
 EXPORTED vector vector_create(const size_t alloc);
 
+/**
+ *	Create a copy of vector
+ *
+ *	@param	vec				Vector structure
+ *
+ *	@return	Vector structure
+ */
+EXPORTED vector vector_copy(const vector *const vec);
+
 
 /**
  *	Add new value
@@ -15,6 +15,7 @@
  */
 
 #include "workspace.h"
+#include <stdlib.h>
 #include <string.h>
 
 #ifndef _WIN32
@@ -128,7 +129,7 @@ static inline size_t ws_add_path(workspace *const ws, strings *const vec, const
 
 	char buffer[MAX_ARG_SIZE];
 	ws_unix_path(path, buffer);
-	if (access(buffer, F_OK) == -1)
+	if (access(buffer, F_OK) == -1 && ws_exists(buffer, &ws->sources) == SIZE_MAX)
 	{
 		ws->was_error = true;
 		return SIZE_MAX;
@@ -148,6 +149,17 @@ static inline size_t ws_get_num(const strings *const vec)
 	return size != SIZE_MAX ? size : 0;
 }
 
+static inline void ws_copy_strings(workspace *const ws, strings *const dst, const strings *const src)
+{
+	for (size_t i = 0; i < ws_get_num(src); i++)
+	{
+		if (strings_add(dst, strings_get(src, i)) == SIZE_MAX)
+		{
+			ws_add_error(ws);
+		}
+	}
+}
+
 
 /*
  *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
@@ -213,13 +225,42 @@ workspace ws_create(void)
 	ws.dirs = strings_create(MAX_PATHS);
 	ws.flags = strings_create(MAX_FLAGS);
 
+	ws.sources = strings_create(MAX_PATHS);
+	ws.texts = NULL;
+
 	ws.output[0] = '\0';
+	ws.log = NULL;
 	ws.was_error = false;
 
 	return ws;
 }
 
 
+workspace ws_copy(const workspace *const ws)
+{
+	workspace copy = ws_create();
+	if (!ws_is_correct(ws))
+	{
+		copy.was_error = true;
+		return copy;
+	}
+
+	for (size_t i = 0; i < ws_get_num(&ws->sources); i++)
+	{
+		ws_add_source(&copy, strings_get(&ws->sources, i), ws->texts[i], strlen(ws->texts[i]));
+	}
+
+	// Paths are already checked, so they are copied without access to file system
+	ws_copy_strings(&copy, &copy.files, &ws->files);
+	ws_copy_strings(&copy, &copy.dirs, &ws->dirs);
+	ws_copy_strings(&copy, &copy.flags, &ws->flags);
+
+	strcpy(copy.output, ws->output);
+	copy.log = ws->log;
+	return copy;
+}
+
+
 size_t ws_add_file(workspace *const ws, const char *const path)
 {
 	return ws_add_path(ws, &ws->files, path);
@@ -230,6 +271,70 @@ int ws_add_files(workspace *const ws, const char *const *const paths, const size
 	return ws_add_array(ws, &ws_add_file, paths, num);
 }
 
+size_t ws_add_source(workspace *const ws, const char *const path, const char *const text, const size_t size)
+{
+	if (!ws_is_correct(ws) || path == NULL || path[0] == '\0' || text == NULL)
+	{
+		ws_add_error(ws);
+		return SIZE_MAX;
+	}
+
+	char buffer[MAX_ARG_SIZE];
+	ws_unix_path(path, buffer);
+
+	const size_t index = ws_exists(buffer, &ws->sources);
+	if (index != SIZE_MAX)
+	{
+		return index;
+	}
+
+	const size_t size_sources = ws_get_num(&ws->sources);
+	char **const texts = realloc(ws->texts, (size_sources + 1) * sizeof(char *));
+	if (texts == NULL)
+	{
+		ws_add_error(ws);
+		return SIZE_MAX;
+	}
+	ws->texts = texts;
+
+	// Text is copied with terminating null for scanning like a mapped file
+	char *const copy = malloc(size + 1);
+	if (copy == NULL || strings_add(&ws->sources, buffer) == SIZE_MAX)
+	{
+		free(copy);
+		ws_add_error(ws);
+		return SIZE_MAX;
+	}
+
+	memcpy(copy, text, size);
+	copy[size] = '\0';
+
+	ws->texts[size_sources] = copy;
+	return size_sources;
+}
+
+int ws_set_source(workspace *const ws, const size_t index, const char *const text, const size_t size)
+{
+	if (!ws_is_correct(ws) || index >= ws_get_num(&ws->sources) || text == NULL)
+	{
+		ws_add_error(ws);
+		return -1;
+	}
+
+	char *const copy = realloc(ws->texts[index], size + 1);
+	if (copy == NULL)
+	{
+		ws_add_error(ws);
+		return -1;
+	}
+
+	memcpy(copy, text, size);
+	copy[size] = '\0';
+
+	ws->texts[index] = copy;
+	return 0;
+}
+
 
 size_t ws_add_dir(workspace *const ws, const char *const path)
 {
@@ -271,6 +376,17 @@ int ws_set_output(workspace *const ws, const char *const path)
 	return 0;
 }
 
+int ws_set_log_context(workspace *const ws, const struct logger_context *const context)
+{
+	if (ws == NULL)
+	{
+		return -1;
+	}
+
+	ws->log = context;
+	return 0;
+}
+
 
 bool ws_is_correct(const workspace *const ws)
 {
@@ -309,6 +425,20 @@ size_t ws_get_files_num(const workspace *const ws)
 	return ws_is_correct(ws) ? ws_get_num(&ws->files) : 0;
 }
 
+const char *ws_get_source(const workspace *const ws, const char *const path)
+{
+	if (!ws_is_correct(ws) || path == NULL || path[0] == '\0' || ws_get_num(&ws->sources) == 0)
+	{
+		return NULL;
+	}
+
+	char buffer[MAX_ARG_SIZE];
+	ws_unix_path(path, buffer);
+
+	const size_t index = ws_exists(buffer, &ws->sources);
+	return index != SIZE_MAX ? ws->texts[index] : NULL;
+}
+
 const char *ws_get_dir(const workspace *const ws, const size_t index)
 {
 	return ws_is_correct(ws) ? strings_get(&ws->dirs, index) : NULL;
@@ -335,6 +465,11 @@ const char *ws_get_output(const workspace *const ws)
 	return ws_is_correct(ws) && ws->output[0] != '\0' ? ws->output : NULL;
 }
 
+const struct logger_context *ws_get_log_context(const workspace *const ws)
+{
+	return ws != NULL ? ws->log : NULL;
+}
+
 
 int ws_clear(workspace *const ws)
 {
@@ -347,6 +482,15 @@ int ws_clear(workspace *const ws)
 	strings_clear(&ws->dirs);
 	strings_clear(&ws->flags);
 
+	for (size_t i = 0; i < ws_get_num(&ws->sources); i++)
+	{
+		free(ws->texts[i]);
+	}
+
+	free(ws->texts);
+	ws->texts = NULL;
+	strings_clear(&ws->sources);
+
 	ws->was_error = true;
 	return 0;
 }
@@ -32,6 +32,8 @@
 extern "C" {
 #endif
 
+struct logger_context;
+
 /** Structure for parsing start arguments of program */
 typedef struct workspace
 {
@@ -39,7 +41,11 @@ typedef struct workspace
 	strings dirs;					/**< Directories list */
 	strings flags;					/**< Flags list */
 
+	strings sources;				/**< Paths of files in memory */
+	char **texts;					/**< Texts of files in memory */
+
 	char output[MAX_ARG_SIZE];		/**< Output file name */
+	const struct logger_context *log;	/**< Logging context, thread default if @c NULL */
 	bool was_error;					/**< @c 0 if no errors */
 } workspace;
 
@@ -62,6 +68,15 @@ EXPORTED workspace ws_parse_args(const int argc, const char *const *const argv);
  */
 EXPORTED workspace ws_create(void);
 
+/**
+ *	Copy workspace, so copy can be changed independently of original
+ *
+ *	@param	ws			Workspace structure
+ *
+ *	@return	Copy of workspace
+ */
+EXPORTED workspace ws_copy(const workspace *const ws);
+
 
 /**
  *	Add file path to workspace
@@ -84,6 +99,31 @@ EXPORTED size_t ws_add_file(workspace *const ws, const char *const path);
  */
 EXPORTED int ws_add_files(workspace *const ws, const char *const *const paths, const size_t num);
 
+/**
+ *	Add file in memory to workspace, it is found by path before files on disk.
+ *	Files in memory are not compiled until added by @c ws_add_file or included.
+ *
+ *	@param	ws			Workspace structure
+ *	@param	path		File path
+ *	@param	text		File text
+ *	@param	size		Size of text
+ *
+ *	@return	Index of file in memory, @c SIZE_MAX on failure
+ */
+EXPORTED size_t ws_add_source(workspace *const ws, const char *const path, const char *const text, const size_t size);
+
+/**
+ *	Replace text of file in memory, so workspace is reused for another compilation
+ *
+ *	@param	ws			Workspace structure
+ *	@param	index		Index of file in memory
+ *	@param	text		New file text
+ *	@param	size		Size of new text
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int ws_set_source(workspace *const ws, const size_t index, const char *const text, const size_t size);
+
 
 /**
  *	Add include directory to workspace
@@ -139,6 +179,16 @@ EXPORTED int ws_add_flags(workspace *const ws, const char *const *const flags, c
  */
 EXPORTED int ws_set_output(workspace *const ws, const char *const path);
 
+/**
+ *	Set logging context of compilation
+ *
+ *	@param	ws			Workspace structure
+ *	@param	context		Logging context, @c NULL for thread defaults
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int ws_set_log_context(workspace *const ws, const struct logger_context *const context);
+
 
 /**
  *	Check that workspace structure is correct
@@ -179,6 +229,16 @@ EXPORTED const char *ws_get_file(const workspace *const ws, const size_t index);
  */
 EXPORTED size_t ws_get_files_num(const workspace *const ws);
 
+/**
+ *	Get text of file in memory
+ *
+ *	@param	ws			Workspace structure
+ *	@param	path		File path
+ *
+ *	@return	File text, @c NULL if file is not in memory
+ */
+EXPORTED const char *ws_get_source(const workspace *const ws, const char *const path);
+
 /**
  *	Get directory by index from workspase
  *
@@ -227,6 +287,15 @@ EXPORTED size_t ws_get_flags_num(const workspace *const ws);
  */
 EXPORTED const char *ws_get_output(const workspace *const ws);
 
+/**
+ *	Get logging context of compilation
+ *
+ *	@param	ws			Workspace structure
+ *
+ *	@return	Logging context, @c NULL on thread defaults
+ */
+EXPORTED const struct logger_context *ws_get_log_context(const workspace *const ws);
+
 
 /**
  *	Free allocated memory
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+#
+#	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+#
+#	Licensed under the Apache License, Version 2.0 (the "License");
+#	you may not use this file except in compliance with the License.
+#	You may obtain a copy of the License at
+#
+#		http://www.apache.org/licenses/LICENSE-2.0
+#
+#	Unless required by applicable law or agreed to in writing, software
+#	distributed under the License is distributed on an "AS IS" BASIS,
+#	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#	See the License for the specific language governing permissions and
+#	limitations under the License.
+#
+#	Generator of perfect hash tables for keywords.
+#	Tables are written between "Generated by scripts/keywords.py" markers
+#	in libs/compiler/token.c and libs/macro/keywords.c.
+#
+#	Keywords and their English spellings are taken from libs/compiler/token.h
+#	and libs/macro/keywords.h, Russian spellings are set in this script.
+#
+#	Usage: python3 scripts/keywords.py [--check]
+#		--check		Only check that generated tables are up to date
+
+import os
+import re
+import sys
+
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+BEGIN_MARKER = "/* Generated by scripts/keywords.py, do not edit */"
+END_MARKER = "/* End of generated code */"
+
+
+TOKEN_HEADER = os.path.join("libs", "compiler", "token.h")
+KEYWORDS_HEADER = os.path.join("libs", "macro", "keywords.h")
+
+# English spellings and kinds are read from the enum comments in headers,
+# Russian spellings are set here for every kind
+COMPILER_RUSSIAN = {
+	"TK_LINE": "#строка",
+
+	"TK_ABS": "абс",
+	"TK_BOOL": "булево",
+	"TK_BREAK": "выход",
+	"TK_CASE": "случай",
+	"TK_CHAR": "литера",
+	"TK_CONST": "конст",
+	"TK_CONTINUE": "продолжить",
+	"TK_DEFAULT": "умолчание",
+	"TK_DO": "цикл",
+	"TK_DOUBLE": "двойной",
+	"TK_ELSE": "иначе",
+	"TK_ENUM": "перечисление",
+	"TK_FALSE": "ложь",
+	"TK_FILE": "файл",
+	"TK_FLOAT": "вещ",
+	"TK_FOR": "для",
+	"TK_IF": "если",
+	"TK_INT": "цел",
+	"TK_LONG": "длин",
+	"TK_NULL": "ничто",
+	"TK_RETURN": "возврат",
+	"TK_STRUCT": "структура",
+	"TK_SWITCH": "выбор",
+	"TK_TRUE": "истина",
+	"TK_TYPEDEF": "типопр",
+	"TK_UPB": "кол_во",
+	"TK_VOID": "пусто",
+	"TK_WHILE": "пока",
+}
+
+MACRO_RUSSIAN = {
+	"KW_INCLUDE": "#подключить",
+	"KW_LINE": "#строка",
+
+	"KW_DEFINE": "#определить",
+	"KW_SET": "#переопределить",
+	"KW_UNDEF": "#разопределить",
+
+	"KW_MACRO": "#макро",
+	"KW_ENDM": "#конецм",
+
+	"KW_IFDEF": "#еслибыл",
+	"KW_IFNDEF": "#еслинебыл",
+	"KW_IF": "#если",
+	"KW_ELIF": "#инесли",
+	"KW_ELSE": "#иначе",
+	"KW_ENDIF": "#конецесли",
+
+	"KW_EVAL": "#вычислить",
+
+	"KW_WHILE": "#пока",
+	"KW_ENDW": "#конецп",
+}
+
+
+def read_keywords(header, prefix, russian):
+	"""Keywords from enum of header as (English, Russian, kind) triples"""
+	with open(os.path.join(ROOT, header), encoding="utf-8") as file:
+		text = file.read()
+
+	pattern = r"^\s*(" + prefix + r"\w+)\s*,\s*/\*\*<\s*'([^']+)'\s*(?:keyword|directive)"
+	keywords = re.findall(pattern, text, re.MULTILINE)
+
+	kinds = [kind for kind, _ in keywords]
+	missing = [kind for kind in kinds if kind not in russian]
+	unknown = [kind for kind in russian if kind not in kinds]
+	if missing or unknown:
+		sys.exit(f"keywords.py: {header} and Russian spellings diverge"
+			+ (f", no Russian spelling for {', '.join(missing)}" if missing else "")
+			+ (f", no keyword in header for {', '.join(unknown)}" if unknown else ""))
+
+	return [(eng, russian[kind], kind) for kind, eng in keywords]
+
+
+def fnv1a(data):
+	result = 2166136261
+	for byte in data:
+		result ^= byte
+		result = (result * 16777619) & 0xFFFFFFFF
+	return result
+
+
+def spellings(keywords):
+	"""All spellings of keywords: English, Russian and their upper case forms"""
+	result = []
+	for eng, rus, kind in keywords:
+		for spelling in (eng, eng.upper(), rus, rus.upper()):
+			result.append((spelling, kind))
+	return result
+
+
+def build(keywords, table_size, buckets_size):
+	"""Build hash and displace table: slot = (hash / 256 + displacement[hash % buckets] * (hash / 2^20 | 1)) % table"""
+	buckets = [[] for _ in range(buckets_size)]
+	for spelling, kind in spellings(keywords):
+		hash = fnv1a(spelling.encode("utf-8"))
+		buckets[hash % buckets_size].append((spelling, kind, hash >> 8, (hash >> 20) | 1))
+
+	table = [None] * table_size
+	displacements = [0] * buckets_size
+	for index in sorted(range(buckets_size), key=lambda i: -len(buckets[i])):
+		for displacement in range(256):
+			slots = [(base + displacement * step) % table_size for _, _, base, step in buckets[index]]
+			if len(set(slots)) == len(slots) and all(table[slot] is None for slot in slots):
+				break
+		else:
+			sys.exit("keywords.py: perfect hash is not found, increase table size")
+
+		displacements[index] = displacement
+		for slot, (spelling, kind, _, _) in zip(slots, buckets[index]):
+			table[slot] = (spelling, kind)
+
+	return table, displacements
+
+
+def generate(prefix, type, keywords, table_size, buckets_size):
+	table, displacements = build(keywords, table_size, buckets_size)
+	max_size = max(len(spelling.encode("utf-8")) for spelling, _ in spellings(keywords))
+
+	lines = [BEGIN_MARKER, ""]
+	lines.append(f"#define {prefix.upper()}_TABLE_SIZE {table_size}")
+	lines.append(f"#define {prefix.upper()}_BUCKETS_SIZE {buckets_size}")
+	lines.append(f"#define {prefix.upper()}_MAX_SIZE {max_size}")
+	lines.append("")
+	lines.append("")
+	lines.append(f"static const uint8_t {prefix}_displacements[{prefix.upper()}_BUCKETS_SIZE] =")
+	lines.append("{")
+	for i in range(0, buckets_size, 16):
+		lines.append("\t" + ", ".join(str(d) for d in displacements[i:i + 16]) + ",")
+	lines.append("};")
+	lines.append("")
+	lines.append(f"static const struct {{ const char *spelling; {type} kind; }} {prefix}_table[{prefix.upper()}_TABLE_SIZE] =")
+	lines.append("{")
+	for slot, record in enumerate(table):
+		if record is not None:
+			lines.append(f"\t[{slot}] = {{ \"{record[0]}\", {record[1]} }},")
+	lines.append("};")
+	lines.append("")
+	lines.append(END_MARKER)
+	return "\n".join(lines)
+
+
+def update(path, code, check):
+	"""Replace generated code in file, keeping its line endings"""
+	with open(path, encoding="utf-8", newline="") as file:
+		text = file.read()
+
+	if "\r\n" in text:
+		code = code.replace("\n", "\r\n")
+
+	begin = text.index(BEGIN_MARKER)
+	end = text.index(END_MARKER) + len(END_MARKER)
+	if text[begin:end] == code:
+		return True
+
+	if not check:
+		with open(path, "w", encoding="utf-8", newline="") as file:
+			file.write(text[:begin] + code + text[end:])
+
+	return False
+
+
+if __name__ == "__main__":
+	check = "--check" in sys.argv[1:]
+
+	compiler = read_keywords(TOKEN_HEADER, "TK_", COMPILER_RUSSIAN)
+	macro = read_keywords(KEYWORDS_HEADER, "KW_", MACRO_RUSSIAN)
+
+	is_actual = update(os.path.join(ROOT, "libs", "compiler", "token.c")
+		, generate("keyword", "token_t", compiler, 256, 64), check)
+	is_actual = update(os.path.join(ROOT, "libs", "macro", "keywords.c")
+		, generate("keyword", "keyword_t", macro, 128, 32), check) and is_actual
+
+	if check and not is_actual:
+		sys.exit("keywords.py: generated tables are outdated, run scripts/keywords.py")
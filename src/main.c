@@ -18,7 +18,9 @@
 	#pragma comment(linker, "/STACK:268435456")
 #endif
 
+#include <string.h>
 #include "compiler.h"
+#include "server.h"
 #include "workspace.h"
 
 
@@ -28,6 +30,17 @@ const char *name = "../tests/executable/output/printf/string_rus.c";
 
 int main(int argc, const char *argv[])
 {
+	if (argc >= 2 && strcmp(argv[1], "--server") == 0)
+	{
+		return server_run(argc > 2 ? argv[2] : NULL) ? 1 : 0;
+	}
+
+	if (argc >= 3 && strcmp(argv[1], "--client") == 0)
+	{
+		const int ret = client_run(argv[2], argc - 3, &argv[3]);
+		return ret != -1 ? ret : 1;
+	}
+
 	workspace ws = ws_parse_args(argc, argv);
 
 	if (argc < 2)
@@ -0,0 +1,514 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "server.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compiler.h"
+#include "logger.h"
+#include "workspace.h"
+
+#ifndef _WIN32
+	#include <pthread.h>
+	#include <signal.h>
+	#include <stdint.h>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <sys/un.h>
+	#include <unistd.h>
+#endif
+
+
+#define MAX_ARGS 256
+#define DIAGNOSTICS_SIZE 4096
+
+static const char *const TAG_SERVER = "ruc";
+
+// Default outputs of compiler, they are sent by client with its working directory
+static const char *const DEFAULT_VM = "out.ruc";
+static const char *const DEFAULT_LLVM = "out.ll";
+static const char *const DEFAULT_MIPS = "out.s";
+
+static const char *const TAG_ERROR = "ошибка";
+static const char *const TAG_WARNING = "предупреждение";
+static const char *const TAG_NOTE = "примечание";
+
+
+/** Diagnostics of request */
+typedef struct diagnostics
+{
+	char *text;					/**< Diagnostics text */
+	size_t size;				/**< Size of text */
+	size_t alloc;				/**< Allocated size */
+#ifndef _WIN32
+	pthread_mutex_t lock;		/**< Lock for preprocessor thread of --stream */
+#endif
+} diagnostics;
+
+
+static void diagnostics_add(const char *const tag, const char *const kind, const char *const msg)
+{
+	diagnostics *const diag = get_log_context()->data;
+	if (diag == NULL)
+	{
+		return;
+	}
+
+#ifndef _WIN32
+	pthread_mutex_lock(&diag->lock);
+#endif
+
+	const size_t size = strlen(tag) + strlen(kind) + strlen(msg) + 6;
+	if (diag->size + size > diag->alloc)
+	{
+		size_t alloc_new = diag->alloc != 0 ? 2 * diag->alloc : DIAGNOSTICS_SIZE;
+		while (diag->size + size > alloc_new)
+		{
+			alloc_new *= 2;
+		}
+
+		char *text_new = realloc(diag->text, alloc_new);
+		if (text_new != NULL)
+		{
+			diag->alloc = alloc_new;
+			diag->text = text_new;
+		}
+	}
+
+	if (diag->size + size <= diag->alloc)
+	{
+		diag->size += (size_t)sprintf(&diag->text[diag->size], "%s: %s: %s\n", tag, kind, msg);
+	}
+
+#ifndef _WIN32
+	pthread_mutex_unlock(&diag->lock);
+#endif
+}
+
+static void server_error_log(const char *const tag, const char *const msg)
+{
+	diagnostics_add(tag, TAG_ERROR, msg);
+}
+
+static void server_warning_log(const char *const tag, const char *const msg)
+{
+	diagnostics_add(tag, TAG_WARNING, msg);
+}
+
+static void server_note_log(const char *const tag, const char *const msg)
+{
+	diagnostics_add(tag, TAG_NOTE, msg);
+}
+
+
+/**
+ *	Read request line
+ *
+ *	@param	in			Input stream
+ *	@param	size		Line size
+ *
+ *	@return	Line without line feed, @c NULL on the end of requests
+ */
+static char *read_line(FILE *const in, size_t *const size)
+{
+	size_t alloc = 256;
+	char *line = malloc(alloc);
+	*size = 0;
+
+	int character = getc(in);
+	while (line != NULL && character != EOF && character != '\n')
+	{
+		if (*size + 1 == alloc)
+		{
+			alloc *= 2;
+			char *line_new = realloc(line, alloc);
+			if (line_new == NULL)
+			{
+				free(line);
+				return NULL;
+			}
+
+			line = line_new;
+		}
+
+		line[(*size)++] = (char)character;
+		character = getc(in);
+	}
+
+	if (line == NULL || (character == EOF && *size == 0))
+	{
+		free(line);
+		return NULL;
+	}
+
+	line[*size] = '\0';
+	return line;
+}
+
+/**
+ *	Compile one request and write response
+ *
+ *	@param	line		Request line
+ *	@param	diag		Diagnostics buffer
+ *	@param	out			Output stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+static int serve_request(char *const line, diagnostics *const diag, FILE *const out)
+{
+	const char *argv[MAX_ARGS] = { TAG_SERVER };
+	int argc = 1;
+
+	for (char *arg = line; arg != NULL && argc <= MAX_ARGS; argc++)
+	{
+		if (argc < MAX_ARGS)
+		{
+			argv[argc] = arg;
+		}
+
+		arg = strchr(arg, '\t');
+		if (arg != NULL)
+		{
+			*arg++ = '\0';
+		}
+	}
+
+	const logger_context log = { .error_log = &server_error_log, .warning_log = &server_warning_log
+		, .note_log = &server_note_log, .data = diag };
+	diag->size = 0;
+
+	// Arguments are parsed in the same context to report their errors
+	const logger_context *const prev = set_log_context(&log);
+	status_t status = sts_system_error;
+	if (argc > MAX_ARGS)
+	{
+		log_system_error(TAG_SERVER, "слишком много аргументов в запросе");
+	}
+	else
+	{
+		workspace ws = ws_parse_args(argc, argv);
+		ws_set_log_context(&ws, &log);
+		status = compile(&ws);
+		ws_clear(&ws);
+	}
+	set_log_context(prev);
+
+	fprintf(out, "%i %zu\n", status, diag->size);
+	if (diag->size != 0)
+	{
+		fwrite(diag->text, 1, diag->size, out);
+	}
+
+	return fflush(out) == 0 ? 0 : -1;
+}
+
+/**
+ *	Serve requests until the end of input stream
+ *
+ *	@param	in			Input stream
+ *	@param	out			Output stream
+ */
+static void serve_stream(FILE *const in, FILE *const out)
+{
+	diagnostics diag = { .text = NULL, .size = 0, .alloc = 0 };
+#ifndef _WIN32
+	pthread_mutex_init(&diag.lock, NULL);
+#endif
+
+	size_t size;
+	char *line = read_line(in, &size);
+	while (line != NULL)
+	{
+		const int ret = size != 0 ? serve_request(line, &diag, out) : 0;
+		free(line);
+
+		if (ret)
+		{
+			break;
+		}
+
+		line = read_line(in, &size);
+	}
+
+#ifndef _WIN32
+	pthread_mutex_destroy(&diag.lock);
+#endif
+	free(diag.text);
+}
+
+#ifndef _WIN32
+static int socket_address(const char *const path, struct sockaddr_un *const address)
+{
+	if (strlen(path) >= sizeof(address->sun_path))
+	{
+		log_system_error(TAG_SERVER, "слишком длинный путь к сокету");
+		return -1;
+	}
+
+	memset(address, 0, sizeof(struct sockaddr_un));
+	address->sun_family = AF_UNIX;
+	strcpy(address->sun_path, path);
+	return 0;
+}
+
+/**
+ *	Serve requests of one connection
+ *
+ *	@param	arg			Connection descriptor
+ *
+ *	@return	@c NULL
+ */
+static void *serve_connection(void *const arg)
+{
+	const int connection = (int)(intptr_t)arg;
+	FILE *const in = fdopen(connection, "r");
+	FILE *const out = in != NULL ? fdopen(dup(connection), "w") : NULL;
+	if (out != NULL)
+	{
+		serve_stream(in, out);
+		fclose(out);
+	}
+
+	if (in != NULL)
+	{
+		fclose(in);
+	}
+	else
+	{
+		close(connection);
+	}
+
+	return NULL;
+}
+
+/** Remove socket left by previous server, other files are not removed */
+static int socket_unlink(const char *const path)
+{
+	struct stat info;
+	if (lstat(path, &info))
+	{
+		return 0;
+	}
+
+	if (!S_ISSOCK(info.st_mode))
+	{
+		log_system_error(TAG_SERVER, "путь к сокету занят файлом, который не является сокетом");
+		return -1;
+	}
+
+	return unlink(path);
+}
+
+/**
+ *	Write request argument, relative paths are resolved against working directory of client
+ *
+ *	@param	stream		Connection stream
+ *	@param	arg			Argument
+ *	@param	is_path		Set, if argument is path
+ *	@param	dir			Working directory
+ */
+static void write_argument(FILE *const stream, const char *const arg, const bool is_path, const char *const dir)
+{
+	// Include directories are given with flag in the same argument
+	const bool is_dir_flag = arg[0] == '-' && arg[1] == 'I';
+	const char *const path = is_dir_flag ? &arg[2] : arg;
+
+	if ((is_path || is_dir_flag) && path[0] != '/')
+	{
+		fprintf(stream, "%s%s/%s", is_dir_flag ? "-I" : "", dir, path);
+	}
+	else
+	{
+		fprintf(stream, "%s", arg);
+	}
+}
+
+static int serve_socket(const char *const path)
+{
+	struct sockaddr_un address;
+	if (socket_address(path, &address) || socket_unlink(path))
+	{
+		return -1;
+	}
+
+	// Client closing connection before response should not stop server
+	signal(SIGPIPE, SIG_IGN);
+
+	const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd == -1 || bind(fd, (struct sockaddr *)&address, sizeof(address)) || listen(fd, SOMAXCONN))
+	{
+		log_system_error(TAG_SERVER, "не удалось открыть сокет");
+		if (fd != -1)
+		{
+			close(fd);
+		}
+		return -1;
+	}
+
+	for (;;)
+	{
+		const int connection = accept(fd, NULL, NULL);
+		if (connection == -1)
+		{
+			continue;
+		}
+
+		// Every connection is served by its own thread, without threads it is served in place
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, &serve_connection, (void *)(intptr_t)connection) == 0)
+		{
+			pthread_detach(thread);
+		}
+		else
+		{
+			serve_connection((void *)(intptr_t)connection);
+		}
+	}
+}
+#endif
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+int server_run(const char *const path)
+{
+	int ret = 0;
+	if (path == NULL)
+	{
+		serve_stream(stdin, stdout);
+	}
+	else
+	{
+#ifndef _WIN32
+		ret = serve_socket(path);
+#else
+		log_system_error(TAG_SERVER, "сокеты не поддерживаются на этой платформе");
+		ret = -1;
+#endif
+	}
+
+	return ret;
+}
+
+int client_run(const char *const path, const int argc, const char *const *const argv)
+{
+#ifndef _WIN32
+	struct sockaddr_un address;
+	if (socket_address(path, &address))
+	{
+		return -1;
+	}
+
+	const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd == -1 || connect(fd, (struct sockaddr *)&address, sizeof(address)))
+	{
+		log_system_error(TAG_SERVER, "не удалось подключиться к серверу");
+		if (fd != -1)
+		{
+			close(fd);
+		}
+		return -1;
+	}
+
+	FILE *const stream = fdopen(fd, "r+");
+	if (stream == NULL)
+	{
+		close(fd);
+		return -1;
+	}
+
+	char dir[MAX_ARG_SIZE];
+	if (getcwd(dir, MAX_ARG_SIZE) == NULL)
+	{
+		log_system_error(TAG_SERVER, "не удалось определить рабочий каталог");
+		fclose(stream);
+		return -1;
+	}
+
+	// Server has its own working directory, so paths are sent absolute
+	bool has_output = false;
+	bool is_llvm = false;
+	bool is_mips = false;
+	for (int i = 0; i < argc; i++)
+	{
+		if (strpbrk(argv[i], "\t\n") != NULL)
+		{
+			log_system_error(TAG_SERVER, "аргумент содержит табуляцию или перевод строки");
+			fclose(stream);
+			return -1;
+		}
+
+		has_output = has_output || strcmp(argv[i], "-o") == 0;
+		is_llvm = is_llvm || strcmp(argv[i], "-LLVM") == 0;
+		is_mips = is_mips || strcmp(argv[i], "-MIPS") == 0;
+
+		if (i != 0)
+		{
+			fputc('\t', stream);
+		}
+
+		const bool is_output = i != 0 && strcmp(argv[i - 1], "-o") == 0;
+		write_argument(stream, argv[i], is_output || argv[i][0] != '-', dir);
+	}
+
+	if (!has_output)
+	{
+		fprintf(stream, argc != 0 ? "\t-o\t" : "-o\t");
+		write_argument(stream, is_llvm ? DEFAULT_LLVM : is_mips ? DEFAULT_MIPS : DEFAULT_VM, true, dir);
+	}
+
+	fprintf(stream, "\n");
+	fflush(stream);
+
+	int status;
+	size_t size;
+	if (fscanf(stream, "%i %zu", &status, &size) != 2 || getc(stream) != '\n')
+	{
+		log_system_error(TAG_SERVER, "некорректный ответ сервера");
+		fclose(stream);
+		return -1;
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		const int character = getc(stream);
+		if (character == EOF)
+		{
+			break;
+		}
+
+		fputc(character, stderr);
+	}
+
+	fclose(stream);
+	return status;
+#else
+	(void)path;
+	(void)argc;
+	(void)argv;
+
+	log_system_error(TAG_SERVER, "сокеты не поддерживаются на этой платформе");
+	return -1;
+#endif
+}
@@ -0,0 +1,54 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *	Request is a line with command line arguments separated by tabulation.
+ *	Response is a line with status code and size of diagnostics in bytes,
+ *	followed by diagnostics text without colors.
+ */
+
+/**
+ *	Run compile server until the end of requests
+ *
+ *	@param	path		Path to UNIX socket, @c NULL for standard streams
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+int server_run(const char *const path);
+
+/**
+ *	Send one compile request to server and print its diagnostics
+ *
+ *	@param	path		Path to UNIX socket
+ *	@param	argc		Number of arguments
+ *	@param	argv		Command line arguments without program name
+ *
+ *	@return	Status code of compilation, @c -1 on failure
+ */
+int client_run(const char *const path, const int argc, const char *const *const argv);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,156 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+/*
+ *	Test of compile_batch: outputs and statuses of batch are the same as of serial compilation.
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "compiler.h"
+#include "workspace.h"
+
+
+namespace
+{
+
+const char *const SOURCES[] =
+{
+	"int main()\n{\n\tprint(42);\n\treturn 0;\n}\n",
+
+	"int factorial(int n)\n{\n\treturn n > 1 ? n * factorial(n - 1) : 1;\n}\n\n"
+	"int main()\n{\n\tprint(factorial(10));\n\treturn 0;\n}\n",
+
+	"struct point { int x; int y; };\n\n"
+	"int main()\n{\n\tstruct point p = { 1, 2 };\n\tint a[5] = { 1, 2, 3, 4, 5 };\n"
+	"\tint sum = 0;\n\tfor (int i = 0; i < 5; i++)\n\t{\n\t\tsum += a[i] * p.y;\n\t}\n"
+	"\tprint(sum + p.x);\n\treturn 0;\n}\n",
+
+	"#define SIZE 3\n\n"
+	"double average(double a[])\n{\n\tdouble sum = 0;\n\tfor (int i = 0; i < SIZE; i++)\n\t{\n"
+	"\t\tsum += a[i];\n\t}\n\treturn sum / SIZE;\n}\n\n"
+	"int main()\n{\n\tdouble a[SIZE] = { 1.5, 2.5, 3.5 };\n\tprint(average(a));\n\treturn 0;\n}\n",
+
+	"int main()\n{\n\treturn undeclared;\n}\n",
+
+	"char text[] = \"batch\";\n\n"
+	"int main()\n{\n\tint i = 0;\n\twhile (text[i] != 0)\n\t{\n\t\tprint(text[i]);\n\t\ti++;\n\t}\n"
+	"\treturn 0;\n}\n",
+};
+
+const size_t SOURCES_SIZE = sizeof(SOURCES) / sizeof(SOURCES[0]);
+const size_t ERROR_SOURCE = 4;
+const size_t BATCH_THREADS = 4;
+
+
+std::string read_file(const std::filesystem::path &path)
+{
+	std::ifstream file(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+workspace create_workspace(const std::filesystem::path &source, const std::filesystem::path &output)
+{
+	workspace ws = ws_create();
+	ws_add_file(&ws, source.string().c_str());
+	ws_set_output(&ws, output.string().c_str());
+	return ws;
+}
+
+} // namespace
+
+
+int main()
+{
+	const std::filesystem::path dir = std::filesystem::temp_directory_path() / "ruc-test-batch";
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+
+	std::vector<std::filesystem::path> sources;
+	for (size_t i = 0; i < SOURCES_SIZE; i++)
+	{
+		sources.push_back(dir / ("source" + std::to_string(i) + ".c"));
+		std::ofstream(sources[i], std::ios::binary) << SOURCES[i];
+	}
+
+	std::vector<status_t> expected;
+	for (size_t i = 0; i < SOURCES_SIZE; i++)
+	{
+		workspace ws = create_workspace(sources[i], dir / ("serial" + std::to_string(i) + ".ruc"));
+		expected.push_back(static_cast<status_t>(compile(&ws)));
+		ws_clear(&ws);
+	}
+
+	std::vector<workspace> wss;
+	for (size_t i = 0; i < SOURCES_SIZE; i++)
+	{
+		wss.push_back(create_workspace(sources[i], dir / ("batch" + std::to_string(i) + ".ruc")));
+	}
+
+	std::vector<status_t> statuses(SOURCES_SIZE, sts_test_error);
+	const int ret = compile_batch(wss.data(), wss.size(), statuses.data(), BATCH_THREADS);
+
+	for (workspace &ws : wss)
+	{
+		ws_clear(&ws);
+	}
+
+	int failures = ret == 0 ? 0 : 1;
+	if (ret != 0)
+	{
+		std::printf("FAIL: compile_batch returned %d\n", ret);
+	}
+
+	for (size_t i = 0; i < SOURCES_SIZE; i++)
+	{
+		if (statuses[i] != expected[i])
+		{
+			std::printf("FAIL: source%zu.c: batch status %d, serial status %d\n"
+				, i, static_cast<int>(statuses[i]), static_cast<int>(expected[i]));
+			failures++;
+		}
+		else if (expected[i] == sts_success)
+		{
+			const std::string serial = read_file(dir / ("serial" + std::to_string(i) + ".ruc"));
+			if (serial.empty() || read_file(dir / ("batch" + std::to_string(i) + ".ruc")) != serial)
+			{
+				std::printf("FAIL: source%zu.c: batch output differs from serial\n", i);
+				failures++;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < SOURCES_SIZE; i++)
+	{
+		if ((expected[i] == sts_success) == (i == ERROR_SOURCE))
+		{
+			std::printf("FAIL: source%zu.c: unexpected serial status %d\n", i, static_cast<int>(expected[i]));
+			failures++;
+		}
+	}
+
+	std::filesystem::remove_all(dir);
+	if (failures == 0)
+	{
+		std::printf("OK\n");
+	}
+
+	return failures == 0 ? 0 : 1;
+}
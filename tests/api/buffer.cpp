@@ -0,0 +1,152 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+/*
+ *	Test of compile_buffer: compilation from memory to memory, headers in memory and preprocessor output.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include "compiler.h"
+#include "workspace.h"
+
+
+namespace
+{
+
+const char *const SOURCE = "int main()\n{\n\tprint(42);\n\treturn 0;\n}\n";
+const char *const INCLUDING = "#include \"answer.h\"\n\nint main()\n{\n\tprint(ANSWER);\n\treturn 0;\n}\n";
+const char *const HEADER = "#define ANSWER 42\n";
+const char *const ERROR = "int main()\n{\n\treturn undeclared;\n}\n";
+
+
+int failures = 0;
+
+void check(const bool condition, const char *const message)
+{
+	if (!condition)
+	{
+		std::printf("FAIL: %s\n", message);
+		failures++;
+	}
+}
+
+std::string read_file(const std::filesystem::path &path)
+{
+	std::ifstream file(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+status_t compile_text(const std::string &source, const char *const *const flags, const char *const *const headers
+	, std::string &output)
+{
+	char *out = nullptr;
+	size_t out_len = 0;
+	const status_t sts = compile_buffer(source.data(), source.size(), flags, headers, &out, &out_len);
+
+	output = out != nullptr ? std::string(out, out_len) : std::string();
+	check(out == nullptr || out_len == std::char_traits<char>::length(out), "output length differs from text");
+	std::free(out);
+	return sts;
+}
+
+/** Compilation from memory gives the same code as compilation of file */
+void test_memory()
+{
+	const std::filesystem::path dir = std::filesystem::temp_directory_path() / "ruc-test-buffer";
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+	std::ofstream(dir / "main.c", std::ios::binary) << SOURCE;
+
+	workspace ws = ws_create();
+	ws_add_file(&ws, (dir / "main.c").string().c_str());
+	ws_set_output(&ws, (dir / "main.ruc").string().c_str());
+	check(compile(&ws) == sts_success, "compilation of file failed");
+	ws_clear(&ws);
+
+	const std::string expected = read_file(dir / "main.ruc");
+	std::filesystem::remove_all(dir);
+
+	// Source is not terminated with null, only its length is used
+	const std::string source = std::string(SOURCE) + "garbage";
+	std::string output;
+	check(compile_text(source.substr(0, source.size() - 7), nullptr, nullptr, output) == sts_success
+		, "compilation from memory failed");
+	check(!expected.empty() && output == expected, "output from memory differs from output of file");
+
+	const char *const flags[] = { "-VM", nullptr };
+	std::string flagged;
+	check(compile_text(SOURCE, flags, nullptr, flagged) == sts_success && flagged == expected
+		, "output with target flag differs from default output");
+}
+
+/** Header passed in memory is found by include directive */
+void test_header()
+{
+	const char *const headers[] = { "answer.h", HEADER, nullptr };
+
+	std::string expected;
+	std::string output;
+	check(compile_text(SOURCE, nullptr, nullptr, expected) == sts_success, "compilation without header failed");
+	check(compile_text(INCLUDING, nullptr, headers, output) == sts_success, "compilation with header failed");
+	check(!expected.empty() && output == expected, "output with header differs from output without it");
+
+	check(compile_text(INCLUDING, nullptr, nullptr, output) != sts_success && output.empty()
+		, "missing header is not reported");
+}
+
+/** Flag -E returns preprocessed text */
+void test_preprocess()
+{
+	const char *const headers[] = { "answer.h", HEADER, nullptr };
+	const char *const flags[] = { "-E", nullptr };
+
+	std::string output;
+	check(compile_text(INCLUDING, flags, headers, output) == sts_success, "preprocessing failed");
+	check(output.find("42") != std::string::npos, "macro is not expanded");
+	check(output.find("#include") == std::string::npos && output.find("#define") == std::string::npos
+		, "directives are left in preprocessed text");
+}
+
+/** Failed compilation returns error status without output */
+void test_error()
+{
+	std::string output;
+	check(compile_text(ERROR, nullptr, nullptr, output) == sts_parse_error, "error status is not returned");
+	check(output.empty(), "output is returned on error");
+}
+
+} // namespace
+
+
+int main()
+{
+	test_memory();
+	test_header();
+	test_preprocess();
+	test_error();
+
+	if (failures == 0)
+	{
+		std::printf("OK\n");
+	}
+
+	return failures == 0 ? 0 : 1;
+}
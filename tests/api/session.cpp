@@ -0,0 +1,176 @@
+/*
+ *	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+/*
+ *	Test of C++ sessions: repeated compilations on one session, concurrent compilations on two sessions
+ *	and ownership of compiler headers and workspace logging context.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "ruc.hpp"
+
+
+namespace
+{
+
+const std::string_view FIRST = "#include \"answer.h\"\n\nint main()\n{\n\tprint(ANSWER);\n\treturn 0;\n}\n";
+const std::string_view SECOND = "int twice(int n)\n{\n\treturn 2 * n;\n}\n\n"
+	"int main()\n{\n\tprint(twice(ANSWER));\n\treturn 0;\n}\n";
+const std::string_view ERROR = "int main()\n{\n\treturn undeclared;\n}\n";
+const std::string_view HEADER = "#define ANSWER 42\n";
+
+const int REPEATS = 20;
+
+
+std::atomic<int> failures = 0;
+
+void check(const bool condition, const char *const message)
+{
+	if (!condition)
+	{
+		std::printf("FAIL: %s\n", message);
+		failures++;
+	}
+}
+
+ruc::Compiler create_compiler()
+{
+	ruc::Compiler compiler;
+	compiler.add_header("answer.h", HEADER).add_flag("-Wno");
+	return compiler;
+}
+
+/** Expected output of C interface, which creates new workspace for each compilation */
+std::string expected_output(const std::string_view source, const bool has_header)
+{
+	const char *const headers[] = { "answer.h", "#define ANSWER 42\n", nullptr };
+	const char *const flags[] = { "-Wno", nullptr };
+
+	char *out = nullptr;
+	size_t out_len = 0;
+	const std::string prefix = has_header ? "" : "#include \"answer.h\"\n";
+	const std::string text = prefix + std::string(source);
+	compile_buffer(text.data(), text.size(), flags, headers, &out, &out_len);
+
+	const std::string output = out != nullptr ? std::string(out, out_len) : std::string();
+	std::free(out);
+	return output;
+}
+
+/** Session replaces main file and keeps headers between compilations */
+void test_repeat(const ruc::Compiler &compiler, const std::string &first, const std::string &second)
+{
+	ruc::Session session(compiler);
+
+	const ruc::Result result = session.compile(FIRST);
+	check(result.is_success() && result.output.view() == first, "first compilation differs from C interface");
+
+	const ruc::Result repeated = session.compile(FIRST);
+	check(repeated.is_success() && repeated.output.view() == first, "repeated compilation differs from first one");
+
+	const ruc::Result other = session.compile(std::string("#include \"answer.h\"\n") + std::string(SECOND));
+	check(other.is_success() && other.output.view() == second, "main file is not replaced");
+
+	const ruc::Result failed = session.compile(ERROR);
+	check(!failed.is_success() && failed.output.empty() && !session.diagnostics().empty()
+		, "error is not reported");
+
+	const ruc::Result recovered = session.compile(FIRST);
+	check(recovered.is_success() && recovered.output.view() == first && session.diagnostics().empty()
+		, "session is not reused after error");
+}
+
+/** Sessions of different threads compile concurrently and collect their own diagnostics */
+void test_concurrent(const ruc::Compiler &compiler, const std::string &first, const std::string &second)
+{
+	const std::string source = std::string("#include \"answer.h\"\n") + std::string(SECOND);
+
+	std::thread worker([&compiler, &first]
+	{
+		ruc::Session session(compiler);
+		for (int i = 0; i < REPEATS; i++)
+		{
+			const ruc::Result result = session.compile(FIRST);
+			check(result.is_success() && result.output.view() == first && session.diagnostics().empty()
+				, "concurrent compilation of first source failed");
+		}
+	});
+
+	ruc::Session session(compiler);
+	for (int i = 0; i < REPEATS; i++)
+	{
+		const ruc::Result failed = session.compile(ERROR);
+		check(!failed.is_success() && !session.diagnostics().empty(), "concurrent error is not reported");
+
+		const ruc::Result result = session.compile(source);
+		check(result.is_success() && result.output.view() == second && session.diagnostics().empty()
+			, "concurrent compilation of second source failed");
+	}
+
+	worker.join();
+}
+
+/** Compiler keeps copies of headers, session restores logging context of workspace */
+void test_ownership(const std::string &first)
+{
+	ruc::Compiler compiler;
+	{
+		const std::string name = "answer.h";
+		const std::string text(HEADER);
+		compiler.add_header(name, text).add_flag("-Wno");
+	}
+
+	ruc::Session session(compiler);
+	const ruc::Result result = session.compile(FIRST);
+	check(result.is_success() && result.output.view() == first, "header text is not copied by compiler");
+
+	ruc::Workspace ws;
+	ws_add_source(ws.get(), "main.c", ERROR.data(), ERROR.size());
+	ws_add_file(ws.get(), "main.c");
+
+	const logger_context own{};
+	ws_set_log_context(ws.get(), &own);
+	const ruc::Result failed = session.compile(ws);
+	check(!failed.is_success() && !session.diagnostics().empty(), "error in workspace is not reported");
+	check(ws_get_log_context(ws.get()) == &own, "logging context of workspace is not restored");
+}
+
+} // namespace
+
+
+int main()
+{
+	const ruc::Compiler compiler = create_compiler();
+	const std::string first = expected_output(FIRST, true);
+	const std::string second = expected_output(SECOND, false);
+	check(!first.empty() && !second.empty() && first != second, "compilation with C interface failed");
+
+	test_repeat(compiler, first, second);
+	test_concurrent(compiler, first, second);
+	test_ownership(first);
+
+	if (failures == 0)
+	{
+		std::printf("OK\n");
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#
+#	Copyright 2026 Andrey Terekhov, Victor Y. Fadeev
+#
+#	Licensed under the Apache License, Version 2.0 (the "License");
+#	you may not use this file except in compliance with the License.
+#	You may obtain a copy of the License at
+#
+#		http://www.apache.org/licenses/LICENSE-2.0
+#
+#	Unless required by applicable law or agreed to in writing, software
+#	distributed under the License is distributed on an "AS IS" BASIS,
+#	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#	See the License for the specific language governing permissions and
+#	limitations under the License.
+#
+#	Round trip test of compile server: ruc --server on UNIX socket and ruc --client.
+#	Server and client run in different working directories, so client paths are checked too.
+#
+#	Usage: python3 tests/server/server.py RUC
+
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+
+TIMEOUT = 30
+
+MAIN = """#include "answer.h"
+
+int main()
+{
+	print(ANSWER);
+	return 0;
+}
+"""
+
+HEADER = "#define ANSWER 42\n"
+
+
+def fail(message):
+	print("FAIL: " + message)
+	sys.exit(1)
+
+
+def read_file(path):
+	with open(path, "rb") as file:
+		return file.read()
+
+
+def write_file(path, text):
+	with open(path, "w") as file:
+		file.write(text)
+
+
+def wait_socket(path, server):
+	for _ in range(TIMEOUT * 10):
+		if os.path.exists(path):
+			return
+		if server.poll() is not None:
+			fail("server exited with code %d" % server.returncode)
+		time.sleep(0.1)
+
+	fail("server socket is not created")
+
+
+def client(ruc, path, args, cwd):
+	result = subprocess.run([ruc, "--client", path] + args, cwd=cwd, timeout=TIMEOUT
+		, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+	return result.returncode, result.stderr.decode("utf-8", "replace")
+
+
+def request(path, line):
+	connection = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+	connection.settimeout(TIMEOUT)
+	connection.connect(path)
+	connection.sendall(line.encode("utf-8") + b"\n")
+
+	response = b""
+	while b"\n" not in response:
+		chunk = connection.recv(4096)
+		if not chunk:
+			break
+		response += chunk
+
+	connection.close()
+	return int(response.split()[0])
+
+
+def main():
+	if len(sys.argv) != 2:
+		print("Usage: python3 tests/server/server.py RUC")
+		return 2
+
+	ruc = os.path.abspath(sys.argv[1])
+	with tempfile.TemporaryDirectory() as root:
+		server_dir = os.path.join(root, "server")
+		client_dir = os.path.join(root, "client")
+		os.makedirs(server_dir)
+		os.makedirs(os.path.join(client_dir, "include"))
+
+		write_file(os.path.join(client_dir, "main.c"), MAIN)
+		write_file(os.path.join(client_dir, "include", "answer.h"), HEADER)
+
+		expected = os.path.join(client_dir, "expected.ruc")
+		subprocess.run([ruc, "-Iinclude", "main.c", "-o", expected], cwd=client_dir, timeout=TIMEOUT, check=True)
+
+		# Regular file on socket path is not removed
+		path = os.path.join(root, "ruc.sock")
+		write_file(path, "not a socket")
+		if subprocess.run([ruc, "--server", path], cwd=server_dir, timeout=TIMEOUT
+			, stderr=subprocess.DEVNULL).returncode == 0 or read_file(path) != b"not a socket":
+			fail("server replaced regular file")
+		os.remove(path)
+
+		server = subprocess.Popen([ruc, "--server", path], cwd=server_dir, stderr=subprocess.DEVNULL)
+		try:
+			wait_socket(path, server)
+
+			# Relative paths and default output are resolved in client directory
+			code, log = client(ruc, path, ["-Iinclude", "main.c"], client_dir)
+			if code != 0:
+				fail("compilation failed with code %d: %s" % (code, log))
+			if read_file(os.path.join(client_dir, "out.ruc")) != read_file(expected):
+				fail("default output differs from direct compilation")
+
+			# Connection without request does not block other clients
+			idle = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+			idle.connect(path)
+
+			code, log = client(ruc, path, ["-Iinclude", "main.c", "-o", "named.ruc"], client_dir)
+			if code != 0 or read_file(os.path.join(client_dir, "named.ruc")) != read_file(expected):
+				fail("compilation with idle connection failed with code %d: %s" % (code, log))
+			idle.close()
+
+			# Errors are reported to client
+			write_file(os.path.join(client_dir, "error.c"), "int main() { return x; }\n")
+			code, log = client(ruc, path, ["error.c"], client_dir)
+			if code == 0 or "error.c" not in log:
+				fail("error is not reported")
+
+			# Too many arguments are rejected
+			if request(path, "\t".join(["-Wno"] * 300)) == 0:
+				fail("request with too many arguments is accepted")
+
+			# Client closing connection before response does not stop server
+			connection = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+			connection.connect(path)
+			connection.sendall(("%s/main.c\t-I%s/include\t-o\t%s/closed.ruc\n" % (client_dir, client_dir, client_dir)).encode("utf-8"))
+			connection.close()
+			time.sleep(1)
+
+			if server.poll() is not None:
+				fail("server exited with code %d after closed connection" % server.returncode)
+
+			code, log = client(ruc, path, ["-Iinclude", "main.c", "-o", "last.ruc"], client_dir)
+			if code != 0 or read_file(os.path.join(client_dir, "last.ruc")) != read_file(expected):
+				fail("compilation after closed connection failed with code %d: %s" % (code, log))
+		finally:
+			server.kill()
+			server.wait()
+
+	print("OK")
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())